@@ -2,6 +2,7 @@ import Engine
 from datetime import timedelta
 
 class Object(Engine.Object):
+	# Called only while the object is awake. Call Wake() to be updated on the next tick.
 	def Update(self, timeElapsed):
 		pass
 
@@ -7,4 +7,6 @@ class Window(Turf):
 		self.name = "Window"
 		self.sprite = "window"
 		self.layer = 80
-		self.solidity.Add([Direction.SOUTH])
+		solidity = self.solidity
+		solidity.Add([Direction.SOUTH])
+		self.solidity = solidity
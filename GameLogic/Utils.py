@@ -3,5 +3,10 @@ from datetime import timedelta
 
 from Engine import GGame
 
+# Returns handle of the activity, which can be passed to cancel
 def spawn(delay, activity):
-	GGame.AddDelayedActivity(delay, activity)
+	return GGame.AddDelayedActivity(delay, activity)
+
+# False if activity is done or cancelled already
+def cancel(activity):
+	return GGame.CancelDelayedActivity(activity)
@@ -0,0 +1,240 @@
+#include "Bot.hpp"
+
+#include <plog/Log.h>
+
+#include <Shared/ErrorHandling.h>
+#include <Shared/Network/Archive.h>
+#include <Shared/Network/Dispatch.h>
+#include <Shared/Network/Protocol/CompressionDictionary.h>
+#include <Shared/Network/Protocol/ClientToServer/Commands.h>
+#include <Shared/Network/Protocol/ServerToClient/Commands.h>
+
+using namespace network::protocol;
+
+namespace {
+
+template<class Duration>
+std::chrono::microseconds toMicroseconds(Duration duration) {
+	return std::chrono::duration_cast<std::chrono::microseconds>(duration);
+}
+
+} // namespace
+
+Bot::Bot(uint id, const BotConfig &config) :
+	id(id), config(config),
+	login("bot" + std::to_string(id)),
+	view(id),
+	random(id)
+{ }
+
+bool Bot::Connect() {
+	decompressor = std::make_unique<uf::StreamDecompressor>(GetCompressionDictionary());
+
+	if (socket.connect(config.serverIp, config.serverPort, sf::seconds(5)) != sf::Socket::Done) {
+		LOGE << "Bot " << id << ": failed to connect to " << config.serverIp << ":" << config.serverPort;
+		state = State::FAILED;
+		return false;
+	}
+
+	// The same options as the GUI client uses
+	client::ProtocolOptionsCommand options;
+	options.compact = true;
+	options.compression = true;
+	options.batching = true;
+	send(options);
+
+	// Fails if the bot was registered by previous run, it's fine
+	client::RegistrationCommand registration;
+	registration.login = login;
+	registration.password = config.password;
+	send(registration);
+
+	client::AuthorizationCommand authorization;
+	authorization.login = login;
+	authorization.password = config.password;
+	send(authorization);
+
+	socket.setBlocking(false);
+	state = State::AUTHORIZATION;
+	return true;
+}
+
+bool Bot::Update(Clock::time_point now) {
+	if (state == State::NOT_CONNECTED || state == State::FAILED)
+		return false;
+
+	bool working = false;
+
+	sf::Packet packet;
+	sf::Socket::Status status;
+	while ((status = socket.receive(packet)) == sf::Socket::Done) {
+		stats.bytesReceived += packet.getDataSize() + sizeof(sf::Uint32);
+		stats.framesReceived++;
+		try {
+			parsePacket(packet, now);
+		} catch (const std::exception &e) {
+			MANAGE_EXCEPTION(e);
+		}
+		working = true;
+	}
+	if (status == sf::Socket::Disconnected || status == sf::Socket::Error) {
+		LOGE << "Bot " << id << ": connection is lost";
+		state = State::FAILED;
+		return false;
+	}
+
+	if (state == State::PLAYING)
+		play(now);
+
+	return working;
+}
+
+void Bot::Disconnect() {
+	if (state == State::NOT_CONNECTED || state == State::FAILED)
+		return;
+	socket.setBlocking(true);
+	client::DisconnectionCommand command;
+	send(command);
+	socket.disconnect();
+	state = State::NOT_CONNECTED;
+}
+
+BotStats Bot::GetStats() const {
+	BotStats result = stats;
+	result.inconsistencies = view.GetErrors();
+	return result;
+}
+
+void Bot::send(Command &command) {
+	sf::Packet packet;
+	uf::InputArchive ar(packet);
+	ar << command;
+	while (socket.send(packet) == sf::Socket::Partial);
+	stats.commandsSent++;
+}
+
+void Bot::parsePacket(sf::Packet &packet, Clock::time_point now) {
+	decompressed.Clear();
+	decompressor->Decompress(packet.getData(), packet.getDataSize(), decompressed);
+	stats.payloadBytes += decompressed.GetSize();
+
+	uf::OutputArchive ar(decompressed);
+	ar.SetCompact(&objectNames);
+
+	bool hasGraphics = false;
+	while (!decompressed.EndOfBuffer()) {
+		auto command = ar.UnpackSerializable();
+		hasGraphics |= command->Id() == server::GraphicsUpdateCommand::StaticId();
+		parseCommand(*command, now);
+	}
+
+	if (hasGraphics) {
+		if (lastTick != Clock::time_point())
+			stats.tickIntervals.push_back(toMicroseconds(now - lastTick));
+		lastTick = now;
+	}
+}
+
+void Bot::parseCommand(uf::ISerializable &command, Clock::time_point now) {
+	bool known = uf::Dispatch<
+		server::AuthorizationSuccessCommand, server::AuthorizationFailedCommand,
+		server::RegistrationSuccessCommand, server::RegistrationFailedCommand,
+		server::GameJoinSuccessCommand, server::GameJoinErrorCommand,
+		server::GraphicsUpdateCommand, server::ControlUIUpdateCommand,
+		server::OverlayUpdateCommand, server::OverlayResetCommand,
+		server::OpenWindowCommand, server::UpdateWindowCommand,
+		server::AddChatMessageCommand, server::ObjectNamesCommand,
+		server::PongCommand
+	>(command, uf::Overloaded{
+		[&](server::AuthorizationSuccessCommand &) {
+			client::JoinGameCommand join;
+			join.id = 0;
+			send(join);
+			state = State::JOINING;
+		},
+		[&](server::AuthorizationFailedCommand &) {
+			LOGE << "Bot " << id << ": authorization failed";
+			state = State::FAILED;
+		},
+		[&](server::GameJoinSuccessCommand &) {
+			state = State::PLAYING;
+			nextMove = nextClick = nextVerb = nextChat = nextPing = now;
+		},
+		// Player with the same ckey is in the game, so the bot took it
+		[&](server::GameJoinErrorCommand &) {
+			state = State::PLAYING;
+			nextMove = nextClick = nextVerb = nextChat = nextPing = now;
+		},
+		[&](server::GraphicsUpdateCommand &command) {
+			view.Apply(command);
+			if (!command.diffs.empty() && moveSent != Clock::time_point()) {
+				for (auto &diff : command.diffs) {
+					if (diff->objId == view.GetControllableId()) {
+						stats.moveRoundTrips.push_back(toMicroseconds(now - moveSent));
+						moveSent = Clock::time_point();
+						break;
+					}
+				}
+			}
+		},
+		[&](server::ObjectNamesCommand &command) {
+			EXPECT(command.first == objectNames.Size());
+			for (auto &name : command.names)
+				objectNames.Add(name);
+		},
+		[&](server::PongCommand &command) {
+			if (command.id == pingId)
+				stats.pingRoundTrips.push_back(toMicroseconds(now - pingSent));
+		},
+		// Bot has nothing to draw
+		[](auto &) { }
+	});
+
+	EXPECT_WITH_MSG(known, "Unknown command received! Serializable ID is " + std::to_string(command.Id()));
+}
+
+void Bot::play(Clock::time_point now) {
+	if (now >= nextMove) {
+		if (moveSent != Clock::time_point() && now - moveSent > MOVE_TIMEOUT)
+			moveSent = Clock::time_point();
+
+		client::MoveCommand move;
+		move.direction = uf::Direction(std::uniform_int_distribution<int>(int(uf::Direction::SOUTH), int(uf::Direction::EAST))(random));
+		send(move);
+		if (moveSent == Clock::time_point() && view.HasControllable())
+			moveSent = now;
+		nextMove = now + config.movePeriod;
+	}
+
+	if (now >= nextClick) {
+		auto &objects = view.GetKnownObjects();
+		if (!objects.empty()) {
+			client::ClickObjectCommand click;
+			click.id = int(objects[std::uniform_int_distribution<size_t>(0, objects.size() - 1)(random)]);
+			send(click);
+		}
+		nextClick = now + config.clickPeriod;
+	}
+
+	if (now >= nextVerb) {
+		client::CallVerbCommand verb;
+		verb.verb = "creature.drop";
+		send(verb);
+		nextVerb = now + config.verbPeriod;
+	}
+
+	if (now >= nextChat) {
+		client::SendChatMessageCommand chat;
+		chat.message = "Hello from " + login;
+		send(chat);
+		nextChat = now + config.chatPeriod;
+	}
+
+	if (now >= nextPing) {
+		client::PingCommand ping;
+		ping.id = ++pingId;
+		send(ping);
+		pingSent = now;
+		nextPing = now + config.pingPeriod;
+	}
+}
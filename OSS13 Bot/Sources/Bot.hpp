@@ -0,0 +1,102 @@
+#pragma once
+
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <SFML/Network.hpp>
+
+#include <Shared/Types.hpp>
+#include <Shared/Network/Buffer.h>
+#include <Shared/Network/Compression.h>
+#include <Shared/Network/NameTable.h>
+#include <Shared/Network/Protocol/Command.h>
+
+#include "ViewChecker.hpp"
+
+struct BotConfig {
+	std::string serverIp = "127.0.0.1";
+	uint16_t serverPort = 55700;
+	std::string password = "bot";
+
+	// Periods of the scripted actions
+	std::chrono::milliseconds movePeriod{300};
+	std::chrono::milliseconds clickPeriod{2000};
+	std::chrono::milliseconds verbPeriod{5000};
+	std::chrono::milliseconds chatPeriod{10000};
+	std::chrono::milliseconds pingPeriod{1000};
+};
+
+struct BotStats {
+	size_t bytesReceived{0};
+	// After decompression
+	size_t payloadBytes{0};
+	size_t framesReceived{0};
+	size_t commandsSent{0};
+	// Between frames with graphics update, i.e. server ticks as the client sees them
+	std::vector<std::chrono::microseconds> tickIntervals;
+	// PingCommand -> PongCommand
+	std::vector<std::chrono::microseconds> pingRoundTrips;
+	// MoveCommand -> first diff of the controllable
+	std::vector<std::chrono::microseconds> moveRoundTrips;
+	size_t inconsistencies{0};
+};
+
+// Headless client which plays with scripted actions. Not thread-safe, every bot is updated by one thread.
+class Bot {
+public:
+	using Clock = std::chrono::steady_clock;
+
+	enum class State {
+		NOT_CONNECTED,
+		AUTHORIZATION,
+		JOINING,
+		PLAYING,
+		FAILED
+	};
+
+	Bot(uint id, const BotConfig &config);
+
+	// Connects, registers and starts authorization. Blocks until connected.
+	bool Connect();
+	// Receives everything available and sends scripted commands.
+	// Returns true if there was something to do.
+	bool Update(Clock::time_point now);
+	void Disconnect();
+
+	State GetState() const { return state; }
+	const std::string &GetLogin() const { return login; }
+	BotStats GetStats() const;
+
+private:
+	void send(network::protocol::Command &command);
+	void parsePacket(sf::Packet &packet, Clock::time_point now);
+	void parseCommand(uf::ISerializable &command, Clock::time_point now);
+	void play(Clock::time_point now);
+
+private:
+	// Move without any diff of the controllable for so long is considered blocked
+	const std::chrono::seconds MOVE_TIMEOUT{2};
+
+	uint id;
+	const BotConfig &config;
+	std::string login;
+	State state{State::NOT_CONNECTED};
+
+	sf::TcpSocket socket;
+	uptr<uf::StreamDecompressor> decompressor;
+	uf::Buffer decompressed;
+	uf::NameTable objectNames;
+	ViewChecker view;
+	std::mt19937 random;
+
+	Clock::time_point nextMove, nextClick, nextVerb, nextChat, nextPing;
+	Clock::time_point lastTick;
+	// Clock::time_point() if there is no move waiting for the answer
+	Clock::time_point moveSent;
+	uint32_t pingId{0};
+	Clock::time_point pingSent;
+
+	BotStats stats;
+};
@@ -0,0 +1,94 @@
+#include "ViewChecker.hpp"
+
+#include <plog/Log.h>
+
+#include <Shared/Global.hpp>
+#include <Shared/Network/Dispatch.h>
+
+using namespace network::protocol;
+using namespace std::string_literals;
+
+ViewChecker::ViewChecker(uint botId) :
+	botId(botId)
+{ }
+
+void ViewChecker::Apply(const server::GraphicsUpdateCommand &command) {
+	using Option = server::GraphicsUpdateCommand::Option;
+
+	if (command.options & Option::TILES_SHIFT) {
+		firstTile = command.firstTile;
+		hasView = true;
+		for (auto &tileInfo : command.tilesInfo) {
+			if (!inView(tileInfo.coords))
+				error("tile is outside of the view");
+			for (auto &objectInfo : tileInfo.content)
+				addObject(objectInfo.id);
+		}
+	}
+
+	if ((command.options & Option::CAMERA_MOVE) && !inView(command.camera))
+		error("camera is outside of the view");
+
+	if (command.options & Option::DIFFERENCES) {
+		if (!hasView && !command.diffs.empty())
+			error("diffs are received before the first tiles");
+
+		for (auto &generalDiff : command.diffs) {
+			bool known = uf::Dispatch<
+				AddDiff, RemoveDiff, RelocateDiff, RelocateAwayDiff, MoveIntentDiff, MoveDiff,
+				UpdateIconsDiff, PlayAnimationDiff, ChangeDirectionDiff, StunnedDiff
+			>(*generalDiff, uf::Overloaded{
+				[this](AddDiff &diff) {
+					if (!inView(diff.coords))
+						error("object is added outside of the view");
+					addObject(diff.objId);
+				},
+				[this](RelocateDiff &diff) {
+					checkKnown(diff.objId, "relocated");
+					if (!inView(diff.newCoords))
+						error("object is relocated outside of the view");
+				},
+				// Object leaves the view, its coords are outside
+				[this](RelocateAwayDiff &diff) {
+					checkKnown(diff.objId, "relocated away");
+				},
+				[this](auto &diff) {
+					checkKnown(diff.objId, "changed");
+				}
+			});
+			if (!known)
+				error("unknown diff type "s + std::to_string(generalDiff->Id()));
+		}
+	}
+
+	if (command.options & Option::NEW_CONTROLLABLE) {
+		controllableId = uint32_t(command.controllableId);
+		checkKnown(controllableId, "controllable");
+	}
+}
+
+bool ViewChecker::inView(const uf::vec3i &coords) const {
+	// The same size as the client TileGrid has
+	const int side = Global::FOV + 2 * Global::MIN_PADDING;
+	const int height = Global::Z_FOV | 1;
+	const uf::vec3i rel = coords - firstTile;
+	return hasView &&
+		rel.x >= 0 && rel.x < side &&
+		rel.y >= 0 && rel.y < side &&
+		rel.z >= 0 && rel.z < height;
+}
+
+void ViewChecker::addObject(uint32_t id) {
+	if (known.insert(id).second)
+		knownList.push_back(id);
+}
+
+void ViewChecker::checkKnown(uint32_t id, const char *what) {
+	if (!known.count(id))
+		error("unknown object "s + std::to_string(id) + " is " + what);
+}
+
+void ViewChecker::error(const std::string &message) {
+	if (errors++ < LOGGED_ERRORS)
+		LOGE << "Bot " << botId << ": inconsistent graphics update, " << message;
+}
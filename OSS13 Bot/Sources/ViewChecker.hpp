@@ -0,0 +1,40 @@
+#pragma once
+
+#include <unordered_set>
+#include <vector>
+
+#include <Shared/Types.hpp>
+#include <Shared/Network/Protocol/ServerToClient/Commands.h>
+
+// Keeps what the client would know about the world from GraphicsUpdateCommands
+// and counts updates which the client couldn't apply.
+class ViewChecker {
+public:
+	explicit ViewChecker(uint botId);
+
+	void Apply(const network::protocol::server::GraphicsUpdateCommand &command);
+
+	size_t GetErrors() const { return errors; }
+	bool HasControllable() const { return controllableId != 0; }
+	uint32_t GetControllableId() const { return controllableId; }
+	// Objects which were in the view at least once
+	const std::vector<uint32_t> &GetKnownObjects() const { return knownList; }
+
+private:
+	bool inView(const uf::vec3i &coords) const;
+	void addObject(uint32_t id);
+	void checkKnown(uint32_t id, const char *what);
+	void error(const std::string &message);
+
+private:
+	// Only first errors are logged
+	static constexpr size_t LOGGED_ERRORS = 5;
+
+	uint botId;
+	bool hasView{false};
+	uf::vec3i firstTile;
+	uint32_t controllableId{0};
+	std::unordered_set<uint32_t> known;
+	std::vector<uint32_t> knownList;
+	size_t errors{0};
+};
@@ -0,0 +1,136 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <plog/Log.h>
+#include <plog/Appenders/ConsoleAppender.h>
+#include <plog/Formatters/MessageOnlyFormatter.h>
+
+#include <Shared/Global.hpp>
+
+#include "Bot.hpp"
+
+// Headless load generator: simulates players which play by script over the real protocol.
+// Usage: OSS13-Bot [--server <ip>] [--port <port>] [--bots <count>] [--first <number>]
+//                  [--threads <count>] [--duration <seconds>]
+
+namespace {
+
+struct Options {
+	BotConfig bot;
+	uint bots = 100;
+	// Bots are named bot<first>, bot<first + 1>...
+	uint first = 0;
+	uint threads = 4;
+	std::chrono::seconds duration{60};
+};
+
+Options parseOptions(int argc, char *argv[]) {
+	Options options;
+	options.bot.serverPort = Global::PORT;
+	for (int i = 1; i + 1 < argc; i += 2) {
+		std::string name = argv[i];
+		std::string value = argv[i + 1];
+		if (name == "--server")
+			options.bot.serverIp = value;
+		else if (name == "--port")
+			options.bot.serverPort = uint16_t(std::stoul(value));
+		else if (name == "--bots")
+			options.bots = uint(std::stoul(value));
+		else if (name == "--first")
+			options.first = uint(std::stoul(value));
+		else if (name == "--threads")
+			options.threads = std::max(1u, uint(std::stoul(value)));
+		else if (name == "--duration")
+			options.duration = std::chrono::seconds(std::stoul(value));
+		else
+			LOGE << "Unknown option " << name;
+	}
+	return options;
+}
+
+void runBots(std::vector<uptr<Bot>> &bots, std::chrono::seconds duration) {
+	for (auto &bot : bots)
+		bot->Connect();
+
+	const auto finish = Bot::Clock::now() + duration;
+	while (true) {
+		const auto now = Bot::Clock::now();
+		if (now >= finish)
+			break;
+		bool working = false;
+		for (auto &bot : bots)
+			working |= bot->Update(now);
+		if (!working)
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+
+	for (auto &bot : bots)
+		bot->Disconnect();
+}
+
+std::string describe(std::vector<std::chrono::microseconds> &values) {
+	if (values.empty())
+		return "no samples";
+	std::sort(values.begin(), values.end());
+	auto percentile = [&values](size_t p) { return values[std::min(values.size() - 1, values.size() * p / 100)].count(); };
+	return "median " + std::to_string(percentile(50)) + " us, p99 " + std::to_string(percentile(99)) +
+		" us, max " + std::to_string(values.back().count()) + " us (" + std::to_string(values.size()) + " samples)";
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+	static plog::ConsoleAppender<plog::MessageOnlyFormatter> appender;
+	plog::init(plog::info, &appender);
+
+	Options options = parseOptions(argc, argv);
+
+	std::vector<std::vector<uptr<Bot>>> groups(options.threads);
+	for (uint i = 0; i < options.bots; i++)
+		groups[i % options.threads].push_back(std::make_unique<Bot>(options.first + i, options.bot));
+
+	LOGI << "Starting " << options.bots << " bots on " << options.threads << " threads for " << options.duration.count() << " seconds";
+
+	std::vector<std::thread> threads;
+	for (auto &group : groups)
+		threads.emplace_back(runBots, std::ref(group), options.duration);
+	for (auto &thread : threads)
+		thread.join();
+
+	BotStats total;
+	size_t playing = 0;
+	for (auto &group : groups) {
+		for (auto &bot : group) {
+			BotStats stats = bot->GetStats();
+			// Disconnect resets the state, so failed bots are the only ones left with FAILED
+			if (bot->GetState() != Bot::State::FAILED)
+				playing++;
+			total.bytesReceived += stats.bytesReceived;
+			total.payloadBytes += stats.payloadBytes;
+			total.framesReceived += stats.framesReceived;
+			total.commandsSent += stats.commandsSent;
+			total.inconsistencies += stats.inconsistencies;
+			total.tickIntervals.insert(total.tickIntervals.end(), stats.tickIntervals.begin(), stats.tickIntervals.end());
+			total.pingRoundTrips.insert(total.pingRoundTrips.end(), stats.pingRoundTrips.begin(), stats.pingRoundTrips.end());
+			total.moveRoundTrips.insert(total.moveRoundTrips.end(), stats.moveRoundTrips.begin(), stats.moveRoundTrips.end());
+		}
+	}
+
+	const size_t bots = std::max<size_t>(options.bots, 1);
+	const size_t seconds = std::max<size_t>(options.duration.count(), 1);
+	LOGI << "Bots finished: " << playing << " of " << options.bots << " worked till the end";
+	LOGI << "    received per bot: " << total.bytesReceived / bots / seconds << " bytes/s on wire, "
+	     << total.payloadBytes / bots / seconds << " bytes/s decompressed, "
+	     << total.framesReceived / bots / seconds << " frames/s";
+	LOGI << "    sent " << total.commandsSent << " commands";
+	LOGI << "    server tick interval: " << describe(total.tickIntervals);
+	LOGI << "    ping round trip: " << describe(total.pingRoundTrips);
+	LOGI << "    move round trip: " << describe(total.moveRoundTrips);
+	LOGI << "    inconsistent graphics updates: " << total.inconsistencies;
+
+	return total.inconsistencies || playing != options.bots ? 1 : 0;
+}
@@ -5,6 +5,7 @@
 #include "Graphics/Sprite.hpp"
 #include "Network.hpp"
 #include "Shared/Global.hpp"
+#include "Shared/Profiling/Tracer.h"
 
 #include <iostream>
 
@@ -17,6 +18,7 @@ ClientController::ClientController() :
 
 void ClientController::Run() {
 	plog::init(plog::verbose, this);
+	uf::Tracer::Get().SetThreadName("render");
 
 	RM.Initialize();
 
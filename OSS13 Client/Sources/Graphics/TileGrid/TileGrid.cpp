@@ -7,6 +7,8 @@
 #include <Shared/Global.hpp>
 #include <Shared/IFaces/IConfig.h>
 #include <Shared/Network/Protocol/ClientToServer/Commands.h>
+#include <Shared/Network/Protocol/ServerToClient/Commands.h>
+#include <Shared/Profiling/Profiler.h>
 
 #include <Client.hpp>
 #include <ResourceManager.hpp>
@@ -46,6 +48,8 @@ TileGrid::TileGrid() :
 }
 
 void TileGrid::draw() const {
+	PROFILE_SCOPE("frame/tile-grid");
+
     std::unique_lock<std::mutex> lock(mutex);
 
     underCursorObject = nullptr;
@@ -489,15 +493,24 @@ void TileGrid::SetControllable(uint id, float speed) {
 	LOGE << "New controllable wasn't founded" << std::endl;
 }
 
-void TileGrid::UpdateOverlay(std::vector<network::protocol::OverlayInfo> &overlayInfo) {
+void TileGrid::UpdateOverlay(const server::OverlayUpdateCommand &command) {
 	overlayToggled = true;
-	auto tileOverlayInfo = overlayInfo.begin();
-	for (auto &tile : blocks) {
-		EXPECT(tileOverlayInfo != overlayInfo.end());
-		if (tile) {
-			tile->SetOverlay(tileOverlayInfo->text);
-			tileOverlayInfo++;
-		}
+	if (command.newLayer)
+		overlayLayer = command.layer;
+
+	const size_t valueSize = overlayLayer.GetValueSize();
+	const size_t cellSize = overlayLayer.GetCellSize();
+	std::vector<float> values(overlayLayer.channels.size());
+	size_t offset = 0;
+	for (size_t cell = 0; cell < blocks.size(); cell++) {
+		if (!command.IsChanged(cell))
+			continue;
+		EXPECT(offset + cellSize <= command.values.size());
+		for (size_t channel = 0; channel < values.size(); channel++)
+			values[channel] = overlayLayer.Unpack(command.values.data() + offset + channel * valueSize);
+		offset += cellSize;
+		if (auto &tile = blocks[cell])
+			tile->SetOverlay(overlayLayer.Format(values.data()));
 	}
 }
 
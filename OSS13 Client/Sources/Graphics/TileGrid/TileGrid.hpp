@@ -17,6 +17,14 @@ namespace sf {
     class Packet;
 }
 
+namespace network {
+namespace protocol {
+namespace server {
+    struct OverlayUpdateCommand;
+}
+}
+}
+
 class TileGrid : public CustomWidget {
 public:
 	TileGrid();
@@ -53,7 +61,7 @@ public:
 		void SetBlock(apos pos, std::shared_ptr<Tile>);
 		void UpdateControlUI(const std::vector<network::protocol::ControlUIData> &elements);
 		void SetControllable(uint id, float speed);
-		void UpdateOverlay(std::vector<network::protocol::OverlayInfo> &overlayInfo);
+		void UpdateOverlay(const network::protocol::server::OverlayUpdateCommand &command);
 		void ResetOverlay();
 
     ////
@@ -92,6 +100,8 @@ private:
     mutable std::vector< std::vector<Object *> > layersBuffer;
 
 	bool overlayToggled;
+	// Describes values of the overlay updates
+	network::protocol::OverlayInfo overlayLayer;
 
 	std::unique_ptr<ControlUI> controlUI;
 
@@ -1,5 +1,6 @@
 #include "Window.hpp"
 
+#include <ctime>
 #include <fstream>
 #include <imgui.h>
 #include <imgui-SFML.h>
@@ -12,6 +13,7 @@
 #include <Shared/IFaces/IConfig.h>
 #include <Shared/JSON.hpp>
 #include <Shared/OS.hpp>
+#include <Shared/Profiling/Profiler.h>
 
 Window::Window() {
 	ui.reset(new UI);
@@ -47,23 +49,29 @@ void Window::Update() {
 	////	counter = sf::Time::Zero;
 	////}
 
-	sf::Event event;
-
-	while (window->pollEvent(event)) {
-		ui->HandleEvent(event);
-		if (event.type == sf::Event::Resized)
-			resize(event.size.width, event.size.height);
-		if (event.type == sf::Event::Closed)
-			window->close();
+	{
+		PROFILE_SCOPE("frame");
+
+		sf::Event event;
+
+		while (window->pollEvent(event)) {
+			ui->HandleEvent(event);
+			if (event.type == sf::Event::Resized)
+				resize(event.size.width, event.size.height);
+			if (event.type == sf::Event::Closed)
+				window->close();
+			if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F9)
+				toggleTracing();
+		}
+
+		window->clear(sf::Color::Black);
+		ImGui::SFML::Update(*window, lastFrameTime);
+		ui->Update(lastFrameTime);
+		ui->Draw(window.get());
+		ImGui::SFML::Render(*window);
+		window->display();
 	}
 
-	window->clear(sf::Color::Black);
-	ImGui::SFML::Update(*window, lastFrameTime);
-	ui->Update(lastFrameTime);
-	ui->Draw(window.get());
-	ImGui::SFML::Render(*window);
-	window->display();
-
 	fps_sleep();
 }
 
@@ -82,6 +90,19 @@ void Window::fps_sleep() {
     lastFrameTime = frame_clock.restart();
 }
 
+void Window::toggleTracing() {
+	auto &tracer = uf::Tracer::Get();
+	if (!tracer.IsEnabled()) {
+		tracer.Start();
+		LOGI << "Tracing is started";
+		return;
+	}
+
+	std::string path = "ClientTrace-" + std::to_string(std::time(nullptr)) + ".json";
+	if (tracer.Stop(path))
+		LOGI << "Trace is written to " << path;
+}
+
 void Window::resize(const int newWidth, const int newHeight) {
 	resolution = {newWidth, newHeight};
     const sf::FloatRect visibleArea(0, 0, float(newWidth), float(newHeight));
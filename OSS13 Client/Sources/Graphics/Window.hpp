@@ -40,5 +40,8 @@ private:
 	// sleep, if frame was drawed so fast
 	void fps_sleep();
 
+	// F9 starts tracing, the second press writes the trace to ClientTrace-<time>.json
+	void toggleTracing();
+
     void resize(const int newWidth, const int newHeight);
 };
\ No newline at end of file
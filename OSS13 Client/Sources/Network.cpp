@@ -3,6 +3,7 @@
 #include <thread>
 #include <string>
 #include <memory>
+#include <memory_resource>
 
 #include <SFML/Network.hpp>
 
@@ -15,10 +16,14 @@
 #include <Graphics/UI/UIModule/GameProcessUI.hpp>
 
 #include <Shared/ErrorHandling.h>
+#include <Shared/Network/Archive.h>
+#include <Shared/Network/Dispatch.h>
+#include <Shared/Network/Protocol/CompressionDictionary.h>
 #include <Shared/Network/Protocol/ClientToServer/Commands.h>
 #include <Shared/Network/Protocol/ServerToClient/Commands.h>
 #include <Shared/Network/Protocol/ServerToClient/WindowData.h>
 #include <Shared/Network/Protocol/ServerToClient/WorldInfo.h>
+#include <Shared/Profiling/Profiler.h>
 
 using namespace std;
 using namespace std::string_literals;
@@ -49,10 +54,23 @@ void Connection::Stop() {
 }
 
 void Connection::session() {
-	if (socket.connect(serverIp, serverPort, seconds(5)) != sf::Socket::Done)
+	uf::Tracer::Get().SetThreadName("network");
+
+	// Server sends names from the start to every new connection
+	objectNames.Clear();
+	decompressor = std::make_unique<uf::StreamDecompressor>(GetCompressionDictionary());
+
+	if (socket.connect(serverIp, serverPort, seconds(5)) != sf::Socket::Done) {
 		status = Status::NOT_CONNECTED;
-	else
+	} else {
+		// Options should be the first command, so every server answer is compact and compressed
+		auto options = new client::ProtocolOptionsCommand();
+		options->compact = true;
+		options->compression = true;
+		options->batching = true;
+		commandQueue.Push(options);
 		status = Status::CONNECTED;
+	}
 
 	socket.setBlocking(false);
 
@@ -78,14 +96,13 @@ void Connection::session() {
 }
 
 void Connection::sendCommands() {
-	while (!commandQueue.Empty()) {
+	commandQueue.Drain([](Command *temp) {
 		sf::Packet packet;
 		uf::InputArchive ar(packet);
-		Command *temp = commandQueue.Pop();
 		ar << *temp;
-		if (temp) delete temp;
+		delete temp;
 		while (socket.send(packet) == sf::Socket::Partial);
-	}
+	});
 }
 
 std::unique_ptr<Object> CreateObjectWithInfo(const network::protocol::ObjectInfo &objectInfo) {
@@ -128,149 +145,167 @@ std::unique_ptr<Tile> CreateTileWithInfo(TileGrid *tileGrid, const network::prot
 }
 
 bool Connection::parsePacket(Packet &packet) {
-	uf::OutputArchive ar(packet);
-	auto p = ar.UnpackSerializable();
-
-	if (auto *command = dynamic_cast<server::AuthorizationSuccessCommand *>(p.get())) {
-		AuthUI *authUI = dynamic_cast<AuthUI *>(CC::Get()->GetWindow()->GetUI()->GetCurrentUIModule());
-		EXPECT(authUI);
-		authUI->SetServerAnswer(true);
-		return true;
-	}
-
-	if (auto *command = dynamic_cast<server::AuthorizationFailedCommand *>(p.get())) {
-		AuthUI *authUI = dynamic_cast<AuthUI *>(CC::Get()->GetWindow()->GetUI()->GetCurrentUIModule());
-		EXPECT(authUI);
-		authUI->SetServerAnswer(false);
-		return true;
-	}
-
-	if (auto *command = dynamic_cast<server::RegistrationSuccessCommand *>(p.get())) {
-		AuthUI *authUI = dynamic_cast<AuthUI *>(CC::Get()->GetWindow()->GetUI()->GetCurrentUIModule());
-		EXPECT(authUI);
-		authUI->SetServerAnswer(true);
-		return true;
+	PROFILE_SCOPE("network/packet");
+
+	// Server compresses every packet after ProtocolOptionsCommand
+	decompressed.Clear();
+	decompressor->Decompress(packet.getData(), packet.getDataSize(), decompressed);
+	uf::OutputArchive ar(decompressed);
+	// Diffs die with the packet, so their memory is reused by the next one
+	ar.SetMemoryResource(&diffsResource);
+	ar.SetCompact(&objectNames);
+
+	// Batch of all commands of the server tick
+	while (!decompressed.EndOfBuffer()) {
+		auto command = ar.UnpackSerializable();
+		parseCommand(*command);
 	}
 
-	if (auto *command = dynamic_cast<server::RegistrationFailedCommand *>(p.get())) {
-		AuthUI *authUI = dynamic_cast<AuthUI *>(CC::Get()->GetWindow()->GetUI()->GetCurrentUIModule());
-		EXPECT(authUI);
-		authUI->SetServerAnswer(false);
-		return true;
-	}
-
-	if (auto *command = dynamic_cast<server::GameJoinSuccessCommand *>(p.get())) {
-		return true;
-	}
-	if (auto *command = dynamic_cast<server::GameJoinErrorCommand *>(p.get())) {
-		return true;
-	}
+	return true;
+}
 
-	if (auto *command = dynamic_cast<server::GraphicsUpdateCommand *>(p.get())) {
-		GameProcessUI *gameProcessUI = dynamic_cast<GameProcessUI *>(CC::Get()->GetWindow()->GetUI()->GetCurrentUIModule());
-        EXPECT(gameProcessUI);
-        TileGrid *tileGrid = gameProcessUI->GetTileGrid();
-		EXPECT(tileGrid);
-        tileGrid->LockDrawing();
-        if (command->options & server::GraphicsUpdateCommand::Option::TILES_SHIFT) {
-            tileGrid->ShiftBlocks(command->firstTile);
-
-			for (auto &tileInfo : command->tilesInfo) {
-				tileGrid->SetBlock(tileInfo.coords, CreateTileWithInfo(tileGrid, tileInfo));
+void Connection::parseCommand(uf::ISerializable &command) {
+	bool known = uf::Dispatch<
+		server::AuthorizationSuccessCommand, server::AuthorizationFailedCommand,
+		server::RegistrationSuccessCommand, server::RegistrationFailedCommand,
+		server::GameJoinSuccessCommand, server::GameJoinErrorCommand,
+		server::GraphicsUpdateCommand, server::ControlUIUpdateCommand,
+		server::OverlayUpdateCommand, server::OverlayResetCommand,
+		server::OpenWindowCommand, server::UpdateWindowCommand,
+		server::AddChatMessageCommand, server::ObjectNamesCommand
+	>(command, uf::Overloaded{
+		[](server::AuthorizationSuccessCommand &) {
+			AuthUI *authUI = dynamic_cast<AuthUI *>(CC::Get()->GetWindow()->GetUI()->GetCurrentUIModule());
+			EXPECT(authUI);
+			authUI->SetServerAnswer(true);
+		},
+		[](server::AuthorizationFailedCommand &) {
+			AuthUI *authUI = dynamic_cast<AuthUI *>(CC::Get()->GetWindow()->GetUI()->GetCurrentUIModule());
+			EXPECT(authUI);
+			authUI->SetServerAnswer(false);
+		},
+		[](server::RegistrationSuccessCommand &) {
+			AuthUI *authUI = dynamic_cast<AuthUI *>(CC::Get()->GetWindow()->GetUI()->GetCurrentUIModule());
+			EXPECT(authUI);
+			authUI->SetServerAnswer(true);
+		},
+		[](server::RegistrationFailedCommand &) {
+			AuthUI *authUI = dynamic_cast<AuthUI *>(CC::Get()->GetWindow()->GetUI()->GetCurrentUIModule());
+			EXPECT(authUI);
+			authUI->SetServerAnswer(false);
+		},
+		[](server::GameJoinSuccessCommand &) { },
+		[](server::GameJoinErrorCommand &) { },
+		[](server::GraphicsUpdateCommand &command) {
+			GameProcessUI *gameProcessUI = dynamic_cast<GameProcessUI *>(CC::Get()->GetWindow()->GetUI()->GetCurrentUIModule());
+			EXPECT(gameProcessUI);
+			TileGrid *tileGrid = gameProcessUI->GetTileGrid();
+			EXPECT(tileGrid);
+			tileGrid->LockDrawing();
+			if (command.options & server::GraphicsUpdateCommand::Option::TILES_SHIFT) {
+				tileGrid->ShiftBlocks(command.firstTile);
+
+				for (auto &tileInfo : command.tilesInfo) {
+					tileGrid->SetBlock(tileInfo.coords, CreateTileWithInfo(tileGrid, tileInfo));
+				}
 			}
-        }
-		if (command->options & server::GraphicsUpdateCommand::Option::CAMERA_MOVE) {
-            tileGrid->SetCameraPosition(command->camera);
-        }
-        if (command->options & server::GraphicsUpdateCommand::Option::DIFFERENCES) {
-			for (auto &generalDiff : command->diffs) {
-				if (auto *diff = dynamic_cast<network::protocol::AddDiff *>(generalDiff.get())) {
-					auto obj = CreateObjectWithInfo(diff->objectInfo);
-					tileGrid->AddObject(obj.release());
-					tileGrid->RelocateObject(diff->objId, diff->coords, diff->layer);
-				} else if (auto *diff = dynamic_cast<network::protocol::RemoveDiff *>(generalDiff.get())) {
-					tileGrid->RemoveObject(diff->objId);
-				} else if (auto *diff = dynamic_cast<network::protocol::RelocateDiff *>(generalDiff.get())) {
-					tileGrid->RelocateObject(diff->objId, diff->newCoords, diff->layer);
-				} else if (auto *diff = dynamic_cast<network::protocol::MoveIntentDiff *>(generalDiff.get())) {
-					tileGrid->SetMoveIntentObject(diff->objId, diff->direction);
-				} else if (auto *diff = dynamic_cast<network::protocol::MoveDiff *>(generalDiff.get())) {
-					tileGrid->MoveObject(diff->objId, diff->direction, diff->speed);
-				} else if (auto *diff = dynamic_cast<network::protocol::UpdateIconsDiff *>(generalDiff.get())) {
-					tileGrid->UpdateObjectIcons(diff->objId, diff->iconsIds);
-				} else if (auto *diff = dynamic_cast<network::protocol::PlayAnimationDiff *>(generalDiff.get())) {
-					tileGrid->PlayAnimation(diff->objId, diff->animationId);
-				} else if (auto *diff = dynamic_cast<network::protocol::ChangeDirectionDiff *>(generalDiff.get())) {
-					tileGrid->ChangeObjectDirection(diff->objId, diff->direction);
-				} else if (auto *diff = dynamic_cast<network::protocol::StunnedDiff *>(generalDiff.get())) {
-					tileGrid->Stunned(diff->objId, sf::microseconds(diff->duration.count()));
-				};
+			if (command.options & server::GraphicsUpdateCommand::Option::CAMERA_MOVE) {
+				tileGrid->SetCameraPosition(command.camera);
 			}
+			if (command.options & server::GraphicsUpdateCommand::Option::DIFFERENCES) {
+				for (auto &generalDiff : command.diffs) {
+					// RelocateAwayDiff is handled as RelocateDiff
+					uf::Dispatch<
+						AddDiff, RemoveDiff, RelocateDiff, RelocateAwayDiff, MoveIntentDiff, MoveDiff,
+						UpdateIconsDiff, PlayAnimationDiff, ChangeDirectionDiff, StunnedDiff
+					>(*generalDiff, uf::Overloaded{
+						[tileGrid](AddDiff &diff) {
+							auto obj = CreateObjectWithInfo(diff.objectInfo);
+							tileGrid->AddObject(obj.release());
+							tileGrid->RelocateObject(diff.objId, diff.coords, diff.layer);
+						},
+						[tileGrid](RemoveDiff &diff) {
+							tileGrid->RemoveObject(diff.objId);
+						},
+						[tileGrid](RelocateDiff &diff) {
+							tileGrid->RelocateObject(diff.objId, diff.newCoords, diff.layer);
+						},
+						[tileGrid](MoveIntentDiff &diff) {
+							tileGrid->SetMoveIntentObject(diff.objId, diff.direction);
+						},
+						[tileGrid](MoveDiff &diff) {
+							tileGrid->MoveObject(diff.objId, diff.direction, diff.speed);
+						},
+						[tileGrid](UpdateIconsDiff &diff) {
+							tileGrid->UpdateObjectIcons(diff.objId, diff.iconsIds);
+						},
+						[tileGrid](PlayAnimationDiff &diff) {
+							tileGrid->PlayAnimation(diff.objId, diff.animationId);
+						},
+						[tileGrid](ChangeDirectionDiff &diff) {
+							tileGrid->ChangeObjectDirection(diff.objId, diff.direction);
+						},
+						[tileGrid](StunnedDiff &diff) {
+							tileGrid->Stunned(diff.objId, sf::microseconds(diff.duration.count()));
+						}
+					});
+				}
+			}
+			if (command.options & server::GraphicsUpdateCommand::Option::NEW_CONTROLLABLE) {
+				tileGrid->SetControllable(command.controllableId, command.controllableSpeed);
+			}
+			tileGrid->UnlockDrawing();
+		},
+		[](server::ControlUIUpdateCommand &command) {
+			GameProcessUI *gameProcessUI = dynamic_cast<GameProcessUI *>(CC::Get()->GetWindow()->GetUI()->GetCurrentUIModule());
+			EXPECT(gameProcessUI);
+			TileGrid *tileGrid = gameProcessUI->GetTileGrid();
+			EXPECT(tileGrid);
+			tileGrid->LockDrawing();
+			tileGrid->UpdateControlUI(command.elements);
+			tileGrid->UnlockDrawing();
+		},
+		[](server::OverlayUpdateCommand &command) {
+			GameProcessUI *gameProcessUI = dynamic_cast<GameProcessUI *>(CC::Get()->GetWindow()->GetUI()->GetCurrentUIModule());
+			EXPECT(gameProcessUI);
+			TileGrid *tileGrid = gameProcessUI->GetTileGrid();
+			EXPECT(tileGrid);
+			tileGrid->LockDrawing();
+			tileGrid->UpdateOverlay(command);
+			tileGrid->UnlockDrawing();
+		},
+		[](server::OverlayResetCommand &) {
+			GameProcessUI *gameProcessUI = dynamic_cast<GameProcessUI *>(CC::Get()->GetWindow()->GetUI()->GetCurrentUIModule());
+			EXPECT(gameProcessUI);
+			TileGrid *tileGrid = gameProcessUI->GetTileGrid();
+			EXPECT(tileGrid);
+			tileGrid->LockDrawing();
+			tileGrid->ResetOverlay();
+			tileGrid->UnlockDrawing();
+		},
+		[](server::OpenWindowCommand &command) {
+			UIModule *uiModule = CC::Get()->GetWindow()->GetUI()->GetCurrentUIModule();
+			EXPECT(uiModule);
+			uiModule->OpenWindow(command.id.c_str(), command.data);
+		},
+		[](server::UpdateWindowCommand &command) {
+			UIModule *uiModule = CC::Get()->GetWindow()->GetUI()->GetCurrentUIModule();
+			EXPECT(uiModule);
+			uiModule->UpdateWindow(command.data->window, *command.data);
+		},
+		[](server::AddChatMessageCommand &command) {
+			GameProcessUI *gameProcessUI = dynamic_cast<GameProcessUI *>(CC::Get()->GetWindow()->GetUI()->GetCurrentUIModule());
+			EXPECT(gameProcessUI);
+			gameProcessUI->Receive(command.message);
+		},
+		[](server::ObjectNamesCommand &command) {
+			EXPECT(command.first == objectNames.Size());
+			for (auto &name : command.names)
+				objectNames.Add(name);
 		}
-		if (command->options & server::GraphicsUpdateCommand::Option::NEW_CONTROLLABLE) {
-			tileGrid->SetControllable(command->controllableId, command->controllableSpeed);
-		}
-		tileGrid->UnlockDrawing();
-		return true;
-	}
-
-	if (auto *command = dynamic_cast<server::ControlUIUpdateCommand *>(p.get())) {
-		GameProcessUI *gameProcessUI = dynamic_cast<GameProcessUI *>(CC::Get()->GetWindow()->GetUI()->GetCurrentUIModule());
-		EXPECT(gameProcessUI);
-		TileGrid *tileGrid = gameProcessUI->GetTileGrid();
-		EXPECT(tileGrid);
-		tileGrid->LockDrawing();
-		tileGrid->UpdateControlUI(command->elements);
-		tileGrid->UnlockDrawing();
-		return true;
-	}
-
-	if (auto *command = dynamic_cast<server::OverlayUpdateCommand *>(p.get())) {
-		GameProcessUI *gameProcessUI = dynamic_cast<GameProcessUI *>(CC::Get()->GetWindow()->GetUI()->GetCurrentUIModule());
-		EXPECT(gameProcessUI);
-		TileGrid *tileGrid = gameProcessUI->GetTileGrid();
-		EXPECT(tileGrid);
-		tileGrid->LockDrawing();
-		tileGrid->UpdateOverlay(command->overlayInfo);
-		tileGrid->UnlockDrawing();
-		return true;
-	}
-
-	if (auto *command = dynamic_cast<server::OverlayResetCommand *>(p.get())) {
-		GameProcessUI *gameProcessUI = dynamic_cast<GameProcessUI *>(CC::Get()->GetWindow()->GetUI()->GetCurrentUIModule());
-		EXPECT(gameProcessUI);
-		TileGrid *tileGrid = gameProcessUI->GetTileGrid();
-		EXPECT(tileGrid);
-		tileGrid->LockDrawing();
-		tileGrid->ResetOverlay();
-		tileGrid->UnlockDrawing();
-		return true;
-	}
-
-	if (auto *command = dynamic_cast<server::OpenWindowCommand *>(p.get())) {
-		UIModule *uiModule = CC::Get()->GetWindow()->GetUI()->GetCurrentUIModule();
-		EXPECT(uiModule);
-		uiModule->OpenWindow(command->id.c_str(), command->data);
-		return true;
-	}
-
-	if (auto *command = dynamic_cast<server::UpdateWindowCommand *>(p.get())) {
-		UIModule *uiModule = CC::Get()->GetWindow()->GetUI()->GetCurrentUIModule();
-		EXPECT(uiModule);
-		uiModule->UpdateWindow(command->data->window, *command->data);
-		return true;
-	}
-
-	if (auto *command = dynamic_cast<server::AddChatMessageCommand *>(p.get())) {
-		GameProcessUI *gameProcessUI = dynamic_cast<GameProcessUI *>(CC::Get()->GetWindow()->GetUI()->GetCurrentUIModule());
-		EXPECT(gameProcessUI);
-		gameProcessUI->Receive(command->message);
-		return true;
-	}
-
-	EXPECT_WITH_MSG(false, "Unknown command received! Serializable ID is "s + std::to_string(p->Id()));
+	});
 
-	return false;
+	EXPECT_WITH_MSG(known, "Unknown command received! Serializable ID is "s + std::to_string(command.Id()));
 }
 
 sf::IpAddress Connection::serverIp;
@@ -278,4 +313,8 @@ int Connection::serverPort;
 Connection::Status Connection::status = Connection::Status::INACTIVE;
 uptr<std::thread> Connection::thread;
 sf::TcpSocket Connection::socket;
-uf::ThreadSafeQueue<Command *> Connection::commandQueue;
\ No newline at end of file
+std::pmr::unsynchronized_pool_resource Connection::diffsResource;
+uf::NameTable Connection::objectNames;
+uptr<uf::StreamDecompressor> Connection::decompressor;
+uf::Buffer Connection::decompressed;
+uf::MPSCQueue<Command *> Connection::commandQueue;
\ No newline at end of file
@@ -1,10 +1,13 @@
 #pragma once
 
 #include <string>
+#include <memory_resource>
 
 #include <SFML/Network.hpp>
 
-#include <Shared/ThreadSafeQueue.hpp>
+#include <Shared/MPSCQueue.hpp>
+#include <Shared/Network/NameTable.h>
+#include <Shared/Network/Compression.h>
 #include <Shared/Network/Protocol/Command.h>
 
 namespace std {
@@ -32,13 +35,20 @@ class Connection {
     static uptr<std::thread> thread;
     
     static sf::TcpSocket socket;
+    // Received diffs are allocated from here (session thread only)
+    static std::pmr::unsynchronized_pool_resource diffsResource;
+    // Names of the compact wire mode, received from server
+    static uf::NameTable objectNames;
+    static uptr<uf::StreamDecompressor> decompressor;
+    static uf::Buffer decompressed;
 
     static void session();
     static void sendCommands();
     static bool parsePacket(sf::Packet &);
+    static void parseCommand(uf::ISerializable &command);
 
 public:
-    static uf::ThreadSafeQueue<network::protocol::Command *> commandQueue;
+    static uf::MPSCQueue<network::protocol::Command *> commandQueue;
 
     static bool Start(const string ip, const int port);
     static void Stop();
@@ -8,6 +8,12 @@ class Control;
 class World;
 class Chat;
 class IScriptEngine;
+class TickProfiler;
+class HitchRecorder;
+
+namespace uf {
+class TimerWheel;
+}
 
 class IGame {
 public:
@@ -19,6 +25,10 @@ public:
 	virtual World *GetWorld() const = 0;
 	virtual IScriptEngine *GetScriptEngine() const = 0;
 	virtual Chat *GetChat() = 0;
+	virtual TickProfiler *GetProfiler() = 0;
+	virtual HitchRecorder *GetHitchRecorder() = 0;
+	// Timers are fired at the beginning of the game tick
+	virtual uf::TimerWheel *GetTimers() = 0;
 };
 
 extern IGame *GGame;
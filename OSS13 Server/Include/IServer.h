@@ -7,11 +7,20 @@ class Player;
 class IGame;
 class ResourceManager;
 
+// Totals since the server start
+struct NetworkCounters {
+	uint64_t framesSent{0};
+	uint64_t bytesSent{0};
+};
+
 class IServer : public INonCopyable {
 public:
 	virtual Player *Authorization(const std::string &login, const std::string &password) const = 0;
 	virtual bool Registration(const std::string &login, const std::string &password) const = 0;
 	virtual bool JoinGame(sptr<Player> &player) const = 0;
+	// Game tick is over, send its commands to clients
+	virtual void FlushNetwork() const = 0;
+	virtual NetworkCounters GetNetworkCounters() const = 0;
 
 	static ResourceManager *RM();
 };
@@ -0,0 +1,136 @@
+#include "Benchmarks.h"
+
+#include <memory_resource>
+
+#include <plog/Log.h>
+
+#include <Shared/Network/Archive.h>
+#include <Shared/Network/Buffer.h>
+#include <Shared/Network/Protocol/ServerToClient/Commands.h>
+
+namespace benchmarks {
+
+namespace {
+
+const size_t ITERATIONS = 200;
+// Default camera: 21x21 tiles on 3 levels
+const int VIEW_SIDE = 21;
+const int VIEW_LEVELS = 3;
+const uint DIFFS = 100;
+
+network::protocol::ObjectInfo generateObjectInfo(uint id) {
+	network::protocol::ObjectInfo info;
+	info.id = id;
+	info.name = "Maintenance Airlock";
+	info.spriteIds = { 10, 11, 12 };
+	info.layer = 40;
+	info.direction = uf::Direction::SOUTH;
+	info.moveSpeed = 0;
+	info.speed = uf::vec2f(0);
+	return info;
+}
+
+// Command which is sent when camera moves to the new place: full tiles info and diffs of the tick
+network::protocol::server::GraphicsUpdateCommand generateCommand() {
+	using namespace network::protocol;
+
+	server::GraphicsUpdateCommand command;
+	command.options = server::GraphicsUpdateCommand::Option::TILES_SHIFT |
+	                  server::GraphicsUpdateCommand::Option::CAMERA_MOVE |
+	                  server::GraphicsUpdateCommand::Option::DIFFERENCES;
+	command.firstTile = uf::vec3i(0, 0, 0);
+	command.camera = uf::vec3i(VIEW_SIDE / 2, VIEW_SIDE / 2, 1);
+
+	uint id = 0;
+	for (int z = 0; z < VIEW_LEVELS; z++) {
+		for (int y = 0; y < VIEW_SIDE; y++) {
+			for (int x = 0; x < VIEW_SIDE; x++) {
+				TileInfo tileInfo;
+				tileInfo.coords = uf::vec3i(x, y, z);
+				tileInfo.sprite = 5;
+				// floor and walls are sprites, some tiles contain objects
+				for (int i = 0; i < (x + y) % 3; i++)
+					tileInfo.content.push_back(generateObjectInfo(id++));
+				command.tilesInfo.push_back(std::move(tileInfo));
+			}
+		}
+	}
+
+	for (uint i = 0; i < DIFFS; i++) {
+		if (i % 2) {
+			auto diff = std::make_shared<MoveDiff>();
+			diff->objId = i;
+			diff->direction = uf::Direction::NORTH;
+			diff->speed = 4;
+			command.diffs.push_back(std::move(diff));
+		} else {
+			auto diff = std::make_shared<AddDiff>();
+			diff->objId = i;
+			diff->objectInfo = generateObjectInfo(i);
+			diff->coords = uf::vec3i(i % VIEW_SIDE, i / VIEW_SIDE, 0);
+			diff->layer = 40;
+			command.diffs.push_back(std::move(diff));
+		}
+	}
+	return command;
+}
+
+double megabytesPerSecond(size_t bytes, std::chrono::nanoseconds time) {
+	return double(bytes) * 1000 / std::max<std::chrono::nanoseconds::rep>(time.count(), 1);
+}
+
+} // namespace
+
+void ArchiveBenchmark() {
+	using namespace network::protocol;
+
+	auto command = generateCommand();
+
+	sf::Packet encodedPacket;
+	uf::InputArchive(encodedPacket) << command;
+	const size_t bytes = encodedPacket.getDataSize();
+	LOGI << "    GraphicsUpdateCommand with " << command.tilesInfo.size() << " tiles and " << DIFFS << " diffs: " << bytes << " bytes";
+
+	auto packetEncodeTime = Measure([&] {
+		sf::Packet packet;
+		uf::InputArchive ar(packet);
+		ar << command;
+	}, ITERATIONS);
+
+	uf::BufferPool pool;
+	auto bufferEncodeTime = Measure([&] {
+		auto buffer = pool.Acquire();
+		uf::InputArchive ar(*buffer);
+		ar << command;
+	}, ITERATIONS);
+
+	LOGI << "    encode: sf::Packet " << megabytesPerSecond(bytes, packetEncodeTime) << " MB/s, "
+	     << "pooled Buffer " << megabytesPerSecond(bytes, bufferEncodeTime) << " MB/s";
+
+	auto packetDecodeTime = Measure([&] {
+		sf::Packet packet = encodedPacket;
+		uf::OutputArchive ar(packet);
+		ar.UnpackSerializable();
+	}, ITERATIONS);
+
+	auto bufferDecodeTime = Measure([&] {
+		uf::Buffer buffer(encodedPacket.getData(), encodedPacket.getDataSize());
+		uf::OutputArchive ar(buffer);
+		ar.UnpackSerializable();
+	}, ITERATIONS);
+
+	std::pmr::unsynchronized_pool_resource arena;
+	auto arenaDecodeTime = Measure([&] {
+		uf::Buffer buffer(encodedPacket.getData(), encodedPacket.getDataSize());
+		uf::OutputArchive ar(buffer);
+		ar.SetMemoryResource(&arena);
+		server::GraphicsUpdateCommand decoded;
+		ar >> decoded;
+	}, ITERATIONS);
+
+	LOGI << "    decode: sf::Packet " << megabytesPerSecond(bytes, packetDecodeTime) << " MB/s, "
+	     << "Buffer view " << megabytesPerSecond(bytes, bufferDecodeTime) << " MB/s, "
+	     << "in place with diffs arena " << megabytesPerSecond(bytes, arenaDecodeTime) << " MB/s";
+}
+
+} // namespace benchmarks
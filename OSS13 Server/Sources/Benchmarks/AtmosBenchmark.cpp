@@ -0,0 +1,70 @@
+#include "Benchmarks.h"
+
+#include <algorithm>
+#include <thread>
+
+#include <plog/Log.h>
+
+#include <World/Atmos/AtmosGrid.h>
+
+#include <Shared/ThreadPool.h>
+
+namespace benchmarks {
+
+namespace {
+
+using namespace std::chrono_literals;
+
+const size_t TICKS = 100;
+// 20 Hz
+const std::chrono::microseconds TICK = 50ms;
+// Rooms divided by walls with doorways
+const uint ROOM_SIDE = 10;
+
+// Station: rooms filled with air, a plasma leak in the middle and a hull breach to space at the corner
+void fillStation(AtmosGrid &grid) {
+	AtmosGrid::Sides open, closed;
+	open.fill(1.f);
+	closed.fill(0.f);
+
+	for (uint z = 0; z < grid.GetLevels(); z++) {
+		for (uint y = 0; y < grid.GetHeight(); y++) {
+			for (uint x = 0; x < grid.GetWidth(); x++) {
+				const bool wall = (x % ROOM_SIDE == 0 || y % ROOM_SIDE == 0) && x % ROOM_SIDE != ROOM_SIDE / 2 && y % ROOM_SIDE != ROOM_SIDE / 2;
+				const bool space = x < ROOM_SIDE && y < ROOM_SIDE;
+				grid.SetCell({ x, y, z }, space, wall ? closed : open);
+				if (!wall && !space) {
+					grid.SetPressure({ x, y, z }, Gas::Oxygen, 21.f);
+					grid.SetPressure({ x, y, z }, Gas::Nitrogen, 80.f);
+					grid.SetTemperature({ x, y, z }, 293.15f);
+				}
+			}
+		}
+		grid.SetPressure({ grid.GetWidth() / 2 + 1, grid.GetHeight() / 2 + 1, z }, Gas::Plasma, 10000.f);
+	}
+}
+
+std::chrono::nanoseconds measure(uint side, uint levels, uf::ThreadPool *pool) {
+	AtmosGrid grid(side, side, levels);
+	fillStation(grid);
+	return Measure([&] { grid.Update(TICK, pool); }, TICKS);
+}
+
+} // namespace
+
+void AtmosBenchmark() {
+	uf::ThreadPool pool(std::max(std::thread::hardware_concurrency(), 2u) - 1);
+	LOGI << "    " << AtmosGrid::GetKernelName() << " kernel, " << AtmosGrid::FIELDS << " fields per cell, tick budget is "
+	     << std::chrono::duration_cast<std::chrono::microseconds>(TICK).count() << " us";
+
+	for (uint side : { 250, 500 }) {
+		for (uint levels : { 1, 4 }) {
+			auto serialTime = measure(side, levels, nullptr);
+			auto parallelTime = measure(side, levels, &pool);
+			LOGI << "    " << side << "x" << side << "x" << levels << ": one thread " << serialTime.count() / 1000 << " us, "
+			     << pool.GetThreadsCount() + 1 << " threads " << parallelTime.count() / 1000 << " us per tick";
+		}
+	}
+}
+
+} // namespace benchmarks
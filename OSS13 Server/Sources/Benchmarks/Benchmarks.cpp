@@ -0,0 +1,63 @@
+#include "Benchmarks.h"
+
+#include <map>
+
+#include <plog/Log.h>
+
+namespace benchmarks {
+
+static const std::map<std::string, std::function<void()>> &getBenchmarks() {
+	static const std::map<std::string, std::function<void()>> benchmarks = {
+		{ "map", &MapBenchmark },
+		{ "view", &ViewBenchmark },
+		{ "parallel-view", &ParallelViewBenchmark },
+		{ "queue", &QueueBenchmark },
+		{ "diffs", &DiffsBenchmark },
+		{ "objects", &ObjectsBenchmark },
+		{ "components", &ComponentsBenchmark },
+		{ "atmos", &AtmosBenchmark },
+		{ "locales", &LocalesBenchmark },
+		{ "overlay", &OverlayBenchmark },
+		{ "encoding", &EncodingBenchmark },
+		{ "dispatch", &DispatchBenchmark },
+		{ "archive", &ArchiveBenchmark },
+		{ "wire", &WireBenchmark },
+		{ "compression", &CompressionBenchmark },
+		{ "load", &LoadBenchmark },
+	};
+	return benchmarks;
+}
+
+bool Run(const std::string &name) {
+	auto &benchmarks = getBenchmarks();
+
+	if (name == "all") {
+		for (auto &benchmark : benchmarks) {
+			LOGI << "Benchmark \"" << benchmark.first << "\":";
+			benchmark.second();
+		}
+		return true;
+	}
+
+	auto iter = benchmarks.find(name);
+	if (iter == benchmarks.end()) {
+		LOGE << "Unknown benchmark \"" << name << "\". Available benchmarks:";
+		for (auto &benchmark : benchmarks)
+			LOGE << "    " << benchmark.first;
+		return false;
+	}
+
+	LOGI << "Benchmark \"" << name << "\":";
+	iter->second();
+	return true;
+}
+
+std::chrono::nanoseconds Measure(const std::function<void()> &func, size_t iterations) {
+	auto start = std::chrono::steady_clock::now();
+	for (size_t i = 0; i < iterations; i++)
+		func();
+	auto finish = std::chrono::steady_clock::now();
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(finish - start) / iterations;
+}
+
+} // namespace benchmarks
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <string>
+
+// Server micro-benchmarks. Run with "OSS13-Server --benchmark <name>",
+// "--benchmark all" runs every registered benchmark.
+namespace benchmarks {
+
+// Returns false if there is no benchmark with such name
+bool Run(const std::string &name);
+
+// Average duration of one func call
+std::chrono::nanoseconds Measure(const std::function<void()> &func, size_t iterations);
+
+void MapBenchmark();
+void ViewBenchmark();
+void ParallelViewBenchmark();
+void DiffsBenchmark();
+void ObjectsBenchmark();
+void ComponentsBenchmark();
+void AtmosBenchmark();
+void LocalesBenchmark();
+void OverlayBenchmark();
+void QueueBenchmark();
+void EncodingBenchmark();
+void DispatchBenchmark();
+void ArchiveBenchmark();
+void WireBenchmark();
+void CompressionBenchmark();
+void LoadBenchmark();
+
+} // namespace benchmarks
@@ -0,0 +1,70 @@
+#include "Benchmarks.h"
+
+#include <unordered_map>
+
+#include <plog/Log.h>
+
+#include <World/Objects/ObjectHolder.h>
+#include <World/Objects/Control.hpp>
+#include <World/Objects/ComponentRegistry.h>
+
+namespace benchmarks {
+
+namespace {
+
+using namespace std::chrono_literals;
+
+const size_t ITERATIONS = 100;
+
+class BenchmarkObject : public Object {
+public:
+	bool InteractedBy(Object *) override { return false; }
+	sptr<Object> GetOwnershipPointer() override { return {}; }
+};
+
+// Components as they were stored before the registry
+using ComponentsMap = std::unordered_map<std::string, uptr<Component>>;
+
+} // namespace
+
+void ComponentsBenchmark() {
+	for (uint objectsNum : { 1000, 10000 }) {
+		ObjectHolder holder;
+		std::vector<Object *> objects;
+		std::vector<ComponentsMap> maps(objectsNum);
+		for (uint i = 0; i < objectsNum; i++) {
+			auto *object = holder.CreateObject<BenchmarkObject>();
+			object->AddComponent<Control>();
+			objects.push_back(object);
+
+			auto control = std::make_unique<Control>();
+			control->SetOwner(object);
+			maps[i]["Control"] = std::move(control);
+		}
+
+		size_t found = 0;
+		auto mapLookupTime = Measure([&] {
+			for (auto &components : maps)
+				found += dynamic_cast<Control *>(components["Control"].get()) != nullptr;
+		}, ITERATIONS);
+		auto typedLookupTime = Measure([&] {
+			for (auto *object : objects)
+				found += object->GetComponent<Control>() != nullptr;
+		}, ITERATIONS);
+
+		auto mapUpdateTime = Measure([&] {
+			for (auto &components : maps) {
+				for (auto &idAndComponent : components)
+					idAndComponent.second->Update(50ms);
+			}
+		}, ITERATIONS);
+		auto registryUpdateTime = Measure([&] { ComponentRegistry::Get().Update(50ms); }, ITERATIONS);
+
+		EXPECT(found == 2 * objectsNum * ITERATIONS);
+		LOGI << "    " << objectsNum << " objects with Control: "
+		     << "lookup by string " << mapLookupTime.count() / 1000 << " us, typed lookup " << typedLookupTime.count() / 1000 << " us, "
+		     << "update through objects " << mapUpdateTime.count() / 1000 << " us, registry pass " << registryUpdateTime.count() / 1000 << " us";
+	}
+}
+
+} // namespace benchmarks
@@ -0,0 +1,80 @@
+#include "Benchmarks.h"
+
+#include <plog/Log.h>
+
+#include <Shared/Network/Archive.h>
+#include <Shared/Network/Buffer.h>
+#include <Shared/Network/Compression.h>
+#include <Shared/Network/NameTable.h>
+#include <Shared/Network/Protocol/CompressionDictionary.h>
+
+#include "WalkScenario.h"
+
+namespace benchmarks {
+
+namespace {
+
+using namespace network::protocol;
+
+const size_t TICKS = 1000;
+// The same as in NetworkController
+const size_t THRESHOLD = 128;
+
+// Payloads of commands which the client gets in the walk-around scenario
+std::vector<std::vector<char>> encodeScenario(bool compact) {
+	auto commands = GenerateWalkScenario(TICKS);
+
+	uf::NameTable names;
+	std::vector<std::vector<char>> payloads;
+	for (auto &command : commands) {
+		uf::Buffer buffer;
+		uf::InputArchive ar(buffer);
+		if (compact)
+			ar.SetCompact(&names);
+		ar << command;
+		payloads.emplace_back(buffer.GetData(), buffer.GetData() + buffer.GetSize());
+	}
+	return payloads;
+}
+
+void benchmarkStream(const char *title, const std::vector<std::vector<char>> &payloads, const std::vector<char> &dictionary) {
+	uf::StreamCompressor compressor(dictionary, THRESHOLD);
+	uf::StreamDecompressor decompressor(dictionary);
+	std::vector<uf::Buffer> compressed(payloads.size());
+	uf::Buffer decompressed;
+
+	size_t i = 0;
+	auto compressTime = Measure([&] {
+		compressor.Compress(payloads[i].data(), payloads[i].size(), compressed[i]);
+		i++;
+	}, payloads.size());
+
+	i = 0;
+	auto decompressTime = Measure([&] {
+		decompressed.Clear();
+		decompressor.Decompress(compressed[i].GetData(), compressed[i].GetSize(), decompressed);
+		i++;
+	}, payloads.size());
+
+	const size_t rawBytes = compressor.GetRawBytes();
+	const size_t compressedBytes = compressor.GetCompressedBytes();
+	LOGI << "    " << title << ": " << rawBytes / payloads.size() << " -> " << compressedBytes / payloads.size() << " bytes per tick, "
+	     << "ratio " << double(rawBytes) / compressedBytes << " (first packet " << payloads[0].size() << " -> " << compressed[0].GetSize() << "), "
+	     << "compress " << compressTime.count() / 1000.0 << " us, "
+	     << "decompress " << decompressTime.count() / 1000.0 << " us per tick";
+}
+
+} // namespace
+
+void CompressionBenchmark() {
+	auto plain = encodeScenario(false);
+	auto compact = encodeScenario(true);
+	const auto &dictionary = GetCompressionDictionary();
+
+	benchmarkStream("plain", plain, {});
+	benchmarkStream("plain with dictionary", plain, dictionary);
+	benchmarkStream("compact", compact, {});
+	benchmarkStream("compact with dictionary", compact, dictionary);
+}
+
+} // namespace benchmarks
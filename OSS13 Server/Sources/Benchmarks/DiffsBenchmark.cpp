@@ -0,0 +1,115 @@
+#include "Benchmarks.h"
+
+#include <algorithm>
+#include <random>
+
+#include <plog/Log.h>
+
+#include <World/Map.hpp>
+#include <World/MapChunk.hpp>
+#include <World/Tile.hpp>
+
+#include <Shared/Network/Protocol/ServerToClient/Diff.h>
+
+namespace benchmarks {
+
+namespace {
+
+const size_t TICKS = 50;
+
+using namespace network::protocol;
+
+// Every moving object produces MoveIntent, ChangeDirection and Move diffs per tick
+struct MovingObject {
+	Tile *tile;
+	size_t chunkIndex;
+	ObjectHandle handle;
+	// Stands for ownership pointer to the object, which was copied into every diff record before the arena
+	sptr<int> owner;
+};
+
+// Heap allocations of make_shared are counted through this allocator
+size_t sharedAllocations;
+
+template<class T>
+struct CountingAllocator : std::allocator<T> {
+	template<class U> struct rebind { using other = CountingAllocator<U>; };
+	CountingAllocator() = default;
+	template<class U> CountingAllocator(const CountingAllocator<U> &) { }
+	T *allocate(size_t n) { sharedAllocations++; return std::allocator<T>::allocate(n); }
+};
+
+template<class T>
+sptr<T> makeShared() {
+	return std::allocate_shared<T>(CountingAllocator<T>());
+}
+
+// Diffs and records as they were before the arena: shared diff and shared object in every record
+struct SharedRecord {
+	sptr<Diff> diff;
+	sptr<int> object;
+	Tile *tile;
+};
+
+std::chrono::nanoseconds measureShared(std::vector<MovingObject> &objects, std::vector<std::vector<SharedRecord>> &records) {
+	return Measure([&] {
+		for (auto &chunkRecords : records)
+			chunkRecords.clear();
+		Diff::ResetDiffCounter();
+		for (auto &object : objects) {
+			auto &chunkRecords = records[object.chunkIndex];
+			chunkRecords.push_back({ makeShared<MoveIntentDiff>(), object.owner, object.tile });
+			chunkRecords.push_back({ makeShared<ChangeDirectionDiff>(), object.owner, object.tile });
+			chunkRecords.push_back({ makeShared<MoveDiff>(), object.owner, object.tile });
+		}
+	}, 1);
+}
+
+std::chrono::nanoseconds measureArena(Map &map, std::vector<MovingObject> &objects) {
+	return Measure([&] {
+		map.ClearDiffs();
+		for (auto &object : objects) {
+			MapChunk *chunk = object.tile->GetChunk();
+			chunk->AddDiff(object.tile, map.CreateDiff<MoveIntentDiff>(), object.handle);
+			chunk->AddDiff(object.tile, map.CreateDiff<ChangeDirectionDiff>(), object.handle);
+			chunk->AddDiff(object.tile, map.CreateDiff<MoveDiff>(), object.handle);
+		}
+	}, 1);
+}
+
+} // namespace
+
+void DiffsBenchmark() {
+	Map map(250, 250, 4);
+	std::mt19937 random(0);
+	std::uniform_int_distribution<int> coord(0, 249);
+	std::uniform_int_distribution<int> level(0, 3);
+
+	for (uint objectsNum : { 1000, 10000, 50000 }) {
+		std::vector<MovingObject> objects(objectsNum);
+		for (uint i = 0; i < objectsNum; i++) {
+			objects[i].tile = map.GetTile({ coord(random), coord(random), level(random) });
+			auto &chunks = map.GetChunks();
+			objects[i].chunkIndex = std::find_if(chunks.begin(), chunks.end(), [&](auto &chunk) { return chunk.get() == objects[i].tile->GetChunk(); }) - chunks.begin();
+			objects[i].handle = { i + 1, i + 1 };
+			objects[i].owner = std::make_shared<int>();
+		}
+
+		std::vector<std::vector<SharedRecord>> records(map.GetChunks().size());
+		std::chrono::nanoseconds sharedTime(0), arenaTime(0);
+		sharedAllocations = 0;
+		const size_t blocksBefore = map.GetDiffsArena().GetBlocksCount();
+		for (size_t tick = 0; tick < TICKS; tick++) {
+			sharedTime += measureShared(objects, records);
+			arenaTime += measureArena(map, objects);
+		}
+		const size_t arenaAllocations = map.GetDiffsArena().GetBlocksCount() - blocksBefore;
+		map.ClearDiffs();
+
+		LOGI << "    " << objectsNum << " moving objects, " << objectsNum * 3 << " diffs per tick: "
+		     << "make_shared " << sharedTime.count() / TICKS / 1000 << " us and " << sharedAllocations / TICKS << " allocations, "
+		     << "arena " << arenaTime.count() / TICKS / 1000 << " us and " << arenaAllocations << " blocks for " << TICKS << " ticks";
+	}
+}
+
+} // namespace benchmarks
@@ -0,0 +1,111 @@
+#include "Benchmarks.h"
+
+#include <random>
+
+#include <plog/Log.h>
+
+#include <Shared/Network/Dispatch.h>
+#include <Shared/Network/Protocol/ServerToClient/Commands.h>
+
+namespace benchmarks {
+
+namespace {
+
+using namespace network::protocol;
+using namespace network::protocol::server;
+
+const size_t MESSAGES = 100000;
+const size_t ROUNDS = 20;
+
+std::vector<uptr<uf::ISerializable>> generateMessages() {
+	std::vector<uptr<uf::ISerializable>> messages;
+	std::mt19937 random(0);
+	std::uniform_int_distribution<int> type(0, 12);
+	for (size_t i = 0; i < MESSAGES; i++) {
+		switch (type(random)) {
+			case 0: messages.push_back(std::make_unique<AuthorizationSuccessCommand>()); break;
+			case 1: messages.push_back(std::make_unique<AuthorizationFailedCommand>()); break;
+			case 2: messages.push_back(std::make_unique<RegistrationSuccessCommand>()); break;
+			case 3: messages.push_back(std::make_unique<RegistrationFailedCommand>()); break;
+			case 4: messages.push_back(std::make_unique<GameJoinSuccessCommand>()); break;
+			case 5: messages.push_back(std::make_unique<GameJoinErrorCommand>()); break;
+			case 6: messages.push_back(std::make_unique<GraphicsUpdateCommand>()); break;
+			case 7: messages.push_back(std::make_unique<ControlUIUpdateCommand>()); break;
+			case 8: messages.push_back(std::make_unique<OverlayUpdateCommand>()); break;
+			case 9: messages.push_back(std::make_unique<OverlayResetCommand>()); break;
+			case 10: messages.push_back(std::make_unique<OpenWindowCommand>()); break;
+			case 11: messages.push_back(std::make_unique<UpdateWindowCommand>()); break;
+			default: messages.push_back(std::make_unique<AddChatMessageCommand>());
+		}
+	}
+	return messages;
+}
+
+// The same order as client Connection::parsePacket had
+uint dispatchWithCasts(uf::ISerializable *p) {
+	if (dynamic_cast<AuthorizationSuccessCommand *>(p)) return 1;
+	if (dynamic_cast<AuthorizationFailedCommand *>(p)) return 2;
+	if (dynamic_cast<RegistrationSuccessCommand *>(p)) return 3;
+	if (dynamic_cast<RegistrationFailedCommand *>(p)) return 4;
+	if (dynamic_cast<GameJoinSuccessCommand *>(p)) return 5;
+	if (dynamic_cast<GameJoinErrorCommand *>(p)) return 6;
+	if (dynamic_cast<GraphicsUpdateCommand *>(p)) return 7;
+	if (dynamic_cast<ControlUIUpdateCommand *>(p)) return 8;
+	if (dynamic_cast<OverlayUpdateCommand *>(p)) return 9;
+	if (dynamic_cast<OverlayResetCommand *>(p)) return 10;
+	if (dynamic_cast<OpenWindowCommand *>(p)) return 11;
+	if (dynamic_cast<UpdateWindowCommand *>(p)) return 12;
+	if (dynamic_cast<AddChatMessageCommand *>(p)) return 13;
+	return 0;
+}
+
+uint dispatchWithTable(uf::ISerializable *p) {
+	uint result = 0;
+	uf::Dispatch<
+		AuthorizationSuccessCommand, AuthorizationFailedCommand, RegistrationSuccessCommand, RegistrationFailedCommand,
+		GameJoinSuccessCommand, GameJoinErrorCommand, GraphicsUpdateCommand, ControlUIUpdateCommand,
+		OverlayUpdateCommand, OverlayResetCommand, OpenWindowCommand, UpdateWindowCommand, AddChatMessageCommand
+	>(*p, uf::Overloaded{
+		[&](AuthorizationSuccessCommand &) { result = 1; },
+		[&](AuthorizationFailedCommand &) { result = 2; },
+		[&](RegistrationSuccessCommand &) { result = 3; },
+		[&](RegistrationFailedCommand &) { result = 4; },
+		[&](GameJoinSuccessCommand &) { result = 5; },
+		[&](GameJoinErrorCommand &) { result = 6; },
+		[&](GraphicsUpdateCommand &) { result = 7; },
+		[&](ControlUIUpdateCommand &) { result = 8; },
+		[&](OverlayUpdateCommand &) { result = 9; },
+		[&](OverlayResetCommand &) { result = 10; },
+		[&](OpenWindowCommand &) { result = 11; },
+		[&](UpdateWindowCommand &) { result = 12; },
+		[&](AddChatMessageCommand &) { result = 13; }
+	});
+	return result;
+}
+
+} // namespace
+
+void DispatchBenchmark() {
+	auto messages = generateMessages();
+
+	uint64_t castsSum = 0, tableSum = 0;
+	auto casts = Measure([&] {
+		for (auto &message : messages)
+			castsSum += dispatchWithCasts(message.get());
+	}, ROUNDS);
+	auto table = Measure([&] {
+		for (auto &message : messages)
+			tableSum += dispatchWithTable(message.get());
+	}, ROUNDS);
+
+	if (castsSum != tableSum)
+		LOGE << "    Dispatch results differ!";
+
+	auto perSecond = [](std::chrono::nanoseconds time) {
+		return uint64_t(double(MESSAGES) / std::chrono::duration<double>(time).count());
+	};
+	LOGI << "    13 command types: dynamic_cast chain " << perSecond(casts) << " msg/s, "
+	     << "Dispatch " << perSecond(table) << " msg/s";
+}
+
+} // namespace benchmarks
@@ -0,0 +1,106 @@
+#include "Benchmarks.h"
+
+#include <plog/Log.h>
+
+#include <Shared/Network/Archive.h>
+#include <Shared/Network/Protocol/ServerToClient/Commands.h>
+
+namespace benchmarks {
+
+namespace {
+
+const size_t TICKS = 50;
+// diffs of one tick seen by every viewer
+const uint DIFFS_PER_TICK = 200;
+
+std::vector<std::shared_ptr<network::protocol::Diff>> generateDiffs() {
+	using namespace network::protocol;
+
+	std::vector<std::shared_ptr<Diff>> diffs;
+	for (uint i = 0; i < DIFFS_PER_TICK; i++) {
+		switch (i % 4) {
+			case 0: {
+				auto diff = std::make_shared<MoveDiff>();
+				diff->objId = i;
+				diff->direction = uf::Direction::NORTH;
+				diff->speed = 4;
+				diffs.push_back(std::move(diff));
+				break;
+			}
+			case 1: {
+				auto diff = std::make_shared<AddDiff>();
+				diff->objId = i;
+				diff->objectInfo.id = i;
+				diff->objectInfo.name = "Maintenance Airlock";
+				diff->objectInfo.spriteIds = { 10, 11, 12 };
+				diff->objectInfo.layer = 40;
+				diff->objectInfo.direction = uf::Direction::SOUTH;
+				diff->objectInfo.moveSpeed = 0;
+				diff->objectInfo.speed = uf::vec2f(0);
+				diff->coords = uf::vec3i(i, i, 0);
+				diff->layer = 40;
+				diffs.push_back(std::move(diff));
+				break;
+			}
+			case 2: {
+				auto diff = std::make_shared<UpdateIconsDiff>();
+				diff->objId = i;
+				diff->iconsIds = { 1, 2, 3, 4 };
+				diffs.push_back(std::move(diff));
+				break;
+			}
+			default: {
+				auto diff = std::make_shared<RelocateDiff>();
+				diff->objId = i;
+				diff->newCoords = uf::vec3i(i, i, 0);
+				diff->layer = 20;
+				diffs.push_back(std::move(diff));
+			}
+		}
+	}
+	return diffs;
+}
+
+void benchmarkViewers(uint viewers) {
+	std::chrono::nanoseconds plainTime(0), cachedTime(0);
+	size_t bytes = 0;
+
+	for (size_t tick = 0; tick < TICKS; tick++) {
+		auto diffs = generateDiffs();
+
+		// Every connection serializes every diff
+		plainTime += Measure([&] {
+			for (uint i = 0; i < viewers; i++) {
+				sf::Packet packet;
+				uf::InputArchive ar(packet);
+				ar << sf::Int32(diffs.size());
+				for (auto &diff : diffs)
+					diff->Serialize(ar);
+				bytes += packet.getDataSize();
+			}
+		}, 1);
+
+		cachedTime += Measure([&] {
+			for (uint i = 0; i < viewers; i++) {
+				sf::Packet packet;
+				uf::InputArchive ar(packet);
+				ar << sf::Int32(diffs.size());
+				for (auto &diff : diffs)
+					diff->SerializeCached(ar);
+			}
+		}, 1);
+	}
+
+	LOGI << "    " << viewers << " viewers of " << DIFFS_PER_TICK << " diffs (" << bytes / TICKS / viewers << " bytes): "
+	     << "serialize " << plainTime.count() / TICKS / 1000 << " us, "
+	     << "cached " << cachedTime.count() / TICKS / 1000 << " us per tick";
+}
+
+} // namespace
+
+void EncodingBenchmark() {
+	for (uint viewers : { 1, 10, 40 })
+		benchmarkViewers(viewers);
+}
+
+} // namespace benchmarks
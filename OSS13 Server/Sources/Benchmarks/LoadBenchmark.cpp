@@ -0,0 +1,140 @@
+#include "Benchmarks.h"
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include <SFML/Network.hpp>
+
+#include <plog/Log.h>
+
+#include <Shared/Global.hpp>
+#include <Shared/Network/Archive.h>
+#include <Shared/Network/Buffer.h>
+#include <Shared/Network/Protocol/ClientToServer/Commands.h>
+#include <Shared/Network/Protocol/ServerToClient/Commands.h>
+
+#include <Network/NetworkController.hpp>
+
+namespace benchmarks {
+
+namespace {
+
+using namespace network::protocol;
+
+// Loopback load generator: fake clients ping the server in rounds.
+// Keep CLIENTS * 2 below the open files limit.
+const size_t CLIENTS = 400;
+const size_t GENERATOR_THREADS = 4;
+const size_t ROUNDS = 200;
+// Doesn't clash with running server
+const uint16_t PORT = Global::PORT + 1;
+
+using Clock = std::chrono::steady_clock;
+
+struct GeneratorResult {
+	std::chrono::nanoseconds connectTime{0};
+	// Time of one round: ping from every client of the thread and all answers
+	std::vector<std::chrono::nanoseconds> rounds;
+	size_t failures{0};
+};
+
+void sendCommand(sf::TcpSocket &socket, Command &command) {
+	sf::Packet packet;
+	uf::InputArchive ar(packet);
+	ar << command;
+	socket.send(packet);
+}
+
+bool receivePong(sf::TcpSocket &socket, uint32_t id) {
+	sf::Packet packet;
+	if (socket.receive(packet) != sf::Socket::Done)
+		return false;
+	uf::Buffer buffer(packet.getData(), packet.getDataSize());
+	uf::OutputArchive ar(buffer);
+	auto command = ar.UnpackSerializable();
+	auto *pong = dynamic_cast<server::PongCommand *>(command.get());
+	return pong && pong->id == id;
+}
+
+void generate(size_t clientsCount, GeneratorResult &result) {
+	std::vector<uptr<sf::TcpSocket>> sockets;
+
+	auto start = Clock::now();
+	for (size_t i = 0; i < clientsCount; i++) {
+		auto socket = std::make_unique<sf::TcpSocket>();
+		if (socket->connect(sf::IpAddress::LocalHost, PORT, sf::seconds(5)) != sf::Socket::Done) {
+			result.failures++;
+			continue;
+		}
+		client::ProtocolOptionsCommand options;
+		options.compact = false;
+		options.compression = false;
+		options.batching = false;
+		sendCommand(*socket, options);
+		sockets.push_back(std::move(socket));
+	}
+	result.connectTime = Clock::now() - start;
+
+	for (uint32_t round = 0; round < ROUNDS; round++) {
+		auto roundStart = Clock::now();
+		client::PingCommand ping;
+		ping.id = round;
+		for (auto &socket : sockets)
+			sendCommand(*socket, ping);
+		for (auto &socket : sockets) {
+			if (!receivePong(*socket, round))
+				result.failures++;
+		}
+		result.rounds.push_back(Clock::now() - roundStart);
+	}
+
+	client::DisconnectionCommand disconnection;
+	for (auto &socket : sockets)
+		sendCommand(*socket, disconnection);
+}
+
+std::chrono::microseconds toMicroseconds(std::chrono::nanoseconds duration) {
+	return std::chrono::duration_cast<std::chrono::microseconds>(duration);
+}
+
+} // namespace
+
+void LoadBenchmark() {
+	NetworkController networkController(PORT);
+	networkController.Start();
+
+	std::vector<GeneratorResult> results(GENERATOR_THREADS);
+	std::vector<std::thread> generators;
+	auto start = Clock::now();
+	for (size_t i = 0; i < GENERATOR_THREADS; i++)
+		generators.emplace_back(generate, CLIENTS / GENERATOR_THREADS, std::ref(results[i]));
+	for (auto &generator : generators)
+		generator.join();
+	auto elapsed = Clock::now() - start;
+
+	networkController.Stop();
+
+	std::vector<std::chrono::nanoseconds> rounds;
+	std::chrono::nanoseconds connectTime{0};
+	size_t failures = 0;
+	for (auto &result : results) {
+		rounds.insert(rounds.end(), result.rounds.begin(), result.rounds.end());
+		connectTime = std::max(connectTime, result.connectTime);
+		failures += result.failures;
+	}
+	std::sort(rounds.begin(), rounds.end());
+	if (rounds.empty()) {
+		LOGE << "    no client has connected";
+		return;
+	}
+
+	const size_t clientsPerThread = CLIENTS / GENERATOR_THREADS;
+	const double seconds = std::chrono::duration<double>(elapsed).count();
+	LOGI << "    " << CLIENTS << " clients over loopback, connected in " << toMicroseconds(connectTime).count() / 1000 << " ms";
+	LOGI << "    " << size_t(double(CLIENTS * ROUNDS) / seconds) << " pings per second, " << failures << " failures";
+	LOGI << "    round of " << clientsPerThread << " pings: median " << toMicroseconds(rounds[rounds.size() / 2]).count() << " us, "
+	     << "p99 " << toMicroseconds(rounds[rounds.size() * 99 / 100]).count() << " us";
+}
+
+} // namespace benchmarks
@@ -0,0 +1,183 @@
+#include "Benchmarks.h"
+
+#include <algorithm>
+#include <random>
+
+#include <plog/Log.h>
+
+#include <World/Map.hpp>
+#include <World/Tile.hpp>
+#include <World/Atmos/Locale.hpp>
+#include <World/Objects/ObjectHolder.h>
+
+namespace benchmarks {
+
+namespace {
+
+using namespace std::chrono_literals;
+
+const size_t TICKS = 100;
+// Walls built in the room and then deconstructed every tick
+const uint WALLS_PER_TICK = 8;
+// Hull walls blown out to space and then repaired every tick
+const uint BREACHES_PER_TICK = 16;
+
+class Structure : public Object {
+public:
+	bool InteractedBy(Object *) override { return false; }
+	sptr<Object> GetOwnershipPointer() override { return {}; }
+	void updateIcons() override { }
+};
+
+// Square room of floor with the hull of walls, surrounded by a ring of space
+class Room {
+public:
+	explicit Room(uint side) :
+		side(side),
+		map(side + 2, side + 2, 1)
+	{
+		for (uint y = 1; y <= side; y++) {
+			for (uint x = 1; x <= side; x++) {
+				Tile *tile = map.GetTile({ int(x), int(y), 0 });
+				tile->PlaceTo(createStructure(true));
+				if (x == 1 || y == 1 || x == side || y == side)
+					hull.push_back(Place(tile));
+			}
+		}
+	}
+
+	void Tick() {
+		map.ClearDiffs();
+		map.Update(50ms);
+	}
+
+	// Wall with floor under it
+	struct Place {
+		explicit Place(Tile *tile) : tile(tile) { }
+		Tile *tile;
+		Object *floor{nullptr};
+		Object *wall{nullptr};
+	};
+
+	void BuildWall(Place &place) {
+		if (!place.wall)
+			place.wall = createStructure(false);
+		place.tile->PlaceTo(place.wall);
+	}
+
+	void RemoveWall(Place &place) { place.tile->RemoveObject(place.wall); }
+
+	// Blows out wall and floor, so the tile is space
+	void Breach(Place &place) {
+		place.floor = place.tile->Content().front();
+		RemoveWall(place);
+		place.tile->RemoveObject(place.floor);
+	}
+
+	void Repair(Place &place) {
+		place.tile->PlaceTo(place.floor);
+		BuildWall(place);
+	}
+
+	Map &GetMap() { return map; }
+	Locale *GetLocale(uint x, uint y) { return map.GetTile({ int(x), int(y), 0 })->GetLocale(); }
+
+	const uint side;
+	std::vector<Place> hull;
+
+private:
+	Object *createStructure(bool floor) {
+		auto *object = holder.CreateObject<Structure>();
+		if (floor)
+			object->SetIsFloor(true);
+		else
+			object->SetIsWall(true);
+		return object;
+	}
+
+	Map map;
+	ObjectHolder holder;
+};
+
+void benchmarkRoom(uint side) {
+	Room room(side);
+	auto build = Measure([&] { room.Tick(); }, 1);
+	for (auto &place : room.hull)
+		room.BuildWall(place);
+	room.Tick();
+
+	std::mt19937 random(0);
+	std::uniform_int_distribution<int> coord(2, int(side) - 1);
+
+	// Walls appear and disappear in the middle of the room
+	std::vector<Room::Place> walls;
+	auto wallsTime = Measure([&] {
+		walls.clear();
+		for (uint i = 0; i < WALLS_PER_TICK; i++) {
+			Tile *tile = room.GetMap().GetTile({ coord(random), coord(random), 0 });
+			if (std::any_of(walls.begin(), walls.end(), [tile](const Room::Place &wall) { return wall.tile == tile; }))
+				continue;
+			walls.emplace_back(tile);
+			room.BuildWall(walls.back());
+		}
+		room.Tick();
+		for (auto &wall : walls)
+			room.RemoveWall(wall);
+		room.Tick();
+	}, TICKS);
+
+	// Walls from hull to hull, the last one splits the room in two
+	std::vector<Room::Place> partition;
+	for (uint y = 2; y < side; y++)
+		partition.emplace_back(room.GetMap().GetTile({ int(side / 2), int(y), 0 }));
+	std::chrono::nanoseconds partitionTime(0), splitTime(0);
+	for (auto &place : partition) {
+		const bool last = &place == &partition.back();
+		auto time = Measure([&] { room.BuildWall(place); room.Tick(); }, 1);
+		(last ? splitTime : partitionTime) += time;
+	}
+	partitionTime /= partition.size() - 1;
+	const bool split = room.GetLocale(2, 2) != room.GetLocale(side - 1, side - 1);
+	auto mergeTime = Measure([&] { room.RemoveWall(partition.back()); room.Tick(); }, 1);
+	for (auto &place : partition)
+		room.RemoveWall(place);
+	room.Tick();
+
+	// Hull is breached at random places and repaired
+	std::uniform_int_distribution<size_t> hullIndex(0, room.hull.size() - 1);
+	std::vector<Room::Place *> breaches;
+	size_t openTicks = 0;
+	auto breachTime = Measure([&] {
+		breaches.clear();
+		for (uint i = 0; i < BREACHES_PER_TICK; i++) {
+			auto *place = &room.hull[hullIndex(random)];
+			if (std::find(breaches.begin(), breaches.end(), place) != breaches.end())
+				continue;
+			room.Breach(*place);
+			breaches.push_back(place);
+		}
+		room.Tick();
+		openTicks += !room.GetLocale(side / 2, side / 2)->IsClosed();
+		for (auto *place : breaches)
+			room.Repair(*place);
+		room.Tick();
+	}, TICKS);
+	const bool closed = room.GetLocale(side / 2, side / 2)->IsClosed();
+
+	LOGI << "    " << side << "x" << side << " room: built in " << build.count() / 1000 << " us, "
+	     << WALLS_PER_TICK << " walls built and removed " << wallsTime.count() / 1000 << " us, "
+	     << "partition wall " << partitionTime.count() / 1000 << " us, "
+	     << "split " << splitTime.count() / 1000 << " us" << (split ? "" : " (not detected)") << ", "
+	     << "merge " << mergeTime.count() / 1000 << " us, "
+	     << BREACHES_PER_TICK << " breaches and repairs " << breachTime.count() / 1000 << " us "
+	     << "(room open " << openTicks << "/" << TICKS << " ticks, closed after: " << closed << ")";
+}
+
+} // namespace
+
+void LocalesBenchmark() {
+	benchmarkRoom(100);
+	benchmarkRoom(250);
+}
+
+} // namespace benchmarks
@@ -0,0 +1,63 @@
+#include "Benchmarks.h"
+
+#include <plog/Log.h>
+
+#include <World/Map.hpp>
+#include <World/MapChunk.hpp>
+
+using namespace std::chrono_literals;
+
+namespace benchmarks {
+
+namespace {
+
+const size_t TICKS = 200;
+// tiles changed every tick in "busy" case
+const uint TOUCHED_TILES = 64;
+
+void tickPass(Map &map) {
+	map.ClearDiffs();
+	map.Update(50ms);
+}
+
+// Worst case, the same amount of tiles as the old full map pass walked
+void touchAllTiles(Map &map) {
+	apos size = map.GetSize();
+	for (uint z = 0; z < size.z; z++)
+		for (uint y = 0; y < size.y; y++)
+			for (uint x = 0; x < size.x; x++)
+				map.GetTile(apos(x, y, z))->CheckLocale();
+}
+
+void touchTiles(Map &map, uint tick) {
+	apos size = map.GetSize();
+	for (uint i = 0; i < TOUCHED_TILES; i++) {
+		uint n = tick * TOUCHED_TILES + i;
+		apos pos((n * 7919) % size.x, (n * 104729) % size.y, n % size.z);
+		map.GetTile(pos)->CheckLocale();
+	}
+}
+
+void benchmarkMapSize(uint x, uint y, uint z) {
+	Map map(x, y, z);
+	uint tick = 0;
+
+	auto idle = Measure([&] { tickPass(map); }, TICKS);
+	auto busy = Measure([&] { touchTiles(map, tick++); tickPass(map); }, TICKS);
+	auto full = Measure([&] { touchAllTiles(map); tickPass(map); }, TICKS / 10);
+
+	LOGI << "    " << x << "x" << y << "x" << z << " (" << map.GetChunks().size() << " chunks): "
+	     << "idle tick " << idle.count() / 1000 << " us, "
+	     << TOUCHED_TILES << " touched tiles " << busy.count() / 1000 << " us, "
+	     << "all tiles touched " << full.count() / 1000 << " us";
+}
+
+} // namespace
+
+void MapBenchmark() {
+	benchmarkMapSize(100, 100, 3);
+	benchmarkMapSize(250, 250, 4);
+	benchmarkMapSize(500, 500, 8);
+}
+
+} // namespace benchmarks
@@ -0,0 +1,99 @@
+#include "Benchmarks.h"
+
+#include <random>
+
+#include <plog/Log.h>
+
+#include <World/Map.hpp>
+#include <World/Tile.hpp>
+#include <World/Objects/ObjectHolder.h>
+
+namespace benchmarks {
+
+namespace {
+
+using namespace std::chrono_literals;
+
+const size_t TICKS = 100;
+// Creatures and projectiles which have something to do every tick
+const double BUSY_FRACTION = 0.02;
+// Objects woken by interactions on every tick
+const double WOKEN_FRACTION = 0.005;
+
+// Update of the script object stands for the call into Python
+size_t updateCalls;
+
+class BenchmarkObject : public Object {
+public:
+	void Update(std::chrono::microseconds timeElapsed) override {
+		Object::Update(timeElapsed);
+		updateCalls++;
+		if (busy)
+			Wake();
+	}
+
+	bool InteractedBy(Object *) override { return false; }
+	sptr<Object> GetOwnershipPointer() override { return {}; }
+	void updateIcons() override { }
+
+	bool busy{false};
+};
+
+class BenchmarkHolder : public ObjectHolder {
+public:
+	// How World updated objects before the active set
+	void UpdateAll(std::chrono::microseconds timeElapsed) {
+		for (auto &object : objects) {
+			if (object)
+				object->Update(timeElapsed);
+		}
+	}
+
+	void UpdateAwake(std::chrono::microseconds timeElapsed) { updateAwakeObjects(timeElapsed); }
+};
+
+} // namespace
+
+void ObjectsBenchmark() {
+	for (uint objectsNum : { 10000, 50000 }) {
+		Map map(250, 250, 1);
+		BenchmarkHolder holder;
+		std::mt19937 random(0);
+		std::uniform_int_distribution<int> coord(0, 249);
+		std::bernoulli_distribution busy(BUSY_FRACTION);
+
+		std::vector<BenchmarkObject *> objects;
+		for (uint i = 0; i < objectsNum; i++) {
+			auto *object = holder.CreateObject<BenchmarkObject>(map.GetTile({ coord(random), coord(random), 0 }));
+			object->busy = busy(random);
+			objects.push_back(object);
+		}
+		// New objects send their icons on the first tick
+		holder.UpdateAwake(50ms);
+		map.ClearDiffs();
+
+		std::uniform_int_distribution<size_t> objectIndex(0, objectsNum - 1);
+		const size_t woken = size_t(objectsNum * WOKEN_FRACTION);
+
+		std::chrono::nanoseconds allTime(0), awakeTime(0);
+		size_t allCalls = 0, awakeCalls = 0;
+		for (size_t tick = 0; tick < TICKS; tick++) {
+			updateCalls = 0;
+			allTime += Measure([&] { holder.UpdateAll(50ms); }, 1);
+			allCalls += updateCalls;
+
+			for (size_t i = 0; i < woken; i++)
+				objects[objectIndex(random)]->Wake();
+			updateCalls = 0;
+			awakeTime += Measure([&] { holder.UpdateAwake(50ms); }, 1);
+			awakeCalls += updateCalls;
+			map.ClearDiffs();
+		}
+
+		LOGI << "    " << objectsNum << " objects: "
+		     << "every object " << allTime.count() / TICKS / 1000 << " us and " << allCalls / TICKS << " updates per tick, "
+		     << "awake objects " << awakeTime.count() / TICKS / 1000 << " us and " << awakeCalls / TICKS << " updates per tick";
+	}
+}
+
+} // namespace benchmarks
@@ -0,0 +1,160 @@
+#include "Benchmarks.h"
+
+#include <algorithm>
+
+#include <plog/Log.h>
+
+#include <World/Map.hpp>
+#include <World/Tile.hpp>
+#include <World/Atmos/AtmosCameraOverlay.h>
+#include <World/Objects/ObjectHolder.h>
+
+#include <Shared/Global.hpp>
+#include <Shared/Network/Archive.h>
+#include <Shared/Network/Buffer.h>
+#include <Shared/Network/Protocol/ServerToClient/Commands.h>
+
+namespace benchmarks {
+
+namespace {
+
+using namespace std::chrono_literals;
+using namespace network::protocol;
+using namespace network::protocol::server;
+
+const size_t UPDATES = 40;
+// Overlay updates four times per second, world ticks at 20 Hz
+const size_t TICKS_PER_UPDATE = 5;
+const uint MAP_SIDE = 64;
+
+const int VIEW_SIDE = Global::FOV + 2 * Global::MIN_PADDING;
+const int VIEW_HEIGHT = Global::Z_FOV | 1;
+
+class Floor : public Object {
+public:
+	bool InteractedBy(Object *) override { return false; }
+	sptr<Object> GetOwnershipPointer() override { return {}; }
+	void updateIcons() override { }
+};
+
+// How overlay was sent before: text of every tile as serializable struct with type id
+size_t sendTexts(uf::Buffer &buffer, const AtmosCameraOverlay &overlay, const std::vector<Tile *> &cells) {
+	const auto layer = overlay.GetOverlayInfo();
+	std::vector<float> values(layer.channels.size());
+
+	buffer.BeginFrame();
+	uf::InputArchive ar(buffer);
+	ar << sf::Int32(cells.size());
+	for (auto *tile : cells) {
+		overlay.GetValues(*tile, values.data());
+		ar << sf::Int32(0);
+		ar << layer.Format(values.data());
+	}
+	buffer.EndFrame();
+	return buffer.GetSize();
+}
+
+// Does the same work as Camera::updateOverlay without players and connections
+struct SimulatedOverlay {
+	OverlayInfo layer;
+	bool layerSent{false};
+	std::vector<sf::Uint8> values;
+	std::vector<bool> known;
+
+	size_t Send(uf::Buffer &buffer, const AtmosCameraOverlay &overlay, const std::vector<Tile *> &cells) {
+		OverlayUpdateCommand command;
+		auto newLayer = overlay.GetOverlayInfo();
+		if (!layerSent || newLayer != layer) {
+			layer = newLayer;
+			layerSent = true;
+			values.assign(cells.size() * layer.GetCellSize(), 0);
+			known.assign(cells.size(), false);
+			command.newLayer = true;
+			command.layer = layer;
+		}
+
+		const size_t valueSize = layer.GetValueSize();
+		const size_t cellSize = layer.GetCellSize();
+		std::vector<float> cellValues(layer.channels.size());
+		std::vector<sf::Uint8> packed(cellSize);
+
+		command.changedCells.resize((cells.size() + 7) / 8);
+		for (size_t cell = 0; cell < cells.size(); cell++) {
+			overlay.GetValues(*cells[cell], cellValues.data());
+			for (size_t channel = 0; channel < cellValues.size(); channel++)
+				layer.Pack(cellValues[channel], packed.data() + channel * valueSize);
+			auto last = values.begin() + cell * cellSize;
+			if (known[cell] && std::equal(packed.begin(), packed.end(), last))
+				continue;
+			std::copy(packed.begin(), packed.end(), last);
+			known[cell] = true;
+			command.SetChanged(cell);
+			command.values.insert(command.values.end(), packed.begin(), packed.end());
+		}
+
+		if (!command.newLayer && command.values.empty())
+			return 0;
+		buffer.BeginFrame();
+		uf::InputArchive ar(buffer);
+		ar << command;
+		buffer.EndFrame();
+		return buffer.GetSize();
+	}
+};
+
+} // namespace
+
+void OverlayBenchmark() {
+	// Station floor with a breach to space in the corner and a plasma leak near the viewer
+	Map map(MAP_SIDE, MAP_SIDE, VIEW_HEIGHT);
+	ObjectHolder holder;
+	for (uint z = 0; z < map.GetSize().z; z++) {
+		for (uint y = 0; y < MAP_SIDE; y++) {
+			for (uint x = 0; x < MAP_SIDE; x++) {
+				if (x < 2 && y < 2)
+					continue;
+				auto *floor = holder.CreateObject<Floor>();
+				floor->SetIsFloor(true);
+				map.GetTile({ int(x), int(y), int(z) })->PlaceTo(floor);
+			}
+		}
+	}
+	map.Update(50ms);
+
+	const rpos firstBlock(MAP_SIDE / 2 - VIEW_SIDE / 2, MAP_SIDE / 2 - VIEW_SIDE / 2, 0);
+	std::vector<Tile *> cells;
+	for (int z = 0; z < VIEW_HEIGHT; z++)
+		for (int y = 0; y < VIEW_SIDE; y++)
+			for (int x = 0; x < VIEW_SIDE; x++)
+				cells.push_back(map.GetTile(firstBlock + rpos(x, y, z)));
+	map.GetAtmos()->GetGrid().SetPressure({ MAP_SIDE / 2, MAP_SIDE / 2, 0 }, Gas::Plasma, 1000.f);
+
+	LOGI << "    " << cells.size() << " tiles in view, update every " << TICKS_PER_UPDATE << " ticks";
+
+	const std::pair<AtmosCameraOverlayMode, const char *> modes[] = {
+		{ AtmosCameraOverlayMode::Locale, "locale" },
+		{ AtmosCameraOverlayMode::Pressure, "pressure" },
+		{ AtmosCameraOverlayMode::PartialGasPressure, "gases" }
+	};
+	uf::Buffer buffer;
+	for (auto &[mode, name] : modes) {
+		AtmosCameraOverlay overlay;
+		overlay.SetMode(mode);
+		SimulatedOverlay simulated;
+
+		size_t textBytes = 0, deltaBytes = 0;
+		std::chrono::nanoseconds textTime(0), deltaTime(0);
+		for (size_t update = 0; update < UPDATES; update++) {
+			for (size_t tick = 0; tick < TICKS_PER_UPDATE; tick++)
+				map.Update(50ms);
+			textTime += Measure([&] { textBytes += sendTexts(buffer, overlay, cells); }, 1);
+			deltaTime += Measure([&] { deltaBytes += simulated.Send(buffer, overlay, cells); }, 1);
+		}
+
+		LOGI << "    " << name << ": text of every tile " << textBytes / UPDATES << " bytes "
+		     << textTime.count() / UPDATES / 1000 << " us, changed packed values " << deltaBytes / UPDATES << " bytes "
+		     << deltaTime.count() / UPDATES / 1000 << " us per update";
+	}
+}
+
+} // namespace benchmarks
@@ -0,0 +1,114 @@
+#include "Benchmarks.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <thread>
+
+#include <plog/Log.h>
+
+#include <World/Map.hpp>
+#include <World/MapChunk.hpp>
+#include <World/Tile.hpp>
+#include <World/Camera/DiffsMerger.h>
+
+#include <Shared/Global.hpp>
+#include <Shared/ThreadPool.h>
+#include <Shared/Network/Protocol/ServerToClient/Diff.h>
+#include <Shared/Network/Protocol/ServerToClient/WorldInfo.h>
+
+namespace benchmarks {
+
+namespace {
+
+const size_t TICKS = 50;
+const uint DIFFS_PER_TICK = 2000;
+const int BUSY_AREA_SIDE = 100;
+// Camera moves and resyncs its whole view once per so many ticks
+const size_t RESYNC_PERIOD = 10;
+
+const int VIEW_SIDE = Global::FOV + 2 * Global::MIN_PADDING;
+const int VIEW_HEIGHT = Global::Z_FOV | 1;
+
+// Does the same work as Camera::UpdateView without players and connections
+struct SimulatedView {
+	rpos firstBlock;
+	std::vector<MapChunk *> chunks;
+	DiffsMerger merger;
+	std::vector<sptr<network::protocol::Diff>> diffs;
+	std::vector<network::protocol::TileInfo> tilesInfo;
+
+	void Update(Map &map, size_t tick) {
+		diffs.clear();
+		tilesInfo.clear();
+
+		if (tick % RESYNC_PERIOD == 0) {
+			for (int z = 0; z < VIEW_HEIGHT; z++)
+				for (int y = 0; y < VIEW_SIDE; y++)
+					for (int x = 0; x < VIEW_SIDE; x++)
+						if (Tile *tile = map.GetTile(firstBlock + rpos(x, y, z)))
+							tilesInfo.push_back(tile->GetTileInfo(0, 0));
+		}
+
+		merger.Merge(chunks, [&](const MapChunk::DiffRecord &record) {
+			rpos pos = record.tile->GetPos() - firstBlock;
+			if (pos >= rpos(0) && pos < rpos(VIEW_SIDE, VIEW_SIDE, VIEW_HEIGHT))
+				diffs.push_back(map.ShareDiff(record.diff));
+		});
+	}
+};
+
+void generateDiffs(Map &map, std::mt19937 &random, int areaFirst) {
+	std::uniform_int_distribution<int> coord(areaFirst, areaFirst + BUSY_AREA_SIDE - 1);
+	std::uniform_int_distribution<int> level(0, int(map.GetSize().z) - 1);
+	for (uint i = 0; i < DIFFS_PER_TICK; i++) {
+		Tile *tile = map.GetTile({coord(random), coord(random), level(random)});
+		tile->GetChunk()->AddDiff(tile, map.CreateDiff<network::protocol::MoveDiff>(), {});
+	}
+}
+
+std::chrono::nanoseconds measureViews(Map &map, uint playersNum, uf::ThreadPool &pool) {
+	std::mt19937 random(playersNum);
+	const int areaFirst = int(map.GetSize().x) / 2 - BUSY_AREA_SIDE / 2;
+	std::uniform_int_distribution<int> coord(areaFirst, areaFirst + BUSY_AREA_SIDE - VIEW_SIDE);
+
+	std::vector<SimulatedView> views(playersNum);
+	for (auto &view : views) {
+		view.firstBlock = rpos(coord(random), coord(random), 0);
+		map.GetChunks(view.firstBlock, {VIEW_SIDE, VIEW_SIDE, VIEW_HEIGHT}, view.chunks);
+	}
+
+	std::chrono::nanoseconds time(0);
+	for (size_t tick = 0; tick < TICKS; tick++) {
+		map.ClearDiffs();
+		generateDiffs(map, random, areaFirst);
+		map.SetReadOnly(true);
+		time += Measure([&] {
+			// Resyncs of different views are spread over ticks
+			pool.ParallelFor(views.size(), [&](size_t i) { views[i].Update(map, tick + i); });
+		}, 1);
+		map.SetReadOnly(false);
+	}
+	map.ClearDiffs();
+	return time / TICKS;
+}
+
+} // namespace
+
+void ParallelViewBenchmark() {
+	Map map(250, 250, 4);
+	uf::ThreadPool serial(0);
+	uf::ThreadPool parallel(std::max(std::thread::hardware_concurrency(), 2u) - 1);
+
+	for (uint playersNum : { 10, 50, 100 }) {
+		auto serialTime = measureViews(map, playersNum, serial);
+		auto parallelTime = measureViews(map, playersNum, parallel);
+		std::ostringstream speedup;
+		speedup << std::fixed << std::setprecision(1) << double(serialTime.count()) / double(std::max<int64_t>(parallelTime.count(), 1));
+		LOGI << "    " << playersNum << " players: one thread " << serialTime.count() / 1000 << " us, "
+		     << parallel.GetThreadsCount() + 1 << " threads " << parallelTime.count() / 1000 << " us per tick (x" << speedup.str() << ")";
+	}
+}
+
+} // namespace benchmarks
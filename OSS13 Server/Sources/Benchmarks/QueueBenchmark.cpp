@@ -0,0 +1,75 @@
+#include "Benchmarks.h"
+
+#include <thread>
+#include <vector>
+
+#include <plog/Log.h>
+
+#include <Shared/MPSCQueue.hpp>
+#include <Shared/SPSCRing.hpp>
+#include <Shared/ThreadSafeQueue.hpp>
+
+namespace benchmarks {
+
+namespace {
+
+const size_t ITEMS_PER_PRODUCER = 200000;
+
+// Producers push pointers, the consumer takes them until all are received, like commands of Connection
+template<class Push, class Consume>
+std::chrono::nanoseconds measureTransfer(size_t producersNum, Push &&push, Consume &&consume) {
+	static int item;
+	return Measure([&] {
+		std::vector<std::thread> producers;
+		for (size_t i = 0; i < producersNum; i++)
+			producers.emplace_back([&] {
+				for (size_t j = 0; j < ITEMS_PER_PRODUCER; j++)
+					push(&item);
+			});
+
+		size_t received = 0;
+		while (received < producersNum * ITEMS_PER_PRODUCER) {
+			size_t taken = consume();
+			if (!taken)
+				std::this_thread::yield();
+			received += taken;
+		}
+
+		for (auto &producer : producers)
+			producer.join();
+	}, 1) / (producersNum * ITEMS_PER_PRODUCER);
+}
+
+} // namespace
+
+void QueueBenchmark() {
+	for (size_t producersNum : { 1, 2, 4, 8 }) {
+		uf::ThreadSafeQueue<int *> mutexQueue;
+		auto mutexTime = measureTransfer(producersNum,
+			[&](int *item) { mutexQueue.Push(item); },
+			[&] {
+				size_t count = 0;
+				while (!mutexQueue.Empty()) {
+					mutexQueue.Pop();
+					count++;
+				}
+				return count;
+			});
+
+		uf::MPSCQueue<int *> lockFreeQueue;
+		auto lockFreeTime = measureTransfer(producersNum,
+			[&](int *item) { lockFreeQueue.Push(item); },
+			[&] { return lockFreeQueue.Drain([](int *) { }); });
+
+		LOGI << "    " << producersNum << " producers: ThreadSafeQueue " << mutexTime.count()
+		     << " ns, MPSCQueue " << lockFreeTime.count() << " ns per item";
+	}
+
+	uf::SPSCRing<int *> ring(1024);
+	auto ringTime = measureTransfer(1,
+		[&](int *item) { while (!ring.TryPush(item)) std::this_thread::yield(); },
+		[&] { return ring.Drain([](int *) { }); });
+	LOGI << "    1 producer: SPSCRing " << ringTime.count() << " ns per item";
+}
+
+} // namespace benchmarks
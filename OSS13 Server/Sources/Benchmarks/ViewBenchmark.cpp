@@ -0,0 +1,111 @@
+#include "Benchmarks.h"
+
+#include <algorithm>
+#include <random>
+
+#include <plog/Log.h>
+
+#include <World/Map.hpp>
+#include <World/MapChunk.hpp>
+#include <World/Camera/DiffsMerger.h>
+
+#include <Shared/Global.hpp>
+#include <Shared/Network/Protocol/ServerToClient/Diff.h>
+
+namespace benchmarks {
+
+namespace {
+
+const size_t TICKS = 50;
+// diffs generated every tick over busy area
+const uint DIFFS_PER_TICK = 2000;
+// busy area in the middle of the map where all diffs and cameras are
+const int BUSY_AREA_SIDE = 100;
+
+const int VIEW_SIDE = Global::FOV + 2 * Global::MIN_PADDING;
+const int VIEW_HEIGHT = Global::Z_FOV | 1;
+
+struct TestCamera {
+	rpos firstBlock;
+	std::vector<MapChunk *> chunks;
+	DiffsMerger merger;
+};
+
+bool inView(const TestCamera &camera, const MapChunk::DiffRecord &record) {
+	rpos pos = record.tile->GetPos() - camera.firstBlock;
+	return pos >= rpos(0) && pos < rpos(VIEW_SIDE, VIEW_SIDE, VIEW_HEIGHT);
+}
+
+void generateDiffs(Map &map, std::mt19937 &random, int areaFirst) {
+	std::uniform_int_distribution<int> coord(areaFirst, areaFirst + BUSY_AREA_SIDE - 1);
+	std::uniform_int_distribution<int> level(0, int(map.GetSize().z) - 1);
+	for (uint i = 0; i < DIFFS_PER_TICK; i++) {
+		Tile *tile = map.GetTile({coord(random), coord(random), level(random)});
+		tile->GetChunk()->AddDiff(tile, map.CreateDiff<network::protocol::MoveDiff>(), {});
+	}
+}
+
+// Every camera copies diffs of its view and sorts them
+size_t copyAndSort(std::vector<TestCamera> &cameras) {
+	size_t processed = 0;
+	for (auto &camera : cameras) {
+		std::vector<MapChunk::DiffRecord> diffs;
+		for (auto *chunk : camera.chunks)
+			for (auto &record : chunk->GetDiffs())
+				if (inView(camera, record))
+					diffs.push_back(record);
+		std::sort(diffs.begin(), diffs.end(), [](const MapChunk::DiffRecord &a, const MapChunk::DiffRecord &b) {
+			return a.diff->GetDiffId() < b.diff->GetDiffId();
+		});
+		processed += diffs.size();
+	}
+	return processed;
+}
+
+// Every camera merges sorted chunk streams
+size_t merge(std::vector<TestCamera> &cameras) {
+	size_t processed = 0;
+	for (auto &camera : cameras) {
+		camera.merger.Merge(camera.chunks, [&](const MapChunk::DiffRecord &record) {
+			if (inView(camera, record))
+				processed++;
+		});
+	}
+	return processed;
+}
+
+void benchmarkCameras(Map &map, uint camerasNum) {
+	std::mt19937 random(camerasNum);
+	const int areaFirst = int(map.GetSize().x) / 2 - BUSY_AREA_SIDE / 2;
+	std::uniform_int_distribution<int> coord(areaFirst, areaFirst + BUSY_AREA_SIDE - VIEW_SIDE);
+
+	std::vector<TestCamera> cameras(camerasNum);
+	for (auto &camera : cameras) {
+		camera.firstBlock = rpos(coord(random), coord(random), 0);
+		map.GetChunks(camera.firstBlock, {VIEW_SIDE, VIEW_SIDE, VIEW_HEIGHT}, camera.chunks);
+	}
+
+	std::chrono::nanoseconds copyAndSortTime(0), mergeTime(0);
+	size_t diffsSeen = 0;
+	for (size_t tick = 0; tick < TICKS; tick++) {
+		map.ClearDiffs();
+		generateDiffs(map, random, areaFirst);
+		copyAndSortTime += Measure([&] { diffsSeen += copyAndSort(cameras); }, 1);
+		mergeTime += Measure([&] { merge(cameras); }, 1);
+	}
+	map.ClearDiffs();
+
+	LOGI << "    " << camerasNum << " cameras, " << diffsSeen / TICKS / camerasNum << " diffs per camera: "
+	     << "copy and sort " << copyAndSortTime.count() / TICKS / 1000 << " us, "
+	     << "merge " << mergeTime.count() / TICKS / 1000 << " us per tick";
+}
+
+} // namespace
+
+void ViewBenchmark() {
+	Map map(250, 250, 4);
+	for (uint camerasNum : { 10, 60, 120 })
+		benchmarkCameras(map, camerasNum);
+}
+
+} // namespace benchmarks
@@ -0,0 +1,142 @@
+#include "WalkScenario.h"
+
+#include <Shared/Global.hpp>
+
+namespace benchmarks {
+
+using namespace network::protocol;
+using namespace network::protocol::server;
+
+namespace {
+
+// camera steps to the next tile every STEP_TICKS
+const size_t STEP_TICKS = 2;
+const uint MOBS = 12;
+
+const int VIEW_SIDE = Global::FOV + 2 * Global::MIN_PADDING;
+const int VIEW_HEIGHT = Global::Z_FOV | 1;
+
+const char *const NAMES[] = { "Wall", "Airlock", "Light", "Table", "Chair", "Locker", "Crate", "Cable", "Pipe" };
+
+ObjectInfo generateObjectInfo(uint id, int kind) {
+	ObjectInfo info;
+	info.id = id;
+	info.name = NAMES[kind];
+	info.spriteIds = { uint32_t(100 + kind), uint32_t(200 + kind) };
+	info.layer = 10 + kind * 5;
+	info.direction = uf::Direction::SOUTH;
+	info.opacity.SetFractions({});
+	if (kind <= 1) {
+		info.solidity.Add({ uf::Direction::CENTER });
+		info.opacity.SetFractions({ 0, 0, 0, 0, 1 });
+	}
+	info.moveSpeed = 0;
+	info.speed = uf::vec2f(0);
+	return info;
+}
+
+// Station of rooms 10x10: walls with airlocks and some furniture inside
+TileInfo generateTileInfo(uf::vec3i coords) {
+	TileInfo tileInfo;
+	tileInfo.coords = coords;
+	tileInfo.sprite = 5;
+
+	uint id = uint(coords.x + coords.y * 1000 + coords.z * 1000000) * 4;
+	bool wallX = coords.x % 10 == 0, wallY = coords.y % 10 == 0;
+	if (wallX || wallY) {
+		bool door = (wallX && coords.y % 10 == 5) || (wallY && coords.x % 10 == 5);
+		tileInfo.content.push_back(generateObjectInfo(id, door ? 1 : 0));
+	} else {
+		int kind = (coords.x * 7 + coords.y * 13 + coords.z) % 16;
+		if (kind < 7)
+			tileInfo.content.push_back(generateObjectInfo(id + 1, kind + 2));
+		if (kind % 4 == 0)
+			tileInfo.content.push_back(generateObjectInfo(id + 2, 7));
+	}
+	return tileInfo;
+}
+
+void addTiles(GraphicsUpdateCommand &command, uf::vec3i firstTile, uf::vec3i from, uf::vec3i to) {
+	command.options |= GraphicsUpdateCommand::Option::TILES_SHIFT;
+	command.firstTile = firstTile;
+	for (int z = from.z; z < to.z; z++)
+		for (int y = from.y; y < to.y; y++)
+			for (int x = from.x; x < to.x; x++)
+				command.tilesInfo.push_back(generateTileInfo(firstTile + uf::vec3i(x, y, z)));
+}
+
+// Walk around the rectangle loop with jumps between two places
+uf::vec3i cameraPosition(size_t tick) {
+	const int width = 60, height = 40;
+	int step = int(tick / STEP_TICKS) % (2 * (width + height));
+	uf::vec3i start = (tick / WALK_JUMP_TICKS) % 2 ? uf::vec3i(300, 100, 2) : uf::vec3i(100, 100, 1);
+	if (step < width) return start + uf::vec3i(step, 0, 0);
+	step -= width;
+	if (step < height) return start + uf::vec3i(width, step, 0);
+	step -= height;
+	if (step < width) return start + uf::vec3i(width - step, height, 0);
+	step -= width;
+	return start + uf::vec3i(0, height - step, 0);
+}
+
+} // namespace
+
+std::vector<GraphicsUpdateCommand> GenerateWalkScenario(size_t ticks) {
+	std::vector<GraphicsUpdateCommand> commands(ticks);
+	uf::vec3i lastFirstTile;
+	for (size_t tick = 0; tick < ticks; tick++) {
+		auto &command = commands[tick];
+		command.options = GraphicsUpdateCommand::Option::EMPTY;
+
+		uf::vec3i camera = cameraPosition(tick);
+		uf::vec3i firstTile = camera - uf::vec3i(VIEW_SIDE / 2, VIEW_SIDE / 2, VIEW_HEIGHT / 2);
+		uf::vec3i shift = firstTile - lastFirstTile;
+		if (tick == 0 || std::abs(shift.x) + std::abs(shift.y) > 1 || shift.z) {
+			addTiles(command, firstTile, uf::vec3i(0), uf::vec3i(VIEW_SIDE, VIEW_SIDE, VIEW_HEIGHT));
+		} else if (shift.x || shift.y) {
+			// only new row or column is unsynced
+			uf::vec3i from(shift.x > 0 ? VIEW_SIDE - 1 : 0, shift.y > 0 ? VIEW_SIDE - 1 : 0, 0);
+			uf::vec3i to(shift.x ? from.x + 1 : VIEW_SIDE, shift.y ? from.y + 1 : VIEW_SIDE, VIEW_HEIGHT);
+			addTiles(command, firstTile, from, to);
+		}
+		if (firstTile != lastFirstTile) {
+			command.options |= GraphicsUpdateCommand::Option::CAMERA_MOVE;
+			command.camera = camera;
+		}
+		lastFirstTile = firstTile;
+
+		// Mobs wander around the camera
+		for (uint mob = 0; mob < MOBS; mob++) {
+			uint id = 10 + mob;
+			if ((tick + mob) % 3)
+				continue;
+			auto moveDiff = std::make_shared<MoveDiff>();
+			moveDiff->objId = id;
+			moveDiff->direction = uf::Direction(mob % 4);
+			moveDiff->speed = 4;
+			command.diffs.push_back(std::move(moveDiff));
+
+			auto relocateDiff = std::make_shared<RelocateDiff>();
+			relocateDiff->objId = id;
+			relocateDiff->newCoords = camera + uf::vec3i(int(mob % 5) - 2, int(tick % 7) - 3, 0);
+			relocateDiff->layer = 75;
+			command.diffs.push_back(std::move(relocateDiff));
+		}
+		// Somebody enters view
+		if (tick % 25 == 0) {
+			auto addDiff = std::make_shared<AddDiff>();
+			addDiff->objId = uint32_t(1000 + tick);
+			addDiff->objectInfo = generateObjectInfo(addDiff->objId, 6);
+			addDiff->objectInfo.name = "Engineer";
+			addDiff->objectInfo.moveSpeed = 4;
+			addDiff->coords = camera + uf::vec3i(VIEW_SIDE / 2, 0, 0);
+			addDiff->layer = 75;
+			command.diffs.push_back(std::move(addDiff));
+		}
+		if (!command.diffs.empty())
+			command.options |= GraphicsUpdateCommand::Option::DIFFERENCES;
+	}
+	return commands;
+}
+
+} // namespace benchmarks
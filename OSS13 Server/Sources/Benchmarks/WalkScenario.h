@@ -0,0 +1,16 @@
+#pragma once
+
+#include <vector>
+
+#include <Shared/Network/Protocol/ServerToClient/Commands.h>
+
+namespace benchmarks {
+
+// Camera jumps to another place (teleport, ladder) every WALK_JUMP_TICKS
+const size_t WALK_JUMP_TICKS = 150;
+
+// Player walks around the station, mobs wander around and somebody enters the view from time to time.
+// Returns commands which the camera sends to the player on every tick.
+std::vector<network::protocol::server::GraphicsUpdateCommand> GenerateWalkScenario(size_t ticks);
+
+} // namespace benchmarks
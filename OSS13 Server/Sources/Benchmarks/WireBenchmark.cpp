@@ -0,0 +1,72 @@
+#include "Benchmarks.h"
+
+#include <plog/Log.h>
+
+#include <Shared/Network/Archive.h>
+#include <Shared/Network/Buffer.h>
+#include <Shared/Network/NameTable.h>
+#include <Shared/Network/Protocol/ServerToClient/Commands.h>
+
+#include "WalkScenario.h"
+
+namespace benchmarks {
+
+namespace {
+
+using namespace network::protocol;
+using namespace network::protocol::server;
+
+const size_t TICKS = 1000;
+
+size_t sendFrame(uf::Buffer &buffer, Command &command, uf::NameTable *names) {
+	buffer.BeginFrame();
+	uf::InputArchive ar(buffer);
+	if (names)
+		ar.SetCompact(names);
+	ar << command;
+	buffer.EndFrame();
+	return buffer.GetSize();
+}
+
+} // namespace
+
+void WireBenchmark() {
+	auto commands = GenerateWalkScenario(TICKS);
+
+	uf::Buffer buffer;
+	uf::NameTable names;
+	uint32_t namesSent = 0;
+	size_t plainBytes = 0, compactBytes = 0;
+	size_t plainJump = 0, compactJump = 0;
+
+	for (size_t tick = 0; tick < TICKS; tick++) {
+		size_t plain = sendFrame(buffer, commands[tick], nullptr);
+		size_t compact = sendFrame(buffer, commands[tick], &names);
+
+		// The same way as NetworkController sends new names
+		ObjectNamesCommand namesCommand;
+		namesCommand.first = namesSent;
+		namesCommand.names = names.GetNames(namesSent);
+		if (!namesCommand.names.empty()) {
+			namesSent += uint32_t(namesCommand.names.size());
+			compact += sendFrame(buffer, namesCommand, nullptr);
+		}
+
+		plainBytes += plain;
+		compactBytes += compact;
+		if (tick % WALK_JUMP_TICKS == 0) {
+			plainJump += plain;
+			compactJump += compact;
+		}
+	}
+
+	const size_t jumps = (TICKS + WALK_JUMP_TICKS - 1) / WALK_JUMP_TICKS;
+	LOGI << "    walk-around, " << TICKS << " ticks: "
+	     << "plain " << plainBytes / TICKS << " bytes, "
+	     << "compact " << compactBytes / TICKS << " bytes per tick per client";
+	LOGI << "    camera jump (" << commands[0].tilesInfo.size() << " tiles): "
+	     << "plain " << plainJump / jumps << " bytes, "
+	     << "compact " << compactJump / jumps << " bytes";
+}
+
+} // namespace benchmarks
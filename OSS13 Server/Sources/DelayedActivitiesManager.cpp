@@ -1,17 +1,13 @@
 #include "DelayedActivitiesManager.h"
 
-void DelayedActivitiesManager::AddDelayedActivity(std::chrono::microseconds delay, std::function<void()> action) {
-	activities.push_back(Activity{delay, action});
+uf::TimerWheel::Handle DelayedActivitiesManager::AddDelayedActivity(std::chrono::microseconds delay, std::function<void()> action) {
+	return timers.Add(delay, std::move(action));
+}
+
+bool DelayedActivitiesManager::CancelDelayedActivity(uf::TimerWheel::Handle activity) {
+	return timers.Cancel(activity);
 }
 
 void DelayedActivitiesManager::Update(std::chrono::microseconds timeElapsed) {
-	for (auto activity = activities.begin(); activity != activities.end(); ) {
-		activity->delay -= timeElapsed;
-		if (activity->delay < activity->delay.zero()) {
-			activity->action();
-			activity = activities.erase(activity);
-		} else {
-			activity++;
-		}
-	}
+	timers.Advance(timeElapsed);
 }
@@ -3,17 +3,17 @@
 #include <chrono>
 #include <functional>
 
-struct Activity {
-	std::chrono::microseconds delay;
-	std::function<void()> action;
-};
+#include <Shared/TimerWheel.h>
 
+// Owns timers of the game: delayed activities of scripts, animations of objects and so on
 class DelayedActivitiesManager {
 public:
-	void AddDelayedActivity(std::chrono::microseconds delay, std::function<void()> action);
+	uf::TimerWheel::Handle AddDelayedActivity(std::chrono::microseconds delay, std::function<void()> action);
+	// return false if activity is done or cancelled already
+	bool CancelDelayedActivity(uf::TimerWheel::Handle activity);
 
 	virtual void Update(std::chrono::microseconds timeElapsed);
 
-private:
-	std::vector<Activity> activities;
+protected:
+	uf::TimerWheel timers;
 };
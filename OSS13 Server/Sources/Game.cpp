@@ -1,81 +1,149 @@
 #include <Game.h>
 
+#include <algorithm>
+
 #include <plog/Log.h>
 
 #include <SFML/System/Clock.hpp>
 #include <SFML/System/Sleep.hpp>
 
+#include <IServer.h>
+#include <Shared/Profiling/Profiler.h>
 #include <Network/Connection.hpp>
 #include <ScriptEngine/ScriptEngine.h>
 #include <World/World.hpp>
 #include <World/Objects/Control.hpp>
 #include <World/Map.hpp>
 
-using namespace std::chrono_literals;
+namespace {
+
+uint viewThreads(const ServerOptions &options) {
+	if (options.viewThreads)
+		return options.viewThreads;
+	// Network and the game thread need cores too
+	return std::min(std::thread::hardware_concurrency() / 2, 8u);
+}
 
-Game::Game() :
-	active(true)
+// Map is read only while views are built
+struct ReadOnlyMap {
+	explicit ReadOnlyMap(Map *map) : map(map) { map->SetReadOnly(true); }
+	~ReadOnlyMap() { map->SetReadOnly(false); }
+	Map *map;
+};
+
+} // namespace
+
+Game::Game(const ServerOptions &options) :
+	active(true),
+	workersPool(viewThreads(options)),
+	scheduler(options.tickRate, options.tickWaitMode),
+	profiler(scheduler),
+	hitchRecorder(options.hitchThreshold)
 {
 	thread = std::make_unique<std::thread>(&Game::gameProcess, this);
 }
 
 void Game::gameProcess() {
+	uf::Tracer::Get().SetThreadName("game");
+
 	scriptEngine = std::make_unique<ScriptEngine>();
 	world.reset(new World());
+	world->GetMap()->GetAtmos()->SetThreadPool(&workersPool);
 	scriptEngine->FillMap(world->GetMap());
 	world->CreateTestItems();
-	auto lastTime = std::chrono::steady_clock::now();
+	LOGI << "Game is started with " << scheduler.GetTickRate() << " ticks per second, views and atmos are computed by "
+	     << workersPool.GetThreadsCount() + 1 << " threads";
 	while (active) {
-		auto curTime = std::chrono::steady_clock::now();
-		auto timeElapsed = curTime - lastTime;
-		lastTime = curTime;
+		scheduler.WaitForNextTick();
 
 		try {
-			update(std::chrono::duration_cast<std::chrono::microseconds>(timeElapsed));
+			hitchRecorder.BeginTick();
+			// Fixed timestep: late ticks catch up, so game time follows real time
+			update(scheduler.GetPeriod());
+			hitchRecorder.EndTick(countTick());
 		} catch (const std::exception &e) {
 			LOGE << "Main game cycle failed due exception: " << "\n"
 				 << e.what();
 			getchar();
 		}
-
-		auto timeToSleep = 50ms - timeElapsed; // 20 ticks per second
-		if (timeToSleep > timeToSleep.zero())
-			std::this_thread::sleep_for(timeToSleep);
 	}
 }
 
 void Game::update(std::chrono::microseconds timeElapsed) {
-	DelayedActivitiesManager::Update(timeElapsed);
-	world->Update(timeElapsed);
-
 	{
+		PROFILE_SCOPE("tick");
+
+		{
+			PROFILE_SCOPE("tick/delayed-activities");
+			DelayedActivitiesManager::Update(timeElapsed);
+		}
+		{
+			PROFILE_SCOPE("tick/world");
+			world->Update(timeElapsed);
+		}
+
 		std::unique_lock<std::mutex> lock(playersLock);
-		for (auto iter = players.begin(); iter != players.end();) {
-			sptr<Player> player = *iter;
-			if (player->IsConnected()) {
-				player->Update(timeElapsed);
-				iter++;
-			} else {
-				// If player disconnected, move him into disconnectedPlayers list
-				player->Suspend();
-				if (iter == players.begin()) {
-					disconnectedPlayers.splice(disconnectedPlayers.end(), players, iter);
-					iter = players.begin();
+		{
+			PROFILE_SCOPE("tick/players");
+			for (auto iter = players.begin(); iter != players.end();) {
+				sptr<Player> player = *iter;
+				if (player->IsConnected()) {
+					player->Update(timeElapsed);
+					iter++;
 				} else {
-					auto temp = iter;
-					temp--;
-					disconnectedPlayers.splice(disconnectedPlayers.end(), players, iter);
-					iter = temp++;
+					// If player disconnected, move him into disconnectedPlayers list
+					player->Suspend();
+					if (iter == players.begin()) {
+						disconnectedPlayers.splice(disconnectedPlayers.end(), players, iter);
+						iter = players.begin();
+					} else {
+						auto temp = iter;
+						temp--;
+						disconnectedPlayers.splice(disconnectedPlayers.end(), players, iter);
+						iter = temp++;
+					}
 				}
 			}
 		}
 
-		for (wptr<Player> player : players)
-			if (sptr<Player> player_s = player.lock())
-				player_s->SendGraphicsUpdates(timeElapsed);
+		{
+			PROFILE_SCOPE("tick/views");
+			viewers.clear();
+			for (auto &player : players)
+				viewers.push_back(player.get());
+
+			// Camera reads the world and changes only itself and its player's command queue
+			ReadOnlyMap readOnlyMap(world->GetMap());
+			workersPool.ParallelFor(viewers.size(), [this, timeElapsed](size_t i) {
+				viewers[i]->SendGraphicsUpdates(timeElapsed);
+			});
+		}
+		lock.unlock();
+
+		{
+			PROFILE_SCOPE("tick/chat");
+			SendChatMessages();
+		}
+		{
+			PROFILE_SCOPE("tick/flush");
+			GServer->FlushNetwork();
+		}
 	}
 
-	SendChatMessages();
+	profiler.Update();
+}
+
+HitchRecorder::TickCounters Game::countTick() {
+	HitchRecorder::TickCounters counters;
+	{
+		std::unique_lock<std::mutex> lock(playersLock);
+		counters.players = players.size();
+	}
+	counters.objects = world->GetObjectsCount();
+	// Diffs counter is reset at the beginning of the tick
+	counters.diffs = network::protocol::Diff::GetDiffCounter();
+	counters.network = GServer->GetNetworkCounters();
+	return counters;
 }
 
 bool Game::AddPlayer(sptr<Player> &player) {
@@ -99,7 +167,7 @@ bool Game::AddPlayer(sptr<Player> &player) {
 
 Control *Game::GetStartControl(Player *player) {
 	GetScriptEngine()->OnPlayerJoined(player);
-	return dynamic_cast<Control *>(world->CreateNewPlayerCreature()->GetComponent("Control"));
+	return world->CreateNewPlayerCreature()->GetComponent<Control>();
 }
 
 void Game::SendChatMessages() {
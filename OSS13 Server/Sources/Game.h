@@ -5,6 +5,8 @@
 
 #include <SFML/Network/Packet.hpp>
 
+#include <Shared/ThreadPool.h>
+#include <Shared/TickScheduler.h>
 #include <Shared/Types.hpp>
 
 #include <IGame.h>
@@ -12,12 +14,15 @@
 #include <Chat.h>
 
 #include "DelayedActivitiesManager.h"
+#include "ServerOptions.h"
+#include "Profiling/HitchRecorder.h"
+#include "Profiling/TickProfiler.h"
 
 class World;
 
 class Game : public IGame, public DelayedActivitiesManager, public INonCopyable {
 public:
-	Game();
+	explicit Game(const ServerOptions &options);
 
 	// True if new player created, false if exist player reconnected
 	bool AddPlayer(sptr<Player> &);
@@ -28,6 +33,9 @@ public:
 	IScriptEngine *GetScriptEngine() const { return scriptEngine.get(); }
 
 	Chat *GetChat() { return &chat; }
+	TickProfiler *GetProfiler() { return &profiler; }
+	HitchRecorder *GetHitchRecorder() { return &hitchRecorder; }
+	uf::TimerWheel *GetTimers() { return &timers; }
 
 	void SendChatMessages();
 	~Game();
@@ -42,9 +50,17 @@ private:
 	std::list<sptr<Player>> disconnectedPlayers;
 	std::mutex playersLock;
 
+	// Views of different players are independent, so they are built in parallel. Atmos bands too.
+	uf::ThreadPool workersPool;
+	std::vector<Player *> viewers;
+
 	Chat chat;
+	uf::TickScheduler scheduler;
+	TickProfiler profiler;
+	HitchRecorder hitchRecorder;
 
 	void gameProcess();
 
 	void update(std::chrono::microseconds timeElapsed);
+	HitchRecorder::TickCounters countTick();
 };
@@ -1,5 +1,9 @@
+#pragma once
+
 #include <string>
 
 namespace Global {
     const std::string DatabaseName = "UsersDB";
+    // Player with this ckey gets admin verbs
+    const std::string AdminCKey = "admin";
 }
\ No newline at end of file
@@ -1,7 +1,11 @@
 #pragma once
 
+#include <chrono>
+#include <vector>
+
 #include <Shared/Types.hpp>
-#include <Shared/ThreadSafeQueue.hpp>
+#include <Shared/MPSCQueue.hpp>
+#include <Shared/Network/Compression.h>
 #include <Shared/Network/Protocol/ServerToClient/Commands.h>
 
 namespace sf {
@@ -12,7 +16,25 @@ class Player;
 struct ServerCommand;
 
 struct Connection {
-	uptr<sf::TcpSocket> socket;
-	uf::ThreadSafeQueue<network::protocol::Command *> commandsToClient;
+	uf::MPSCQueue<network::protocol::Command *> commandsToClient;
 	sptr<Player> player;
+
+	// Compact wire mode requested by the client
+	bool compactEncoding{false};
+	// Commands of one tick are sent in one frame
+	bool batching{false};
+	// Number of name table entries already sent to the client
+	uint32_t namesSent{0};
+	// Stream compression requested by the client
+	uptr<uf::StreamCompressor> compressor;
+
+	// State of the I/O engine, used only from I/O thread of the connection
+	uptr<sf::TcpSocket> socket; // SelectorEngine
+	int fd{-1}; // EpollEngine
+	// Received bytes of incomplete frame
+	std::vector<char> readBuffer;
+	// Frames which socket hasn't accepted yet, starting from writeOffset
+	std::vector<char> writeBuffer;
+	std::size_t writeOffset{0};
+	std::chrono::steady_clock::time_point lastWriteProgress;
 };
@@ -0,0 +1,323 @@
+#ifdef __linux__
+
+#include "EpollEngine.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <SFML/Network.hpp>
+
+#include <plog/Log.h>
+
+#include <Shared/ErrorHandling.h>
+#include <Shared/Profiling/Tracer.h>
+
+#include "Connection.hpp"
+
+namespace {
+
+constexpr std::size_t FRAME_HEADER_SIZE = 4;
+constexpr std::size_t READ_CHUNK_SIZE = 16 * 1024;
+
+} // namespace
+
+EpollEngine::EpollEngine(IOHandler *handler, uint16_t port, uint threads) :
+	handler(handler), port(port)
+{
+	for (uint i = 0; i < std::max(threads, 1u); i++)
+		workers.push_back(std::make_unique<Worker>());
+}
+
+EpollEngine::~EpollEngine() {
+	Stop();
+}
+
+bool EpollEngine::Start() {
+	if (active) return true;
+
+	listener = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+	EXPECT_WITH_MSG(listener >= 0, std::strerror(errno));
+	int reuse = 1;
+	::setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+	sockaddr_in address{};
+	address.sin_family = AF_INET;
+	address.sin_addr.s_addr = htonl(INADDR_ANY);
+	address.sin_port = htons(port);
+	if (::bind(listener, reinterpret_cast<sockaddr *>(&address), sizeof(address)) < 0 || ::listen(listener, SOMAXCONN) < 0) {
+		LOGE << "Failed to listen port " << port << ": " << std::strerror(errno);
+		::close(listener);
+		listener = -1;
+		return false;
+	}
+
+	active = true;
+	for (auto &worker : workers) {
+		worker->epoll = ::epoll_create1(EPOLL_CLOEXEC);
+		worker->wakeup = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+		EXPECT_WITH_MSG(worker->epoll >= 0 && worker->wakeup >= 0, std::strerror(errno));
+
+		// Listener has null data, wakeup has worker pointer, connections have connection pointer
+		epoll_event event{};
+		event.events = EPOLLIN | EPOLLEXCLUSIVE;
+		event.data.ptr = nullptr;
+		EXPECT(::epoll_ctl(worker->epoll, EPOLL_CTL_ADD, listener, &event) == 0);
+		event.events = EPOLLIN;
+		event.data.ptr = worker.get();
+		EXPECT(::epoll_ctl(worker->epoll, EPOLL_CTL_ADD, worker->wakeup, &event) == 0);
+
+		worker->thread = std::thread(&EpollEngine::working, this, std::ref(*worker));
+	}
+
+	LOGI << "Network is started on port " << port << " with " << workers.size() << " I/O threads";
+	return true;
+}
+
+void EpollEngine::Stop() {
+	if (!active) return;
+	active = false;
+
+	for (auto &worker : workers) {
+		uint64_t value = 1;
+		::write(worker->wakeup, &value, sizeof(value));
+	}
+	for (auto &worker : workers) {
+		worker->thread.join();
+		::close(worker->epoll);
+		::close(worker->wakeup);
+		worker->epoll = worker->wakeup = -1;
+	}
+
+	::close(listener);
+	listener = -1;
+}
+
+void EpollEngine::Send(Connection &connection, const char *data, std::size_t size) {
+	if (connection.fd < 0)
+		return;
+
+	auto &buffer = connection.writeBuffer;
+	if (connection.writeOffset == buffer.size()) {
+		buffer.clear();
+		connection.writeOffset = 0;
+		connection.lastWriteProgress = std::chrono::steady_clock::now();
+	} else if (connection.writeOffset > buffer.size() / 2) {
+		buffer.erase(buffer.begin(), buffer.begin() + connection.writeOffset);
+		connection.writeOffset = 0;
+	}
+	buffer.insert(buffer.end(), data, data + size);
+
+	// Socket error is reported by epoll, connection is closed there
+	if (!write(connection))
+		::shutdown(connection.fd, SHUT_RDWR);
+}
+
+void EpollEngine::Flush() {
+	for (auto &worker : workers) {
+		worker->flushRequested = true;
+		uint64_t value = 1;
+		::write(worker->wakeup, &value, sizeof(value));
+	}
+}
+
+void EpollEngine::working(Worker &worker) {
+	uf::Tracer::Get().SetThreadName("network");
+	epoll_event events[MAX_EVENTS];
+
+	while (active) {
+		int count = ::epoll_wait(worker.epoll, events, MAX_EVENTS, int(TIMEOUT.count()));
+		if (count < 0) {
+			if (errno == EINTR)
+				continue;
+			LOGE << "epoll_wait failed: " << std::strerror(errno);
+			break;
+		}
+
+		for (int i = 0; i < count; i++) {
+			void *ptr = events[i].data.ptr;
+			if (!ptr) {
+				accept(worker);
+				continue;
+			}
+			if (ptr == &worker) {
+				uint64_t value;
+				::read(worker.wakeup, &value, sizeof(value));
+				continue;
+			}
+
+			auto *connection = static_cast<Connection *>(ptr);
+			// Could be closed by previous event of this iteration
+			if (connection->fd < 0)
+				continue;
+
+			uint32_t flags = events[i].events;
+			if (flags & EPOLLERR) {
+				close(worker, *connection, true);
+				continue;
+			}
+			if (flags & (EPOLLIN | EPOLLRDHUP | EPOLLHUP)) {
+				if (!receive(worker, *connection))
+					continue;
+			}
+			if (flags & EPOLLOUT) {
+				if (!write(*connection))
+					close(worker, *connection, true);
+			}
+		}
+
+		const bool flush = worker.flushRequested.exchange(false);
+		const auto now = std::chrono::steady_clock::now();
+		for (auto &[ptr, connection] : worker.connections) {
+			if (connection->fd < 0)
+				continue;
+
+			const std::size_t pending = connection->writeBuffer.size() - connection->writeOffset;
+			if (pending && now - connection->lastWriteProgress > WRITE_STALL_TIMEOUT) {
+				LOGW << "Client doesn't receive data for " << WRITE_STALL_TIMEOUT.count() << " seconds, connection is dropped";
+				close(worker, *connection, false);
+				continue;
+			}
+			// Backpressure: commands wait in the queue until the socket accepts buffered data
+			if (pending < WRITE_HIGH_WATERMARK)
+				handler->OnSendReady(*connection, flush);
+		}
+
+		for (auto &connection : worker.closed)
+			worker.connections.erase(connection.get());
+		worker.closed.clear();
+	}
+
+	for (auto &[ptr, connection] : worker.connections)
+		close(worker, *connection, false);
+	worker.connections.clear();
+	worker.closed.clear();
+}
+
+void EpollEngine::accept(Worker &worker) {
+	while (true) {
+		int fd = ::accept4(listener, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+		if (fd < 0) {
+			if (errno == EINTR)
+				continue;
+			// EAGAIN - no more connections or another worker took it
+			if (errno != EAGAIN && errno != EWOULDBLOCK)
+				LOGE << "New connection accepting error: " << std::strerror(errno);
+			return;
+		}
+
+		// Commands are coalesced by NetworkController, so Nagle only adds latency
+		int noDelay = 1;
+		::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+
+		auto connection = std::make_shared<Connection>();
+		connection->fd = fd;
+
+		epoll_event event{};
+		event.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+		event.data.ptr = connection.get();
+		if (::epoll_ctl(worker.epoll, EPOLL_CTL_ADD, fd, &event) < 0) {
+			LOGE << "Failed to add connection to epoll: " << std::strerror(errno);
+			::close(fd);
+			continue;
+		}
+
+		Connection *key = connection.get();
+		auto &shared = worker.connections[key] = std::move(connection);
+		handler->OnConnect(shared);
+	}
+}
+
+bool EpollEngine::receive(Worker &worker, Connection &connection) {
+	auto &shared = worker.connections.at(&connection);
+	auto &buffer = connection.readBuffer;
+	char chunk[READ_CHUNK_SIZE];
+
+	// Edge-triggered, so socket is read until EAGAIN
+	while (true) {
+		ssize_t received = ::recv(connection.fd, chunk, sizeof(chunk), 0);
+		if (received == 0) {
+			close(worker, connection, true);
+			return false;
+		}
+		if (received < 0) {
+			if (errno == EINTR)
+				continue;
+			if (errno == EAGAIN || errno == EWOULDBLOCK)
+				return true;
+			close(worker, connection, true);
+			return false;
+		}
+
+		buffer.insert(buffer.end(), chunk, chunk + received);
+
+		std::size_t offset = 0;
+		while (buffer.size() - offset >= FRAME_HEADER_SIZE) {
+			auto *header = reinterpret_cast<const uint8_t *>(buffer.data() + offset);
+			std::size_t size = (std::size_t(header[0]) << 24) | (std::size_t(header[1]) << 16) | (std::size_t(header[2]) << 8) | header[3];
+			if (size > MAX_FRAME_SIZE) {
+				LOGW << "Too big frame (" << size << " bytes) is received, connection is dropped";
+				close(worker, connection, false);
+				return false;
+			}
+			if (buffer.size() - offset - FRAME_HEADER_SIZE < size)
+				break;
+
+			bool keep;
+			try {
+				keep = handler->OnPacket(shared, buffer.data() + offset + FRAME_HEADER_SIZE, size);
+			} catch (const std::exception &e) {
+				MANAGE_EXCEPTION_WITH_MSG(e, "Broken packet is received, connection is dropped");
+				keep = false;
+			}
+			if (!keep) {
+				close(worker, connection, false);
+				return false;
+			}
+			offset += FRAME_HEADER_SIZE + size;
+		}
+		buffer.erase(buffer.begin(), buffer.begin() + offset);
+	}
+}
+
+bool EpollEngine::write(Connection &connection) {
+	auto &buffer = connection.writeBuffer;
+	while (connection.writeOffset < buffer.size()) {
+		ssize_t sent = ::send(connection.fd, buffer.data() + connection.writeOffset, buffer.size() - connection.writeOffset, MSG_NOSIGNAL);
+		if (sent < 0) {
+			if (errno == EINTR)
+				continue;
+			// The rest is sent on EPOLLOUT
+			return errno == EAGAIN || errno == EWOULDBLOCK;
+		}
+		connection.writeOffset += std::size_t(sent);
+		connection.lastWriteProgress = std::chrono::steady_clock::now();
+	}
+
+	buffer.clear();
+	connection.writeOffset = 0;
+	return true;
+}
+
+void EpollEngine::close(Worker &worker, Connection &connection, bool lost) {
+	if (connection.fd < 0)
+		return;
+
+	::epoll_ctl(worker.epoll, EPOLL_CTL_DEL, connection.fd, nullptr);
+	::close(connection.fd);
+	connection.fd = -1;
+
+	auto &shared = worker.connections.at(&connection);
+	worker.closed.push_back(shared);
+	handler->OnDisconnect(shared, lost);
+}
+
+#endif // __linux__
@@ -0,0 +1,66 @@
+#pragma once
+
+#ifdef __linux__
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "IOEngine.h"
+
+// Linux engine: non-blocking sockets, edge-triggered epoll, several I/O threads.
+// Every thread has its own epoll instance with the shared listener (EPOLLEXCLUSIVE),
+// so accepted connection stays on the thread which accepted it.
+// Unsent data is kept in connection write buffer. When it's full, commands aren't encoded
+// and wait in the connection queue, so slow client doesn't stall anyone.
+class EpollEngine : public IOEngine {
+public:
+	EpollEngine(IOHandler *handler, uint16_t port, uint threads);
+	~EpollEngine() override;
+
+	bool Start() override;
+	void Stop() override;
+	void Send(Connection &connection, const char *data, std::size_t size) override;
+	void Flush() override;
+
+private:
+	struct Worker {
+		int epoll{-1};
+		// eventfd to wake the worker
+		int wakeup{-1};
+		std::thread thread;
+		std::atomic<bool> flushRequested{false};
+		std::unordered_map<Connection *, sptr<Connection>> connections;
+		// Closed in the current iteration, alive until its end
+		std::vector<sptr<Connection>> closed;
+	};
+
+	void working(Worker &worker);
+	void accept(Worker &worker);
+	// return false if connection is closed
+	bool receive(Worker &worker, Connection &connection);
+	bool write(Connection &connection);
+	void close(Worker &worker, Connection &connection, bool lost);
+
+private:
+	// Poll timeout, also the longest delay of commands for clients without batching
+	const std::chrono::milliseconds TIMEOUT{1};
+	// No new commands are encoded while more bytes are waiting for the socket
+	const std::size_t WRITE_HIGH_WATERMARK = 256 * 1024;
+	// Client which doesn't read anything for so long is disconnected
+	const std::chrono::seconds WRITE_STALL_TIMEOUT{10};
+	// Client frames are small, bigger size means broken or malicious client
+	const std::size_t MAX_FRAME_SIZE = 1024 * 1024;
+	static constexpr int MAX_EVENTS = 256;
+
+	IOHandler *handler;
+	uint16_t port;
+	int listener{-1};
+
+	std::atomic<bool> active{false};
+	std::vector<uptr<Worker>> workers;
+};
+
+#endif // __linux__
@@ -0,0 +1,12 @@
+#include "IOEngine.h"
+
+#include "EpollEngine.h"
+#include "SelectorEngine.h"
+
+uptr<IOEngine> IOEngine::Create(IOHandler *handler, uint16_t port, uint threads) {
+#ifdef __linux__
+	return std::make_unique<EpollEngine>(handler, port, threads);
+#else
+	return std::make_unique<SelectorEngine>(handler, port);
+#endif
+}
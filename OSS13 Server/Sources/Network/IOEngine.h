@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <Shared/Types.hpp>
+
+struct Connection;
+
+// Protocol side of the network, implemented by NetworkController.
+// Every connection is served by one I/O thread, so calls for the same connection never overlap,
+// but calls for different connections can be made from different threads at the same time.
+class IOHandler {
+public:
+	virtual ~IOHandler() = default;
+
+	virtual void OnConnect(sptr<Connection> &connection) = 0;
+	// Called for every received frame. Return false to close the connection.
+	virtual bool OnPacket(sptr<Connection> &connection, const char *data, std::size_t size) = 0;
+	// lost - closed by the client or by network error, not by OnPacket result
+	virtual void OnDisconnect(sptr<Connection> &connection, bool lost) = 0;
+	// Connection can take more data, handler passes queued commands to IOEngine::Send.
+	// flush - game tick is finished, see IOEngine::Flush
+	virtual void OnSendReady(Connection &connection, bool flush) = 0;
+};
+
+// Accepts connections, reads and writes frames (sf::Packet format) on its own threads.
+class IOEngine {
+public:
+	// epoll engine on Linux, sf::SocketSelector engine elsewhere.
+	// threads - number of I/O threads, selector engine always uses one.
+	static uptr<IOEngine> Create(IOHandler *handler, uint16_t port, uint threads);
+
+	virtual ~IOEngine() = default;
+
+	// return false if port can't be listened
+	virtual bool Start() = 0;
+	virtual void Stop() = 0;
+
+	// Queues framed data for sending. Should be called from OnSendReady of the connection.
+	virtual void Send(Connection &connection, const char *data, std::size_t size) = 0;
+	// Wakes I/O threads, OnSendReady will be called with flush = true for every connection
+	virtual void Flush() = 0;
+};
@@ -1,15 +1,19 @@
 #include "NetworkController.hpp"
 
-#include <SFML/Network.hpp>
+#include <algorithm>
+#include <thread>
 
 #include <plog/Log.h>
 
 #include <Shared/Global.hpp>
 #include <Shared/Network/Archive.h>
+#include <Shared/Network/Dispatch.h>
+#include <Shared/Network/Protocol/CompressionDictionary.h>
 #include <Shared/Network/Protocol/InputData.h>
 #include <Shared/Network/Protocol/ServerToClient/Commands.h>
 #include <Shared/Network/Protocol/ClientToServer/Commands.h>
 #include <Shared/ErrorHandling.h>
+#include <Shared/Profiling/Profiler.h>
 
 #include <IServer.h>
 #include <Player.hpp>
@@ -18,192 +22,222 @@
 
 using namespace network::protocol;
 
-void NetworkController::working() {
-    sf::TcpListener listener;
-    listener.listen(Global::PORT);
-
-    sf::SocketSelector selector;
-
-    selector.add(listener);
-
-    while (active) {
-        if (selector.wait(sf::microseconds(TIMEOUT.count()))) {
-            // Receiving from client
-            if (selector.isReady(listener)) {
-                sf::TcpSocket *socket = new sf::TcpSocket;
-                if (listener.accept(*socket) == sf::TcpSocket::Done) {
-                    selector.add(*socket);
-					Connection *new_connection = new Connection();
-					new_connection->socket.reset(socket);
-					connections.push_back(sptr<Connection>(new_connection));
-                } else
-                    LOGE << "New connection accepting error";
-            } else {
-                for (auto iter = connections.begin(); iter != connections.end();) {
-					
-                    if (selector.isReady(*iter->get()->socket)) {
-                        sf::TcpSocket *socket = iter->get()->socket.get();
-                        sptr<Player> player = (*iter)->player;
-
-                        sf::Packet packet;
-                        sf::Socket::Status status = socket->receive(packet);
-                        switch (status) {
-                            case sf::Socket::Done:
-								if (!parsePacket(packet, *iter)) {
-									selector.remove(*socket);
-									iter = connections.erase(iter);
-									continue;
-								}
-                                break;
-                            case sf::Socket::Disconnected:
-								if (player) {
-									LOGI << "Lost client " << player->GetCKey() << " connection";
-								} else
-									LOGI << "Lost unregistered client signal";
-                                selector.remove(*socket);
-                                iter = connections.erase(iter);
-                                continue;
-                                break;
-                        }
-
-                    }
-
-                    iter++;
-                }
-            }
-        }
-
-        // Sending to client
-        for (auto &connection : connections) {
-			while (!connection->commandsToClient.Empty()) {
-				sf::Packet packet;
-				uf::InputArchive ar(packet);
-				network::protocol::Command *command = connection->commandsToClient.Pop();
-				EXPECT(command);
-				ar << *command;
-				delete command;
-				connection->socket->send(packet);
-			}
-        }
-    }
+NetworkController::NetworkController(uint16_t port, uint ioThreads) {
+	if (!ioThreads)
+		ioThreads = std::clamp(std::thread::hardware_concurrency() / 2, 1u, 4u);
+	engine = IOEngine::Create(this, port, ioThreads);
 }
 
-bool NetworkController::parsePacket(sf::Packet &packet, sptr<Connection> &connection) {
-	uf::OutputArchive ar(packet);
-	auto p = ar.UnpackSerializable();
-
-	if (auto *command = dynamic_cast<client::AuthorizationCommand *>(p.get())) {
-		bool secondConnection = false;
-		for (auto &connection : connections) {
-			if (connection->player && connection->player->GetCKey() == command->login) {
-				secondConnection = true;
-				LOGI << "Player " << command->login << " " << command->password << " is trying to authorize second time";
-				break;
-			}
-		}
-
-		if (!secondConnection) {
-			if (Player *player = GServer->Authorization(command->login, command->password)) {
-				player->SetConnection(connection);
-				connection->player = sptr<Player>(player);
-				connection->commandsToClient.Push(new network::protocol::server::AuthorizationSuccessCommand());
-				return true;
-			}
-		}
-		connection->commandsToClient.Push(new network::protocol::server::AuthorizationFailedCommand());
-		return true;
-	}
-
-	if (auto *command = dynamic_cast<client::RegistrationCommand *>(p.get())) {
-		if (GServer->Registration(command->login, command->password))
-			connection->commandsToClient.Push(new network::protocol::server::RegistrationSuccessCommand());
-		else
-			connection->commandsToClient.Push(new network::protocol::server::RegistrationFailedCommand());
-		return true;
-	}
+NetworkController::~NetworkController() {
+	Stop();
+}
 
-	if (auto *command = dynamic_cast<client::JoinGameCommand *>(p.get())) {
-		if (connection->player) {
-			if (GServer->JoinGame(connection->player)) {
-				connection->commandsToClient.Push(new network::protocol::server::GameJoinSuccessCommand());
-			} else {
-				connection->commandsToClient.Push(new network::protocol::server::GameJoinErrorCommand());
-			}
-		}
-		return true;
-	}
+void NetworkController::Start() {
+	ASSERT_WITH_MSG(engine->Start(), "Failed to start network");
+}
 
-	if (auto *command = dynamic_cast<client::MoveCommand *>(p.get())) {
-		if (connection->player)
-			connection->player->Move(uf::Direction(command->direction));
-		return true;
-	}
+void NetworkController::Stop() {
+	engine->Stop();
+}
 
-	if (auto *command = dynamic_cast<client::MoveZCommand *>(p.get())) {
-		if (connection->player)
-			connection->player->MoveZ(command->up);
-		return true;
-	}
+void NetworkController::Flush() {
+	engine->Flush();
+}
 
-	if (auto *command = dynamic_cast<client::ClickObjectCommand *>(p.get())) {
-		if (connection->player)
-			connection->player->ClickObject(command->id);
-		return true;
-	}
+NetworkCounters NetworkController::GetCounters() const {
+	NetworkCounters counters;
+	counters.framesSent = framesSent.load(std::memory_order_relaxed);
+	counters.bytesSent = bytesSent.load(std::memory_order_relaxed);
+	return counters;
+}
 
-	if (auto *command = dynamic_cast<client::SendChatMessageCommand *>(p.get())) {
-		if (connection->player)
-			connection->player->ChatMessage(command->message);
-		return true;
-	}
+void NetworkController::OnConnect(sptr<Connection> &connection) {
+	std::unique_lock<std::mutex> lock(mutex);
+	connections.push_back(connection);
+}
 
-	if (auto *command = dynamic_cast<client::DisconnectionCommand *>(p.get())) {
-		if (connection->player)
-			LOGI << "Client " << connection->player->GetCKey() << " disconnected";
-		return false;
-	}
+bool NetworkController::OnPacket(sptr<Connection> &connection, const char *data, std::size_t size) {
+	PROFILE_SCOPE("network/receive");
+	std::unique_lock<std::mutex> lock(mutex);
+	return parsePacket(data, size, connection);
+}
 
-	if (auto *command = dynamic_cast<client::UIInputCommand *>(p.get())) {
+void NetworkController::OnDisconnect(sptr<Connection> &connection, bool lost) {
+	std::unique_lock<std::mutex> lock(mutex);
+	if (lost) {
 		if (connection->player) {
-			connection->player->UIInput(std::move(command->data));
-		}
-		return true;
+			LOGI << "Lost client " << connection->player->GetCKey() << " connection";
+		} else
+			LOGI << "Lost unregistered client signal";
 	}
+	connections.remove(connection);
+}
 
-	if (auto *command = dynamic_cast<client::UITriggerCommand *>(p.get())) {
-		if (connection->player) {
-			connection->player->UITrigger(command->window, command->trigger);
-		}
-		return true;
-	}
+void NetworkController::OnSendReady(Connection &connection, bool flush) {
+	// Batching clients get all commands of the game tick at once
+	if (!connection.batching || flush)
+		sendCommands(connection);
+}
 
-	if (auto *command = dynamic_cast<client::CallVerbCommand *>(p.get())) {
-		if (connection->player) {
-			connection->player->CallVerb(command->verb);
+void NetworkController::sendCommands(Connection &connection) {
+	if (connection.commandsToClient.Empty())
+		return;
+	PROFILE_SCOPE("network/send");
+
+	auto batch = bufferPool.Acquire();
+	connection.commandsToClient.Drain([&](network::protocol::Command *command) {
+		auto payload = bufferPool.Acquire();
+		uf::InputArchive ar(*payload);
+		if (connection.compactEncoding)
+			ar.SetCompact(&objectNames);
+		EXPECT(command);
+		ar << *command;
+		delete command;
+
+		// Command could intern new names, client should get them first
+		if (connection.compactEncoding)
+			writeNewNames(connection, *batch);
+		batch->Append(payload->GetData(), payload->GetSize());
+
+		if (!connection.batching) {
+			send(connection, *batch);
+			batch->Clear();
 		}
-		return true;
-	}
-
-	if (connection->player)
-		LOGE << "Unknown Command is received from " << connection->player->GetCKey();
-	else
-		LOGE << "Unknown Command is received from unregistered client"; 
+	});
 
-	return true;
+	if (batch->GetSize())
+		send(connection, *batch);
 }
 
-NetworkController::NetworkController() {
-    active = false;
+void NetworkController::writeNewNames(Connection &connection, uf::Buffer &buffer) {
+	server::ObjectNamesCommand command;
+	command.first = connection.namesSent;
+	command.names = objectNames.GetNames(connection.namesSent);
+	if (command.names.empty())
+		return;
+	connection.namesSent += uint32_t(command.names.size());
+
+	uf::InputArchive ar(buffer);
+	ar << command;
 }
 
-void NetworkController::Start() {
-    if (active) return;
-    active = true;
-    thread.reset(new std::thread(&NetworkController::working, this));
+void NetworkController::send(Connection &connection, const uf::Buffer &payload) {
+	auto frame = bufferPool.Acquire();
+	frame->BeginFrame();
+	if (connection.compressor)
+		connection.compressor->Compress(payload.GetData(), payload.GetSize(), *frame);
+	else
+		frame->Append(payload.GetData(), payload.GetSize());
+	frame->EndFrame();
+	// Frame is sf::Packet compatible, so client receives it as usual packet
+	engine->Send(connection, frame->GetData(), frame->GetSize());
+	framesSent.fetch_add(1, std::memory_order_relaxed);
+	bytesSent.fetch_add(frame->GetSize(), std::memory_order_relaxed);
 }
 
-void NetworkController::Stop() {
-    if (!active) return;
-    active = false;
-    thread->join();
-}
\ No newline at end of file
+bool NetworkController::parsePacket(const char *data, std::size_t size, sptr<Connection> &connection) {
+	uf::Buffer buffer(data, size);
+	uf::OutputArchive ar(buffer);
+	auto p = ar.UnpackSerializable();
+
+	bool keepConnection = true;
+
+	bool known = uf::Dispatch<
+		client::ProtocolOptionsCommand, client::AuthorizationCommand, client::RegistrationCommand, client::JoinGameCommand,
+		client::MoveCommand, client::MoveZCommand, client::ClickObjectCommand, client::SendChatMessageCommand,
+		client::DisconnectionCommand, client::UIInputCommand, client::UITriggerCommand, client::CallVerbCommand,
+		client::PingCommand
+	>(*p, uf::Overloaded{
+		[&](client::ProtocolOptionsCommand &command) {
+			connection->compactEncoding = command.compact;
+			connection->batching = command.batching;
+			if (command.compression)
+				connection->compressor = std::make_unique<uf::StreamCompressor>(GetCompressionDictionary(), COMPRESSION_THRESHOLD);
+		},
+		[&](client::AuthorizationCommand &command) {
+			bool secondConnection = false;
+			for (auto &connection : connections) {
+				if (connection->player && connection->player->GetCKey() == command.login) {
+					secondConnection = true;
+					LOGI << "Player " << command.login << " " << command.password << " is trying to authorize second time";
+					break;
+				}
+			}
+
+			if (!secondConnection) {
+				if (Player *player = GServer->Authorization(command.login, command.password)) {
+					player->SetConnection(connection);
+					connection->player = sptr<Player>(player);
+					connection->commandsToClient.Push(new network::protocol::server::AuthorizationSuccessCommand());
+					return;
+				}
+			}
+			connection->commandsToClient.Push(new network::protocol::server::AuthorizationFailedCommand());
+		},
+		[&](client::RegistrationCommand &command) {
+			if (GServer->Registration(command.login, command.password))
+				connection->commandsToClient.Push(new network::protocol::server::RegistrationSuccessCommand());
+			else
+				connection->commandsToClient.Push(new network::protocol::server::RegistrationFailedCommand());
+		},
+		[&](client::JoinGameCommand &) {
+			if (connection->player) {
+				if (GServer->JoinGame(connection->player)) {
+					connection->commandsToClient.Push(new network::protocol::server::GameJoinSuccessCommand());
+				} else {
+					connection->commandsToClient.Push(new network::protocol::server::GameJoinErrorCommand());
+				}
+			}
+		},
+		[&](client::MoveCommand &command) {
+			if (connection->player)
+				connection->player->Move(uf::Direction(command.direction));
+		},
+		[&](client::MoveZCommand &command) {
+			if (connection->player)
+				connection->player->MoveZ(command.up);
+		},
+		[&](client::ClickObjectCommand &command) {
+			if (connection->player)
+				connection->player->ClickObject(command.id);
+		},
+		[&](client::SendChatMessageCommand &command) {
+			if (connection->player)
+				connection->player->ChatMessage(command.message);
+		},
+		[&](client::DisconnectionCommand &) {
+			if (connection->player)
+				LOGI << "Client " << connection->player->GetCKey() << " disconnected";
+			keepConnection = false;
+		},
+		[&](client::UIInputCommand &command) {
+			if (connection->player) {
+				connection->player->UIInput(std::move(command.data));
+			}
+		},
+		[&](client::UITriggerCommand &command) {
+			if (connection->player) {
+				connection->player->UITrigger(command.window, command.trigger);
+			}
+		},
+		[&](client::CallVerbCommand &command) {
+			if (connection->player) {
+				connection->player->CallVerb(command.verb);
+			}
+		},
+		[&](client::PingCommand &command) {
+			auto *pong = new server::PongCommand();
+			pong->id = command.id;
+			connection->commandsToClient.Push(pong);
+		}
+	});
+
+	if (!known) {
+		if (connection->player)
+			LOGE << "Unknown Command is received from " << connection->player->GetCKey();
+		else
+			LOGE << "Unknown Command is received from unregistered client";
+	}
+
+	return keepConnection;
+}
@@ -1,30 +1,60 @@
 #pragma once
 
+#include <atomic>
 #include <list>
-#include <thread>
-#include <chrono>
-
-#include <SFML/Network.hpp>
+#include <mutex>
 
 #include <Shared/Types.hpp>
+#include <Shared/Global.hpp>
+#include <Shared/Network/Buffer.h>
+#include <Shared/Network/NameTable.h>
+
+#include <IServer.h>
+
+#include "IOEngine.h"
 
 struct Connection;
 
-class NetworkController {
+class NetworkController : private IOHandler {
 private:
-	const std::chrono::microseconds TIMEOUT{100};
+	// Smaller packets are sent uncompressed
+	const size_t COMPRESSION_THRESHOLD = 128;
 
-    bool active;
-    uptr<std::thread> thread;
+	uptr<IOEngine> engine;
+	// Guards connections list and command handlers, so handlers work as before with one network thread
+	std::mutex mutex;
 	std::list< sptr<Connection> > connections;
+	uf::BufferPool bufferPool;
+	// Names interned by compact encoding, common for all connections
+	uf::NameTable objectNames;
+	std::atomic<uint64_t> framesSent{0};
+	std::atomic<uint64_t> bytesSent{0};
+
+// IOHandler
+	void OnConnect(sptr<Connection> &connection) override;
+	bool OnPacket(sptr<Connection> &connection, const char *data, std::size_t size) override;
+	void OnDisconnect(sptr<Connection> &connection, bool lost) override;
+	void OnSendReady(Connection &connection, bool flush) override;
 
-    void working();
 	// return false if received "disconnect" packet
-    bool parsePacket(sf::Packet &, sptr<Connection> &connection);
+	bool parsePacket(const char *data, std::size_t size, sptr<Connection> &connection);
+	// Sends queued commands, one frame per command or one for all of them if the client batches
+	void sendCommands(Connection &connection);
+	// Writes names which the client doesn't know yet
+	void writeNewNames(Connection &connection, uf::Buffer &buffer);
+	// Frames payload and compresses it if the client asked
+	void send(Connection &connection, const uf::Buffer &payload);
 
 public:
-    NetworkController();
+	// ioThreads - number of I/O threads, 0 means choose by hardware concurrency
+	explicit NetworkController(uint16_t port = Global::PORT, uint ioThreads = 0);
+	~NetworkController();
+
+	void Start();
+	void Stop();
+
+	// Called by game at the end of tick, batched commands of the tick are sent to clients
+	void Flush();
 
-    void Start();
-    void Stop();
+	NetworkCounters GetCounters() const;
 };
@@ -0,0 +1,107 @@
+#include "SelectorEngine.h"
+
+#include <SFML/Network.hpp>
+
+#include <plog/Log.h>
+
+#include <Shared/Profiling/Tracer.h>
+
+#include "Connection.hpp"
+
+SelectorEngine::SelectorEngine(IOHandler *handler, uint16_t port) :
+	handler(handler), port(port)
+{ }
+
+SelectorEngine::~SelectorEngine() {
+	Stop();
+}
+
+bool SelectorEngine::Start() {
+	if (active) return true;
+	active = true;
+	thread.reset(new std::thread(&SelectorEngine::working, this));
+	return true;
+}
+
+void SelectorEngine::Stop() {
+	if (!active) return;
+	active = false;
+	thread->join();
+}
+
+void SelectorEngine::Send(Connection &connection, const char *data, std::size_t size) {
+	connection.socket->send(data, size);
+}
+
+void SelectorEngine::Flush() {
+	flushRequested = true;
+}
+
+void SelectorEngine::working() {
+	uf::Tracer::Get().SetThreadName("network");
+
+	sf::TcpListener listener;
+	if (listener.listen(port) != sf::Socket::Done)
+		LOGE << "Failed to listen port " << port;
+
+	sf::SocketSelector selector;
+
+	selector.add(listener);
+
+	while (active) {
+		if (selector.wait(sf::microseconds(TIMEOUT.count()))) {
+			// Receiving from client
+			if (selector.isReady(listener)) {
+				sf::TcpSocket *socket = new sf::TcpSocket;
+				if (listener.accept(*socket) == sf::TcpSocket::Done) {
+					selector.add(*socket);
+					auto connection = std::make_shared<Connection>();
+					connection->socket.reset(socket);
+					connections.push_back(connection);
+					handler->OnConnect(connection);
+				} else {
+					LOGE << "New connection accepting error";
+					delete socket;
+				}
+			} else {
+				for (auto iter = connections.begin(); iter != connections.end();) {
+					sf::TcpSocket *socket = (*iter)->socket.get();
+					if (selector.isReady(*socket)) {
+						sf::Packet packet;
+						sf::Socket::Status status = socket->receive(packet);
+						bool keep = true;
+						bool lost = false;
+						switch (status) {
+							case sf::Socket::Done:
+								keep = handler->OnPacket(*iter, reinterpret_cast<const char *>(packet.getData()), packet.getDataSize());
+								break;
+							case sf::Socket::Disconnected:
+							case sf::Socket::Error:
+								keep = false;
+								lost = true;
+								break;
+							default:
+								break;
+						}
+						if (!keep) {
+							handler->OnDisconnect(*iter, lost);
+							selector.remove(*socket);
+							iter = connections.erase(iter);
+							continue;
+						}
+					}
+					iter++;
+				}
+			}
+		}
+
+		// Sending to client
+		const bool flush = flushRequested.exchange(false);
+		for (auto &connection : connections)
+			handler->OnSendReady(*connection, flush);
+	}
+
+	for (auto &connection : connections)
+		handler->OnDisconnect(connection, false);
+	connections.clear();
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <list>
+#include <thread>
+
+#include "IOEngine.h"
+
+// Portable engine: one thread waiting on sf::SocketSelector, blocking sends.
+class SelectorEngine : public IOEngine {
+public:
+	SelectorEngine(IOHandler *handler, uint16_t port);
+	~SelectorEngine() override;
+
+	bool Start() override;
+	void Stop() override;
+	void Send(Connection &connection, const char *data, std::size_t size) override;
+	void Flush() override;
+
+private:
+	void working();
+
+private:
+	const std::chrono::microseconds TIMEOUT{100};
+
+	IOHandler *handler;
+	uint16_t port;
+
+	std::atomic<bool> active{false};
+	std::atomic<bool> flushRequested{false};
+	uptr<std::thread> thread;
+	std::list<sptr<Connection>> connections;
+};
@@ -4,6 +4,7 @@
 
 #include <plog/Log.h>
 
+#include <Global.hpp>
 #include <IGame.h>
 #include <Chat.h>
 #include <Network/Connection.hpp>
@@ -12,6 +13,7 @@
 #include <World/Objects.hpp>
 #include <World/Map.hpp>
 #include <ClientUI/WelcomeWindowSink.h>
+#include <Profiling/TickProfiler.h>
 
 #include <Shared/ErrorHandling.h>
 
@@ -78,8 +80,8 @@ void Player::updateUISinks(std::chrono::microseconds timeElapsed) {
 }
 
 void Player::Update(std::chrono::microseconds timeElapsed) {
-    while (!actions.Empty()) {
-        PlayerCommand *temp = actions.Pop();
+    PlayerCommand *temp;
+    while (actions.TryPop(temp)) {
         if (temp) {
             switch (temp->GetCode()) {
                 case PlayerCommand::Code::JOIN: {
@@ -87,6 +89,8 @@ void Player::Update(std::chrono::microseconds timeElapsed) {
 					verbsHolders["player"] = this;
 					verbsHolders["atmos"] = GetControl()->GetOwner()->GetTile()->GetMap()->GetAtmos();
 					verbsHolders["creature"] = GetControl()->GetOwner();
+					if (ckey == Global::AdminCKey)
+						verbsHolders["profiler"] = GGame->GetProfiler();
                     break;
                 }
 				case PlayerCommand::Code::MOVE: {
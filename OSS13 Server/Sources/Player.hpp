@@ -7,7 +7,7 @@
 #include <World/Camera/Camera.hpp>
 
 #include <Shared/Types.hpp>
-#include <Shared/ThreadSafeQueue.hpp>
+#include <Shared/MPSCQueue.hpp>
 #include <Shared/Network/Protocol/InputData.h>
 #include <Shared/Network/Protocol/Command.h>
 
@@ -76,7 +76,7 @@ private:
 	uptr<Camera> camera;
 
 	wptr<Connection> connection;
-	uf::ThreadSafeQueue<PlayerCommand *> actions;
+	uf::MPSCQueue<PlayerCommand *> actions;
 
 	bool atmosOverlayToggled;
 
@@ -0,0 +1,171 @@
+#include "HitchRecorder.h"
+
+#include <algorithm>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#include <plog/Log.h>
+
+#include <Player.hpp>
+#include <World/Tile.hpp>
+#include <World/Camera/Camera.hpp>
+
+namespace {
+
+const std::string OBJECTS_SECTIONS_PREFIX = "tick/world/objects/";
+const size_t TOP_SECTIONS = 15;
+const size_t TOP_OBJECT_TYPES = 10;
+
+std::string formatMilliseconds(std::chrono::nanoseconds duration) {
+	std::ostringstream stream;
+	stream << std::fixed << std::setprecision(2) << double(duration.count()) / 1e6;
+	return stream.str();
+}
+
+} // namespace
+
+HitchRecorder::HitchRecorder(std::chrono::milliseconds threshold) :
+	threshold(threshold),
+	ring(RING_SIZE)
+{ }
+
+HitchRecorder::~HitchRecorder() {
+	if (writer.joinable())
+		writer.join();
+}
+
+void HitchRecorder::BeginTick() {
+	tickStart = Clock::now();
+	std::unique_lock<std::mutex> lock(camerasMutex);
+	cameras.clear();
+}
+
+void HitchRecorder::EndTick(const TickCounters &counters) {
+	const auto now = Clock::now();
+
+	auto &record = ring[ticks % RING_SIZE];
+	record.number = ticks++;
+	record.duration = now - tickStart;
+	record.counters = counters;
+	record.framesSent = counters.network.framesSent - lastNetwork.framesSent;
+	record.bytesSent = counters.network.bytesSent - lastNetwork.bytesSent;
+	lastNetwork = counters.network;
+	collectSections(record);
+	{
+		std::unique_lock<std::mutex> lock(camerasMutex);
+		record.cameras.swap(cameras);
+	}
+
+	if (record.duration <= threshold)
+		return;
+	if (lastReport != Clock::time_point() && now - lastReport < REPORT_COOLDOWN)
+		return;
+	lastReport = now;
+
+	std::string path = "Hitch-" + std::to_string(std::time(nullptr)) + "-" + std::to_string(record.number) + ".txt";
+	LOGW << "Tick " << record.number << " took " << formatMilliseconds(record.duration) << " ms, report is written to " << path;
+
+	// Writing takes a while, game shouldn't wait for it
+	if (writer.joinable())
+		writer.join();
+	writer = std::thread(&HitchRecorder::writeReport, path, threshold, freeze());
+}
+
+void HitchRecorder::RecordCamera(const Camera &camera, std::chrono::nanoseconds duration) {
+	std::unique_lock<std::mutex> lock(camerasMutex);
+	if (cameras.size() == CAMERAS_PER_TICK) {
+		auto fastest = std::min_element(cameras.begin(), cameras.end(),
+			[](const CameraTime &a, const CameraTime &b) { return a.time < b.time; });
+		if (fastest->time >= duration)
+			return;
+		cameras.erase(fastest);
+	}
+
+	CameraTime cameraTime;
+	cameraTime.owner = camera.GetPlayer() ? camera.GetPlayer()->GetCKey() : "nobody";
+	cameraTime.position = camera.GetPosition() ? camera.GetPosition()->GetPos() : uf::vec3i();
+	cameraTime.time = duration;
+	cameras.push_back(std::move(cameraTime));
+}
+
+void HitchRecorder::collectSections(TickRecord &record) {
+	record.sections.clear();
+	for (auto *section : uf::Profiler::Get().Sections()) {
+		auto &last = lastTotals[section];
+		SectionTotals current{section->histogram.Count(), section->histogram.Sum()};
+		// Profiler could be reset by admin
+		if (current.calls < last.calls)
+			last = SectionTotals();
+		if (current.calls != last.calls)
+			record.sections.push_back({&section->name, current.calls - last.calls, current.time - last.time});
+		last = current;
+	}
+}
+
+std::vector<HitchRecorder::TickRecord> HitchRecorder::freeze() const {
+	std::vector<TickRecord> result;
+	const size_t count = std::min<uint64_t>(ticks, RING_SIZE);
+	result.reserve(count);
+	for (uint64_t number = ticks - count; number < ticks; number++)
+		result.push_back(ring[number % RING_SIZE]);
+	return result;
+}
+
+void HitchRecorder::writeReport(const std::string &path, std::chrono::milliseconds threshold, std::vector<TickRecord> ticks) {
+	std::ofstream file(path);
+	if (!file) {
+		LOGE << "Failed to open " << path;
+		return;
+	}
+
+	auto &hitch = ticks.back();
+	file << "Tick " << hitch.number << " took " << formatMilliseconds(hitch.duration) << " ms, threshold is " << threshold.count() << " ms\n"
+	     << "Players " << hitch.counters.players << ", objects " << hitch.counters.objects << ", diffs " << hitch.counters.diffs
+	     << ", previous flush sent " << hitch.framesSent << " frames (" << hitch.bytesSent << " bytes)\n\n";
+
+	std::vector<SectionTime> sections, objectTypes;
+	for (auto &section : hitch.sections) {
+		if (section.name->compare(0, OBJECTS_SECTIONS_PREFIX.size(), OBJECTS_SECTIONS_PREFIX) == 0)
+			objectTypes.push_back(section);
+		else
+			sections.push_back(section);
+	}
+	auto slowestFirst = [](const SectionTime &a, const SectionTime &b) { return a.time > b.time; };
+	std::sort(sections.begin(), sections.end(), slowestFirst);
+	std::sort(objectTypes.begin(), objectTypes.end(), slowestFirst);
+
+	file << "Slowest sections:\n";
+	for (size_t i = 0; i < std::min(sections.size(), TOP_SECTIONS); i++)
+		file << "    " << std::left << std::setw(40) << *sections[i].name << std::right
+		     << std::setw(10) << formatMilliseconds(sections[i].time) << " ms" << std::setw(8) << sections[i].calls << " calls\n";
+
+	file << "\nSlowest Python object types:\n";
+	for (size_t i = 0; i < std::min(objectTypes.size(), TOP_OBJECT_TYPES); i++)
+		file << "    " << std::left << std::setw(40) << objectTypes[i].name->substr(OBJECTS_SECTIONS_PREFIX.size()) << std::right
+		     << std::setw(10) << formatMilliseconds(objectTypes[i].time) << " ms" << std::setw(8) << objectTypes[i].calls << " objects\n";
+
+	file << "\nSlowest cameras:\n";
+	std::sort(hitch.cameras.begin(), hitch.cameras.end(), [](const CameraTime &a, const CameraTime &b) { return a.time > b.time; });
+	for (auto &camera : hitch.cameras)
+		file << "    " << std::left << std::setw(20) << camera.owner << std::right
+		     << " at (" << camera.position.x << ", " << camera.position.y << ", " << camera.position.z << ")"
+		     << std::setw(10) << formatMilliseconds(camera.time) << " ms\n";
+
+	file << "\nRecent ticks:\n"
+	     << std::setw(10) << "tick" << std::setw(12) << "ms" << std::setw(10) << "players" << std::setw(10) << "objects"
+	     << std::setw(10) << "diffs" << std::setw(10) << "frames" << std::setw(12) << "bytes" << "  slowest phase\n";
+	for (auto &tick : ticks) {
+		const SectionTime *slowest = nullptr;
+		for (auto &section : tick.sections) {
+			// "tick" itself is the whole duration
+			if (*section.name != "tick" && section.name->compare(0, 5, "tick/") == 0 && (!slowest || section.time > slowest->time))
+				slowest = &section;
+		}
+		file << std::setw(10) << tick.number << std::setw(12) << formatMilliseconds(tick.duration)
+		     << std::setw(10) << tick.counters.players << std::setw(10) << tick.counters.objects << std::setw(10) << tick.counters.diffs
+		     << std::setw(10) << tick.framesSent << std::setw(12) << tick.bytesSent
+		     << "  " << (slowest ? *slowest->name + " " + formatMilliseconds(slowest->time) + " ms" : "") << "\n";
+	}
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <Shared/Profiling/Profiler.h>
+#include <Shared/Types.hpp>
+
+#include <IServer.h>
+
+class Camera;
+
+// Flight recorder of the game loop. Always keeps the last ticks: time of every profiler section,
+// objects, players, diffs and sent bytes. When a tick is longer than the threshold, the recorded
+// ticks are written to Hitch-<time>.txt with the slowest sections, Python object types and cameras of the hitch.
+class HitchRecorder {
+public:
+	using Clock = std::chrono::steady_clock;
+
+	// Everything what is counted by the game, not by the recorder
+	struct TickCounters {
+		size_t players{0};
+		size_t objects{0};
+		size_t diffs{0};
+		NetworkCounters network;
+	};
+
+	explicit HitchRecorder(std::chrono::milliseconds threshold);
+	~HitchRecorder();
+
+	void BeginTick();
+	void EndTick(const TickCounters &counters);
+
+	// Called by every camera view update, keeps the slowest ones of the tick
+	void RecordCamera(const Camera &camera, std::chrono::nanoseconds duration);
+
+	std::chrono::milliseconds GetThreshold() const { return threshold; }
+
+private:
+	struct SectionTime {
+		const std::string *name;
+		uint64_t calls;
+		std::chrono::nanoseconds time;
+	};
+
+	struct CameraTime {
+		std::string owner;
+		uf::vec3i position;
+		std::chrono::nanoseconds time;
+	};
+
+	struct TickRecord {
+		uint64_t number{0};
+		std::chrono::nanoseconds duration{0};
+		TickCounters counters;
+		// Sent by the previous tick flush
+		uint64_t framesSent{0};
+		uint64_t bytesSent{0};
+		// Sections which were called during the tick
+		std::vector<SectionTime> sections;
+		std::vector<CameraTime> cameras;
+	};
+
+	struct SectionTotals {
+		uint64_t calls{0};
+		std::chrono::nanoseconds time{0};
+	};
+
+	void collectSections(TickRecord &record);
+	// Oldest tick first
+	std::vector<TickRecord> freeze() const;
+	static void writeReport(const std::string &path, std::chrono::milliseconds threshold, std::vector<TickRecord> ticks);
+
+private:
+	// 10 seconds of 20 ticks per second
+	static constexpr size_t RING_SIZE = 200;
+	static constexpr size_t CAMERAS_PER_TICK = 5;
+	// Long ticks in a row produce one report
+	const std::chrono::seconds REPORT_COOLDOWN{10};
+
+	const std::chrono::milliseconds threshold;
+
+	// Records are reused to keep capacity of their vectors
+	std::vector<TickRecord> ring;
+	uint64_t ticks{0};
+	Clock::time_point tickStart;
+	NetworkCounters lastNetwork;
+	std::unordered_map<const uf::ProfilerSection *, SectionTotals> lastTotals;
+
+	// Views could be updated by several threads
+	std::mutex camerasMutex;
+	std::vector<CameraTime> cameras;
+
+	Clock::time_point lastReport;
+	std::thread writer;
+};
@@ -0,0 +1,87 @@
+#include "TickProfiler.h"
+
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#include <plog/Log.h>
+
+#include <Player.hpp>
+#include <Shared/Network/Protocol/ServerToClient/Commands.h>
+
+TickProfiler::TickProfiler(const uf::TickScheduler &scheduler) :
+	scheduler(scheduler),
+	lastDump(std::chrono::steady_clock::now())
+{
+	AddVerb("stats", [this](Player *player) { sendToPlayer(player, GetStats()); });
+	AddVerb("interval", [this](Player *player) { sendToPlayer(player, GetIntervalStats()); });
+	AddVerb("reset", [this](Player *player) {
+		uf::Profiler::Get().Reset();
+		lastSnapshot.clear();
+		lastSchedulerStats = this->scheduler.GetStats();
+		sendToPlayer(player, "Profiler stats are reset");
+	});
+	AddVerb("trace", [this](Player *player) { toggleTracing(player); });
+}
+
+void TickProfiler::Update() {
+	auto now = std::chrono::steady_clock::now();
+	if (now - lastDump < DUMP_PERIOD)
+		return;
+	lastDump = now;
+
+	auto snapshot = uf::Profiler::Get().Snapshot();
+	auto schedulerStats = scheduler.GetStats();
+	std::ofstream file(LOG_FILE, std::ios::app);
+	if (file) {
+		std::time_t time = std::time(nullptr);
+		file << "=== " << std::asctime(std::localtime(&time))
+		     << schedulerReport(schedulerStats - lastSchedulerStats)
+		     << uf::Profiler::Report(snapshot, &lastSnapshot) << std::endl;
+	} else
+		LOGE << "Failed to open " << LOG_FILE;
+	lastSnapshot = std::move(snapshot);
+	lastSchedulerStats = std::move(schedulerStats);
+}
+
+std::string TickProfiler::GetStats() const {
+	return schedulerReport(scheduler.GetStats()) + uf::Profiler::Report(uf::Profiler::Get().Snapshot());
+}
+
+std::string TickProfiler::GetIntervalStats() const {
+	return schedulerReport(scheduler.GetStats() - lastSchedulerStats) + uf::Profiler::Report(uf::Profiler::Get().Snapshot(), &lastSnapshot);
+}
+
+std::string TickProfiler::schedulerReport(const uf::TickSchedulerStats &stats) const {
+	auto microseconds = [](std::chrono::nanoseconds duration) { return std::to_string(duration.count() / 1000); };
+	std::ostringstream report;
+	report << std::fixed << std::setprecision(2)
+	       << "Tick rate " << stats.TickRate() << " of " << scheduler.GetTickRate() << ", "
+	       << stats.lateTicks << " late ticks, " << stats.droppedTicks << " dropped\n"
+	       << "Tick start jitter: p50 " << microseconds(stats.jitter.Percentile(0.5))
+	       << " us, p99 " << microseconds(stats.jitter.Percentile(0.99))
+	       << " us, max " << microseconds(stats.jitter.Max()) << " us\n";
+	return report.str();
+}
+
+void TickProfiler::toggleTracing(Player *player) {
+	auto &tracer = uf::Tracer::Get();
+	if (!tracer.IsEnabled()) {
+		tracer.Start();
+		sendToPlayer(player, "Tracing is started");
+		return;
+	}
+
+	std::string path = "Trace-" + std::to_string(std::time(nullptr)) + ".json";
+	if (tracer.Stop(path))
+		sendToPlayer(player, "Trace is written to " + path);
+	else
+		sendToPlayer(player, "Failed to write trace to " + path);
+}
+
+void TickProfiler::sendToPlayer(Player *player, const std::string &text) {
+	auto command = std::make_unique<network::protocol::server::AddChatMessageCommand>();
+	command->message = text;
+	player->AddCommandToClient(command.release());
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+
+#include <Shared/Profiling/Profiler.h>
+#include <Shared/TickScheduler.h>
+
+#include <VerbsHolder.h>
+
+// Server side of uf::Profiler: periodic dump to the log file and admin verbs
+// ("profiler.stats", "profiler.interval", "profiler.reset").
+// "profiler.trace" starts uf::Tracer, the second call writes the trace to Trace-<time>.json.
+class TickProfiler : public VerbsHolder {
+public:
+	explicit TickProfiler(const uf::TickScheduler &scheduler);
+
+	// Called by the game every tick, writes the stats of the last period to the log file
+	void Update();
+
+	// Stats since start or reset
+	std::string GetStats() const;
+	// Stats since the last dump
+	std::string GetIntervalStats() const;
+
+private:
+	// Achieved tick rate and jitter
+	std::string schedulerReport(const uf::TickSchedulerStats &stats) const;
+	void toggleTracing(Player *player);
+	void sendToPlayer(Player *player, const std::string &text);
+
+private:
+	const std::chrono::minutes DUMP_PERIOD{1};
+	const char *LOG_FILE = "Profiler.log";
+
+	const uf::TickScheduler &scheduler;
+
+	std::chrono::steady_clock::time_point lastDump;
+	uf::ProfilerSnapshot lastSnapshot;
+	uf::TickSchedulerStats lastSchedulerStats;
+};
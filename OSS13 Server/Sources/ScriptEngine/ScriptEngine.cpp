@@ -123,7 +123,7 @@ PYBIND11_EMBEDDED_MODULE(Engine, m) {
 		.def_property("sprite", &Object::GetSprite, &Object::SetSprite)
 		.def_property("layer", &Object::GetLayer, &Object::SetLayer)
 		.def_property("density", &Object::GetDensity, &Object::SetDensity)
-		.def_property("solidity", &Object::GetSolidity, &Object::SetSolidity)
+		.def_property("solidity", [](const Object &obj) { return obj.GetSolidity(); }, &Object::SetSolidity) // copy, tile tracks changes through the setter
 		.def_property("opacity", &Object::GetOpacity, &Object::SetOpacity)
 		.def_property("airtightness", &Object::GetAirtightness, &Object::SetAirtightness)
 		.def_property("invisibility", &Object::GetInvisibility, &Object::SetInvisibility)
@@ -135,12 +135,14 @@ PYBIND11_EMBEDDED_MODULE(Engine, m) {
 		.def_property("isWall", &Object::IsWall, &Object::SetIsWall)
 		.def("AddVerb", &Object::AddVerb)
 		.def("Update", &Object::Update)
+		.def("Wake", &Object::Wake)
+		.def_property_readonly("awake", &Object::IsAwake)
 		.def("InteractedBy", &Object::InteractedBy)
 		.def("IsCloseTo", &Object::IsCloseTo)
 		.def("Move", &Object::Move)
 		.def("MoveZ", &Object::MoveZ)
 		.def("AddComponent", (void (Object::*)(const std::string &)) &Object::AddComponent)
-		.def("GetComponent", (Component *(Object::*)(const std::string &)) &Object::GetComponent)
+		.def("GetComponent", (Component *(Object::*)(const std::string &)) &Object::GetComponent, py::return_value_policy::reference) // owned by ComponentRegistry
 		.def("AddObject", &Object::AddObject)
 		.def("RemoveObject", &Object::RemoveObject, py::return_value_policy::reference)
 		.def("SetSpriteState", &Object::SetSpriteState)
@@ -181,8 +183,11 @@ PYBIND11_EMBEDDED_MODULE(Engine, m) {
 		.def("GetAndDropMoveZOrder", &Control::GetAndDropMoveZOrder)
 		.def("GetAndDropClickedObject", &Control::GetAndDropClickedObject, py::return_value_policy::reference);
 
+	py::class_<uf::TimerWheel::Handle>(m, "DelayedActivity");
+
 	py::class_<Game>(m, "Game")
-		.def("AddDelayedActivity", &Game::AddDelayedActivity);
+		.def("AddDelayedActivity", &Game::AddDelayedActivity)
+		.def("CancelDelayedActivity", &Game::CancelDelayedActivity);
 
 	py::class_<IconInfo>(m, "Icon");
 
@@ -3,6 +3,8 @@
 #include <pybind11/pytypes.h>
 #include <pybind11/chrono.h>
 
+#include <Shared/Profiling/Profiler.h>
+
 #include <IGame.h>
 #include <World/World.hpp>
 #include <World/Objects/Object.hpp>
@@ -14,6 +16,13 @@ namespace script_engine {
 class PyObject : public Object, public std::enable_shared_from_this<PyObject> {
 public:
 	void Update(std::chrono::microseconds timeElapsed) override {
+		// Every Python class has its own section
+		if (!updateSection) {
+			std::string type = pyImpl ? Py_TYPE(pyImpl.ptr())->tp_name : "Object";
+			updateSection = &uf::Profiler::Get().Section("tick/world/objects/" + type);
+		}
+		uf::ScopedTimer timer(*updateSection);
+
 		Object::Update(timeElapsed);
 		PYBIND11_OVERLOAD_PURE_NAME(void, Object, "Update", Update, timeElapsed);
 	}
@@ -45,6 +54,7 @@ public:
 
 private:
 	py::object pyImpl;
+	uf::ProfilerSection *updateSection{nullptr};
 };
 
 } // namespace script_engine
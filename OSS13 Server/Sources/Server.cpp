@@ -1,5 +1,6 @@
 #include "Server.hpp"
 
+#include <algorithm>
 #include <iostream>
 #include <list>
 #include <mutex>
@@ -21,24 +22,31 @@
 
 #include <Shared/ErrorHandling.h>
 
+#include <Benchmarks/Benchmarks.h>
+
 #include "Game.h"
 
 using namespace std;
 using namespace sf;
 
-Server::Server() :
-	networkController(std::make_unique<NetworkController>()),
+Server::Server(const ServerOptions &options) :
+	networkController(std::make_unique<NetworkController>(Global::PORT, options.ioThreads)),
 	rm(std::make_unique<ResourceManager>()),
-	udb(std::make_unique<UsersDB>())
+	udb(std::make_unique<UsersDB>()),
+	options(options)
 {
 	GServer = this;
 
-	plog::ConsoleAppender<plog::MessageOnlyFormatter> appender;
+	// plog keeps pointer to appender, so it must outlive the constructor
+	static plog::ConsoleAppender<plog::MessageOnlyFormatter> appender;
 	plog::init(plog::verbose, &appender);
 
 	ASSERT_WITH_MSG(rm->Initialize(), "Failed to Initialize ResourceManager!");
+}
+
+void Server::Run() {
 	networkController->Start();
-	game = std::make_unique<Game>();
+	game = std::make_unique<Game>(options);
 	GGame = game.get();
 	while (true) {
 		sleep(seconds(1));
@@ -67,13 +75,41 @@ bool Server::JoinGame(sptr<Player> &player) const {
 	return game->AddPlayer(player);
 }
 
+void Server::FlushNetwork() const {
+	networkController->Flush();
+}
+
+NetworkCounters Server::GetNetworkCounters() const {
+	return networkController->GetCounters();
+}
+
 ResourceManager *Server::GetRM() const { return rm.get(); }
 
 ResourceManager *IServer::RM() { EXPECT(GServer); return static_cast<Server *>(GServer)->GetRM(); }
 
-int main() {
-	Server server;
+int main(int argc, char *argv[]) {
+	ServerOptions options;
+	for (int i = 1; i + 1 < argc; i++) {
+		if (std::string(argv[i]) == "--io-threads")
+			options.ioThreads = uint(std::stoul(argv[i + 1]));
+		if (std::string(argv[i]) == "--view-threads")
+			options.viewThreads = uint(std::stoul(argv[i + 1]));
+		if (std::string(argv[i]) == "--tick-rate")
+			options.tickRate = std::max(1u, uint(std::stoul(argv[i + 1])));
+		if (std::string(argv[i]) == "--tick-wait")
+			options.tickWaitMode = std::string(argv[i + 1]) == "sleep" ? uf::TickWaitMode::SLEEP : uf::TickWaitMode::HYBRID;
+		if (std::string(argv[i]) == "--hitch-threshold")
+			options.hitchThreshold = std::chrono::milliseconds(std::stoul(argv[i + 1]));
+	}
+
+	Server server(options);
+
+	if (argc >= 2 && std::string(argv[1]) == "--benchmark") {
+		std::string name = argc >= 3 ? argv[2] : "all";
+		return benchmarks::Run(name) ? 0 : 1;
+	}
 
+	server.Run();
 	return 0;
 }
 
@@ -6,16 +6,23 @@
 
 #include <IServer.h>
 
+#include "ServerOptions.h"
+
 class Game;
 
 class Server : public IServer {
 public:
-	Server();
+	explicit Server(const ServerOptions &options = ServerOptions());
+
+	// Start network and game, never returns
+	void Run();
 
 // IServer
 	Player *Authorization(const std::string &login, const std::string &password) const override;
 	bool Registration(const std::string &login, const std::string &password) const override;
 	bool JoinGame(sptr<Player> &player) const override;
+	void FlushNetwork() const override;
+	NetworkCounters GetNetworkCounters() const override;
 
 	ResourceManager *GetRM() const;
 
@@ -24,4 +31,5 @@ private:
 	uptr<ResourceManager> rm;
 	uptr<NetworkController> networkController;
 	uptr<Game> game;
+	ServerOptions options;
 };
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <chrono>
+
+#include <Shared/TickScheduler.h>
+#include <Shared/Types.hpp>
+
+// Command line options
+struct ServerOptions {
+	// Number of network I/O threads, 0 means default
+	uint ioThreads{0};
+	// Threads which build player views besides the game thread, 0 means choose by hardware concurrency
+	uint viewThreads{0};
+	uint tickRate{20};
+	uf::TickWaitMode tickWaitMode{uf::TickWaitMode::HYBRID};
+	// Longer ticks are reported to Hitch-*.txt
+	std::chrono::milliseconds hitchThreshold{100};
+};
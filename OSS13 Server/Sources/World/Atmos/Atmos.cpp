@@ -1,11 +1,16 @@
 #include "Atmos.hpp"
 
+#include <algorithm>
+#include <limits>
+
 #include <plog/Log.h>
 
 #include <IServer.h>
 #include <Player.hpp>
 #include <World/World.hpp>
+#include <World/Map.hpp>
 #include <World/Tile.hpp>
+#include <World/Objects/Object.hpp>
 
 #include "AtmosOverlayWindowSink.h"
 
@@ -13,40 +18,305 @@ void ToggleAtmosOverlayVerb(Player *player) {
 	player->OpenWindow<AtmosOverlayWindowSink>();
 }
 
-Atmos::Atmos(Map* map) : map(map) {
+namespace {
+
+// Standard air which fills a tile when it gets a floor, kPa
+const pressure AIR_OXYGEN = 21.f;
+const pressure AIR_NITROGEN = 80.f;
+const float AIR_TEMPERATURE = 293.15f;
+
+const std::array<uf::Direction, 4> SIDES = { uf::Direction::SOUTH, uf::Direction::WEST, uf::Direction::NORTH, uf::Direction::EAST };
+
+// Tiles explored by the search around the removed tile before the split check is postponed
+const size_t SPLIT_SEARCH_LIMIT = 256;
+
+template<class TFunc>
+void forEachNeighbour(Tile *tile, TFunc func) {
+	for (auto direction : SIDES) {
+		const uf::vec2i offset = uf::DirectionToVect(direction);
+		if (Tile *neighbour = tile->GetMap()->GetTile(tile->GetPos() + rpos(offset.x, offset.y, 0)))
+			func(neighbour);
+	}
+}
+
+} // namespace
+
+Atmos::Atmos(Map* map) :
+	map(map),
+	grid(map->GetSize().x, map->GetSize().y, map->GetSize().z)
+{
 	AddVerb("toggleoverlay", &ToggleAtmosOverlayVerb);
+
+	// Map is space at first
+	AtmosGrid::Sides open;
+	open.fill(1.f);
+	for (uint z = 0; z < grid.GetLevels(); z++)
+		for (uint y = 0; y < grid.GetHeight(); y++)
+			for (uint x = 0; x < grid.GetWidth(); x++)
+				grid.SetCell({ x, y, z }, true, open);
 }
 
 void Atmos::Update(std::chrono::microseconds timeElapsed) {
-    for (auto iter = locales.begin(); iter != locales.end(); ) {
-        Locale *locale = iter->get();
-        if (locale->IsEmpty()) {
-            iter = locales.erase(iter);
-        } else {
-            locale->Update(timeElapsed);
-            iter++;
-        }
-    }
-}
-
-void Atmos::CreateLocale(Tile *tile) {
-    locales.push_back(std::make_unique<Locale>(this, tile));
-}
-
-void Atmos::RemoveLocale(Locale *locale) {
-    if (!locale) {
-        LOGE << "Error: try to remove nullptr locale from Atmos (Atmos::RemoveLocale)";
-        return;
-    }
-    for (auto iter = locales.begin(); iter != locales.end(); iter++) {
-        if (iter->get() == locale) {
-            for (auto tile : locale->tiles) {
-                tile->CheckLocale();
-            }
-            locale->Clear();
-            locales.erase(iter);
-            return;
-        }
-    }
-    LOGW << "Warning: try to remove locale from Atmos which doesn't exist (Atmos::RemoveLocale)";
+    for (auto *tile : outdatedTiles)
+        updateTile(tile);
+    outdatedTiles.clear();
+
+    if (!splitSeeds.empty())
+        splitPendingLocales();
+
+    grid.Update(timeElapsed, pool);
+}
+
+void Atmos::InvalidateTile(Tile *tile) {
+	if (tile->atmosOutdated)
+		return;
+	tile->atmosOutdated = true;
+	outdatedTiles.push_back(tile);
+}
+
+const AtmosGrid &Atmos::GetGrid() const { return grid; }
+AtmosGrid &Atmos::GetGrid() { return grid; }
+
+void Atmos::SetThreadPool(uf::ThreadPool *pool) { this->pool = pool; }
+
+void Atmos::updateTile(Tile *tile) {
+	tile->atmosOutdated = false;
+
+	const apos pos = tile->GetPos();
+	const bool vacuum = tile->IsSpace();
+	AtmosGrid::Sides sides;
+	if (tile->fullBlocked) {
+		sides.fill(0.f);
+	} else {
+		// Side is as open as the most airtight object allows
+		sides.fill(1.f);
+		for (auto *object : tile->Content()) {
+			auto &airtightness = object->GetAirtightness();
+			for (auto direction : SIDES) {
+				float &side = sides[size_t(direction)];
+				side = std::min(side, 1.f - float(airtightness.GetMaxFraction({ direction, uf::Direction::CENTER })));
+			}
+		}
+	}
+
+	const bool wasVacuum = grid.IsVacuum(pos);
+	grid.SetCell(pos, vacuum, sides);
+	if (wasVacuum && !vacuum) {
+		grid.SetPressure(pos, Gas::Oxygen, AIR_OXYGEN);
+		grid.SetPressure(pos, Gas::Nitrogen, AIR_NITROGEN);
+		grid.SetTemperature(pos, AIR_TEMPERATURE);
+	}
+}
+
+void Atmos::UpdateLocale(Tile *tile) {
+	const bool available = tile->hasFloor && !tile->fullBlocked;
+	const bool space = tile->IsSpace();
+
+	if (tile->locale && !available)
+		leaveLocale(tile);
+	if (tile->countedAsSpace != space) {
+		tile->countedAsSpace = space;
+		forEachNeighbour(tile, [this, space](Tile *neighbour) {
+			if (neighbour->locale) {
+				uint &edges = findLocale(neighbour)->spaceEdges;
+				space ? edges++ : edges--;
+			}
+		});
+	}
+	if (!tile->locale && available)
+		joinLocale(tile);
+}
+
+Locale *Atmos::createLocale() {
+	locales.push_back(std::make_unique<Locale>());
+	locales.back()->self = std::prev(locales.end());
+	return locales.back().get();
+}
+
+Locale *Atmos::findLocale(Tile *tile) {
+	Locale *root = tile->locale->GetRoot();
+	setLocale(tile, root);
+	return root;
+}
+
+void Atmos::setLocale(Tile *tile, Locale *locale) {
+	if (tile->locale == locale)
+		return;
+	if (locale)
+		locale->refs++;
+	Locale *previous = tile->locale;
+	tile->locale = locale;
+	if (previous)
+		releaseLocale(previous);
+}
+
+void Atmos::releaseLocale(Locale *locale) {
+	// Merged locale lives while something is forwarded through it
+	while (locale && !--locale->refs) {
+		Locale *parent = locale->parent;
+		locales.erase(locale->self);
+		locale = parent;
+	}
+}
+
+Locale *Atmos::mergeLocales(Locale *first, Locale *second) {
+	if (first == second)
+		return first;
+	if (first->numOfTiles < second->numOfTiles)
+		std::swap(first, second);
+	second->parent = first;
+	first->refs++;
+	first->numOfTiles += second->numOfTiles;
+	first->spaceEdges += second->spaceEdges;
+	first->splitPending |= second->splitPending;
+	second->numOfTiles = 0;
+	second->spaceEdges = 0;
+	return first;
+}
+
+void Atmos::joinLocale(Tile *tile) {
+	Locale *locale = nullptr;
+	forEachNeighbour(tile, [this, &locale](Tile *neighbour) {
+		if (neighbour->locale) {
+			Locale *neighbourLocale = findLocale(neighbour);
+			locale = locale ? mergeLocales(locale, neighbourLocale) : neighbourLocale;
+		}
+	});
+	if (!locale)
+		locale = createLocale();
+
+	setLocale(tile, locale);
+	locale->numOfTiles++;
+	locale->spaceEdges += countSpaceEdges(tile);
+}
+
+void Atmos::leaveLocale(Tile *tile) {
+	Locale *locale = findLocale(tile);
+	locale->numOfTiles--;
+	locale->spaceEdges -= countSpaceEdges(tile);
+	setLocale(tile, nullptr);
+
+	std::vector<Tile *> seeds;
+	forEachNeighbour(tile, [&seeds](Tile *neighbour) {
+		if (neighbour->locale)
+			seeds.push_back(neighbour);
+	});
+	if (seeds.empty())
+		return;
+
+	// Usually neighbours meet around the tile soon. Otherwise the whole area is searched later.
+	// Area waiting for the search keeps all seeds, the tile could be one of them.
+	locale = findLocale(seeds.front());
+	if (locale->splitPending || (seeds.size() > 1 && !splitLocale(seeds, SPLIT_SEARCH_LIMIT))) {
+		locale->splitPending = true;
+		splitSeeds.insert(splitSeeds.end(), seeds.begin(), seeds.end());
+	}
+}
+
+bool Atmos::splitLocale(const std::vector<Tile *> &seeds, size_t limit) {
+	// Searches explore in turns. Searches which met are one group exploring the same part.
+	struct Search {
+		std::vector<Tile *> tiles;
+		size_t next;
+		size_t group;
+		// Searches of the group which still have tiles to explore, valid for the group root
+		size_t active;
+	};
+	std::vector<Search> searches;
+
+	splitMark++;
+	for (auto *seed : seeds) {
+		if (seed->splitMark == splitMark)
+			continue;
+		seed->splitMark = splitMark;
+		seed->splitSearch = uint(searches.size());
+		searches.push_back({ { seed }, 0, searches.size(), 1 });
+	}
+
+	auto group = [&searches](size_t search) {
+		while (searches[search].group != search)
+			search = searches[search].group;
+		return search;
+	};
+
+	Locale *locale = findLocale(searches.front().tiles.front());
+	size_t groups = searches.size();
+	size_t explored = 0;
+	while (groups > 1) {
+		if (explored >= limit)
+			return false;
+		for (size_t i = 0; i < searches.size() && groups > 1; i++) {
+			Search &search = searches[i];
+			if (search.next == search.tiles.size())
+				continue;
+
+			Tile *tile = search.tiles[search.next++];
+			explored++;
+			forEachNeighbour(tile, [&](Tile *neighbour) {
+				if (!neighbour->locale)
+					return;
+				if (neighbour->splitMark != splitMark) {
+					neighbour->splitMark = splitMark;
+					neighbour->splitSearch = uint(i);
+					search.tiles.push_back(neighbour);
+					return;
+				}
+				size_t ours = group(i);
+				size_t theirs = group(neighbour->splitSearch);
+				if (ours != theirs) {
+					searches[theirs].group = ours;
+					searches[ours].active += searches[theirs].active;
+					groups--;
+				}
+			});
+			if (search.next != search.tiles.size())
+				continue;
+
+			// Group explored everything reachable and met no one, so it's a separate area
+			Search &root = searches[group(i)];
+			if (--root.active || groups == 1)
+				continue;
+			Locale *separated = createLocale();
+			for (auto &member : searches) {
+				if (&searches[group(&member - searches.data())] != &root)
+					continue;
+				for (auto *separatedTile : member.tiles) {
+					setLocale(separatedTile, separated);
+					separated->numOfTiles++;
+					separated->spaceEdges += countSpaceEdges(separatedTile);
+				}
+			}
+			locale->numOfTiles -= separated->numOfTiles;
+			locale->spaceEdges -= separated->spaceEdges;
+			groups--;
+		}
+	}
+	return true;
+}
+
+uint Atmos::countSpaceEdges(Tile *tile) const {
+	uint edges = 0;
+	forEachNeighbour(tile, [&edges](Tile *neighbour) { edges += neighbour->countedAsSpace; });
+	return edges;
+}
+
+void Atmos::splitPendingLocales() {
+	// Seeds of every locale are searched together without limit
+	std::vector<std::pair<Locale *, Tile *>> seeds;
+	for (auto *tile : splitSeeds) {
+		if (tile->locale)
+			seeds.emplace_back(findLocale(tile), tile);
+	}
+	splitSeeds.clear();
+	std::sort(seeds.begin(), seeds.end(), std::less<std::pair<Locale *, Tile *>>());
+
+	std::vector<Tile *> localeSeeds;
+	for (auto iter = seeds.begin(); iter != seeds.end(); ) {
+		Locale *locale = iter->first;
+		localeSeeds.clear();
+		for (; iter != seeds.end() && iter->first == locale; iter++)
+			localeSeeds.push_back(iter->second);
+		locale->splitPending = false;
+		splitLocale(localeSeeds, std::numeric_limits<size_t>::max());
+	}
 }
@@ -1,26 +1,66 @@
 #pragma once
 
 #include <list>
+#include <vector>
 
 #include <VerbsHolder.h>
 #include <Shared/Types.hpp>
 
 #include "Locale.hpp"
 #include "Gases.hpp"
+#include "AtmosGrid.h"
 
 class Map;
 class Tile;
 
+namespace uf {
+class ThreadPool;
+}
+
 class Atmos : public VerbsHolder {
 public:
     explicit Atmos(Map *map);
 
     void Update(std::chrono::microseconds timeElapsed);
 
-    void CreateLocale(Tile *);
-    void RemoveLocale(Locale *);
+    // Tile calls it when its floor or wall is changed
+    void UpdateLocale(Tile *);
+
+    // Tile calls it when its floor, wall or content airtightness is changed
+    void InvalidateTile(Tile *);
+    const AtmosGrid &GetGrid() const;
+    AtmosGrid &GetGrid();
+
+    // Gas exchange is computed by the pool threads. Without pool it's computed by the caller.
+    void SetThreadPool(uf::ThreadPool *pool);
+
+private:
+    // Passes tile openness to the grid
+    void updateTile(Tile *);
+
+    Locale *createLocale();
+    // Compresses the tile reference to the root of its set
+    Locale *findLocale(Tile *);
+    void setLocale(Tile *, Locale *);
+    void releaseLocale(Locale *);
+    Locale *mergeLocales(Locale *, Locale *);
+    void joinLocale(Tile *);
+    void leaveLocale(Tile *);
+    // Searches from the seeds of one locale until they meet. Parts which are explored
+    // without meeting others get new locales. Returns false if limit of explored tiles is reached.
+    bool splitLocale(const std::vector<Tile *> &seeds, size_t limit);
+    void splitPendingLocales();
+    // Sides of the tile which face space
+    uint countSpaceEdges(Tile *) const;
 
 private:
     Map *map;
     std::list<uptr<Locale>> locales;
+    // Neighbours of tiles removed from locales which couldn't be checked right away
+    std::vector<Tile *> splitSeeds;
+    uint splitMark{0};
+
+    AtmosGrid grid;
+    std::vector<Tile *> outdatedTiles;
+    uf::ThreadPool *pool{nullptr};
 };
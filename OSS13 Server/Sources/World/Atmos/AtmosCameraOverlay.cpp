@@ -1,10 +1,24 @@
 #include "AtmosCameraOverlay.h"
 
+#include <iterator>
+
 #include <World/Tile.hpp>
+#include <World/Map.hpp>
+#include <World/Atmos/Atmos.hpp>
 #include <World/Atmos/Locale.hpp>
 
 using namespace std::chrono_literals;
 
+namespace {
+
+const char *GAS_NAMES[] = { "O2", "N2", "CO2", "N2O", "PL", "FR" };
+static_assert(sizeof(GAS_NAMES) / sizeof(*GAS_NAMES) == size_t(Gas::Count), "Every gas should have a name");
+
+// Only changed values are sent, so heatmap is updated several times per second
+const std::chrono::microseconds UPDATE_PERIOD = 250ms;
+
+} // namespace
+
 AtmosCameraOverlay::AtmosCameraOverlay() :
 	mode(AtmosCameraOverlayMode::Locale)
 { }
@@ -16,7 +30,7 @@ void AtmosCameraOverlay::SetMode(AtmosCameraOverlayMode newMode) {
 bool AtmosCameraOverlay::IsShouldBeUpdated(std::chrono::microseconds timeElapsed) const {
 	timeAfterLastUpdate += timeElapsed;
 
-	if (timeAfterLastUpdate > 1s) {
+	if (timeAfterLastUpdate >= UPDATE_PERIOD) {
 		timeAfterLastUpdate = timeAfterLastUpdate.zero();
 		return true;
 	}
@@ -26,24 +40,52 @@ bool AtmosCameraOverlay::IsShouldBeUpdated(std::chrono::microseconds timeElapsed
 
 using namespace network::protocol;
 
-OverlayInfo AtmosCameraOverlay::GetOverlayInfo(Tile tile) const {
-	OverlayInfo result;
+OverlayInfo AtmosCameraOverlay::GetOverlayInfo() const {
+	OverlayInfo info;
+	info.type = OverlayValueType::Float;
+	info.precision = 1;
+
+	switch (mode) {
+		case AtmosCameraOverlayMode::Locale:
+			info.type = OverlayValueType::UInt32;
+			info.precision = 0;
+			info.channels = { "Locale" };
+			break;
+		case AtmosCameraOverlayMode::Pressure:
+			info.channels = { "Pressure" };
+			break;
+		case AtmosCameraOverlayMode::Temperature:
+			info.channels = { "Temperature" };
+			break;
+		case AtmosCameraOverlayMode::PartialGasPressure:
+			info.channels.assign(std::begin(GAS_NAMES), std::end(GAS_NAMES));
+			break;
+		default:
+			break;
+	}
+	return info;
+}
+
+void AtmosCameraOverlay::GetValues(const Tile &tile, float *values) const {
+	auto &grid = tile.GetMap()->GetAtmos()->GetGrid();
 
 	switch (mode) {
 		case AtmosCameraOverlayMode::Locale: {
-			auto locale = tile.GetLocale();
-			if (locale) {
-				auto localeID = tile.GetLocale()->ID();
-				result.text = std::to_string(localeID);
-			} else {
-				result.text = "NULL";
-			}
+			auto *locale = tile.GetLocale();
+			values[0] = locale ? float(locale->ID()) : 0;
 			break;
 		}
-		default: {
-			result.text = "NULL";
+		case AtmosCameraOverlayMode::Pressure:
+			values[0] = grid.GetTotalPressure(tile.GetPos());
+			break;
+		case AtmosCameraOverlayMode::Temperature:
+			values[0] = grid.GetTemperature(tile.GetPos());
+			break;
+		case AtmosCameraOverlayMode::PartialGasPressure:
+			for (size_t gas = 0; gas < size_t(Gas::Count); gas++)
+				values[gas] = grid.GetPressure(tile.GetPos(), Gas(gas));
+			break;
+		default:
 			break;
-		}
 	}
-	return result;
 }
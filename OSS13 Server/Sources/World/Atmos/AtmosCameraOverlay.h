@@ -20,7 +20,8 @@ public:
 
 // ICameraOverlay
 	bool IsShouldBeUpdated(std::chrono::microseconds timeElapsed) const override;
-	network::protocol::OverlayInfo GetOverlayInfo(Tile tile) const override;
+	network::protocol::OverlayInfo GetOverlayInfo() const override;
+	void GetValues(const Tile &tile, float *values) const override;
 
 private:
 	mutable std::chrono::microseconds timeAfterLastUpdate{0};
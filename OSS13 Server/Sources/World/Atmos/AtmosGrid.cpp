@@ -0,0 +1,267 @@
+#include "AtmosGrid.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <Shared/ErrorHandling.h>
+#include <Shared/ThreadPool.h>
+#include <Shared/Geometry/Direction.hpp>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define ATMOS_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ATMOS_SSE
+#endif
+
+namespace {
+
+const size_t SIMD_WIDTH = 8;
+// Rows computed by one task
+const size_t BAND_ROWS = 32;
+// Larger share makes explicit step unstable: cell could give more than it has
+const float MAX_STEP_RATE = 0.25f;
+
+size_t side(uf::Direction direction) { return size_t(direction); }
+
+// new = (p + rate * sum(edge * (neighbour - p))) * keep for count cells from the pointers
+void diffuseRow(const float *old, float *out, const float *east, const float *south, const float *keep,
+                size_t stride, size_t count, float rate)
+{
+	size_t i = 0;
+#if defined(ATMOS_AVX2)
+	const __m256 rateV = _mm256_set1_ps(rate);
+	for (; i + 8 <= count; i += 8) {
+		const __m256 p = _mm256_loadu_ps(old + i);
+		__m256 flow = _mm256_mul_ps(_mm256_loadu_ps(east + i), _mm256_sub_ps(_mm256_loadu_ps(old + i + 1), p));
+		flow = _mm256_add_ps(flow, _mm256_mul_ps(_mm256_loadu_ps(east + i - 1), _mm256_sub_ps(_mm256_loadu_ps(old + i - 1), p)));
+		flow = _mm256_add_ps(flow, _mm256_mul_ps(_mm256_loadu_ps(south + i), _mm256_sub_ps(_mm256_loadu_ps(old + i + stride), p)));
+		flow = _mm256_add_ps(flow, _mm256_mul_ps(_mm256_loadu_ps(south + i - stride), _mm256_sub_ps(_mm256_loadu_ps(old + i - stride), p)));
+		const __m256 result = _mm256_mul_ps(_mm256_add_ps(p, _mm256_mul_ps(rateV, flow)), _mm256_loadu_ps(keep + i));
+		_mm256_storeu_ps(out + i, result);
+	}
+#elif defined(ATMOS_SSE)
+	const __m128 rateV = _mm_set1_ps(rate);
+	for (; i + 4 <= count; i += 4) {
+		const __m128 p = _mm_loadu_ps(old + i);
+		__m128 flow = _mm_mul_ps(_mm_loadu_ps(east + i), _mm_sub_ps(_mm_loadu_ps(old + i + 1), p));
+		flow = _mm_add_ps(flow, _mm_mul_ps(_mm_loadu_ps(east + i - 1), _mm_sub_ps(_mm_loadu_ps(old + i - 1), p)));
+		flow = _mm_add_ps(flow, _mm_mul_ps(_mm_loadu_ps(south + i), _mm_sub_ps(_mm_loadu_ps(old + i + stride), p)));
+		flow = _mm_add_ps(flow, _mm_mul_ps(_mm_loadu_ps(south + i - stride), _mm_sub_ps(_mm_loadu_ps(old + i - stride), p)));
+		const __m128 result = _mm_mul_ps(_mm_add_ps(p, _mm_mul_ps(rateV, flow)), _mm_loadu_ps(keep + i));
+		_mm_storeu_ps(out + i, result);
+	}
+#endif
+	// Scalar fallback and the row tail. Same operations order as in the vector code.
+	for (; i < count; i++) {
+		const float p = old[i];
+		float flow = east[i] * (old[i + 1] - p);
+		flow += east[i - 1] * (old[i - 1] - p);
+		flow += south[i] * (old[i + stride] - p);
+		flow += south[i - stride] * (old[i - stride] - p);
+		out[i] = (p + rate * flow) * keep[i];
+	}
+}
+
+// Pointers to the same cell of every gas field
+using GasRows = std::array<const float *, size_t(Gas::Count)>;
+
+// heat = sum(gases) * temperature
+void heatRow(const GasRows &gases, const float *temperature, float *heat, size_t count) {
+	size_t i = 0;
+#if defined(ATMOS_AVX2)
+	for (; i + 8 <= count; i += 8) {
+		__m256 total = _mm256_loadu_ps(gases[0] + i);
+		for (size_t gas = 1; gas < gases.size(); gas++)
+			total = _mm256_add_ps(total, _mm256_loadu_ps(gases[gas] + i));
+		_mm256_storeu_ps(heat + i, _mm256_mul_ps(total, _mm256_loadu_ps(temperature + i)));
+	}
+#elif defined(ATMOS_SSE)
+	for (; i + 4 <= count; i += 4) {
+		__m128 total = _mm_loadu_ps(gases[0] + i);
+		for (size_t gas = 1; gas < gases.size(); gas++)
+			total = _mm_add_ps(total, _mm_loadu_ps(gases[gas] + i));
+		_mm_storeu_ps(heat + i, _mm_mul_ps(total, _mm_loadu_ps(temperature + i)));
+	}
+#endif
+	for (; i < count; i++) {
+		float total = gases[0][i];
+		for (size_t gas = 1; gas < gases.size(); gas++)
+			total += gases[gas][i];
+		heat[i] = total * temperature[i];
+	}
+}
+
+// temperature = heat / sum(gases), 0 if there is no gas
+void temperatureRow(const GasRows &gases, const float *heat, float *temperature, size_t count) {
+	size_t i = 0;
+#if defined(ATMOS_AVX2)
+	const __m256 zero = _mm256_setzero_ps();
+	for (; i + 8 <= count; i += 8) {
+		__m256 total = _mm256_loadu_ps(gases[0] + i);
+		for (size_t gas = 1; gas < gases.size(); gas++)
+			total = _mm256_add_ps(total, _mm256_loadu_ps(gases[gas] + i));
+		// Lanes without gas divide by zero and are masked out
+		const __m256 result = _mm256_div_ps(_mm256_loadu_ps(heat + i), total);
+		_mm256_storeu_ps(temperature + i, _mm256_and_ps(result, _mm256_cmp_ps(total, zero, _CMP_GT_OQ)));
+	}
+#elif defined(ATMOS_SSE)
+	const __m128 zero = _mm_setzero_ps();
+	for (; i + 4 <= count; i += 4) {
+		__m128 total = _mm_loadu_ps(gases[0] + i);
+		for (size_t gas = 1; gas < gases.size(); gas++)
+			total = _mm_add_ps(total, _mm_loadu_ps(gases[gas] + i));
+		// Lanes without gas divide by zero and are masked out
+		const __m128 result = _mm_div_ps(_mm_loadu_ps(heat + i), total);
+		_mm_storeu_ps(temperature + i, _mm_and_ps(result, _mm_cmpgt_ps(total, zero)));
+	}
+#endif
+	for (; i < count; i++) {
+		float total = gases[0][i];
+		for (size_t gas = 1; gas < gases.size(); gas++)
+			total += gases[gas][i];
+		temperature[i] = total > 0 ? heat[i] / total : 0.f;
+	}
+}
+
+} // namespace
+
+AtmosGrid::AtmosGrid(uint width, uint height, uint levels) :
+	width(width), height(height), levels(levels),
+	stride((width + 2 + SIMD_WIDTH - 1) / SIMD_WIDTH * SIMD_WIDTH),
+	levelSize(stride * (height + 2)),
+	current(FIELDS * levels * levelSize),
+	next(FIELDS * levels * levelSize),
+	eastEdges(levels * levelSize),
+	southEdges(levels * levelSize),
+	keep(levels * levelSize, 1.f),
+	sides(levels * levelSize)
+{ }
+
+const char *AtmosGrid::GetKernelName() {
+#if defined(ATMOS_AVX2)
+	return "AVX2";
+#elif defined(ATMOS_SSE)
+	return "SSE";
+#else
+	return "scalar";
+#endif
+}
+
+size_t AtmosGrid::index(apos pos) const {
+	EXPECT(pos.x < width && pos.y < height && pos.z < levels);
+	return pos.z * levelSize + (pos.y + 1) * stride + pos.x + 1;
+}
+
+void AtmosGrid::SetCell(apos pos, bool vacuum, const Sides &cellSides) {
+	const size_t cell = index(pos);
+	keep[cell] = vacuum ? 0.f : 1.f;
+	sides[cell] = cellSides;
+	updateEdges(cell);
+	updateEdges(cell - 1);
+	updateEdges(cell - stride);
+}
+
+void AtmosGrid::updateEdges(size_t cell) {
+	// Edge is as open as the most closed of its sides
+	eastEdges[cell] = std::min(sides[cell][side(uf::Direction::EAST)], sides[cell + 1][side(uf::Direction::WEST)]);
+	southEdges[cell] = std::min(sides[cell][side(uf::Direction::SOUTH)], sides[cell + stride][side(uf::Direction::NORTH)]);
+}
+
+bool AtmosGrid::IsVacuum(apos pos) const { return keep[index(pos)] == 0.f; }
+
+pressure AtmosGrid::GetPressure(apos pos, Gas gas) const {
+	return current[size_t(gas) * levels * levelSize + index(pos)];
+}
+
+void AtmosGrid::SetPressure(apos pos, Gas gas, pressure value) {
+	current[size_t(gas) * levels * levelSize + index(pos)] = value;
+}
+
+pressure AtmosGrid::GetTotalPressure(apos pos) const {
+	pressure total = 0;
+	for (size_t gas = 0; gas < size_t(Gas::Count); gas++)
+		total += current[gas * levels * levelSize + index(pos)];
+	return total;
+}
+
+float AtmosGrid::GetTemperature(apos pos) const {
+	return current[TEMPERATURE * levels * levelSize + index(pos)];
+}
+
+void AtmosGrid::SetTemperature(apos pos, float temperature) {
+	current[TEMPERATURE * levels * levelSize + index(pos)] = temperature;
+}
+
+void AtmosGrid::Update(std::chrono::microseconds timeElapsed, uf::ThreadPool *pool) {
+	const float share = DIFFUSION_RATE * std::chrono::duration<float>(timeElapsed).count();
+	if (share <= 0)
+		return;
+	// Long updates are split to stable steps
+	const size_t steps = size_t(std::ceil(share / MAX_STEP_RATE));
+	const float rate = share / float(steps);
+
+	for (size_t step = 0; step < steps; step++) {
+		// Heat of the neighbour rows is read by the step, so it's computed for every band before
+		forEachBand(pool, [this](size_t level, size_t firstRow, size_t lastRow) {
+			heatBand(level, firstRow, lastRow);
+		});
+		// Bands read the current fields and write only their rows of the next ones
+		forEachBand(pool, [this, rate](size_t level, size_t firstRow, size_t lastRow) {
+			stepBand(level, firstRow, lastRow, rate);
+		});
+		std::swap(current, next);
+	}
+}
+
+template <typename Func>
+void AtmosGrid::forEachBand(uf::ThreadPool *pool, Func &&func) {
+	const size_t bands = (height + BAND_ROWS - 1) / BAND_ROWS;
+	auto runTask = [this, bands, &func](size_t task) {
+		const size_t level = task / bands;
+		const size_t firstRow = task % bands * BAND_ROWS;
+		func(level, firstRow, std::min<size_t>(firstRow + BAND_ROWS, height));
+	};
+	if (pool) {
+		pool->ParallelFor(levels * bands, runTask);
+	} else {
+		for (size_t task = 0; task < levels * bands; task++)
+			runTask(task);
+	}
+}
+
+void AtmosGrid::heatBand(size_t level, size_t firstRow, size_t lastRow) {
+	const size_t fieldSize = levels * levelSize;
+	for (size_t row = firstRow; row < lastRow; row++) {
+		const size_t first = level * levelSize + (row + 1) * stride + 1;
+		GasRows gases;
+		for (size_t gas = 0; gas < gases.size(); gas++)
+			gases[gas] = current.data() + gas * fieldSize + first;
+		heatRow(gases, current.data() + TEMPERATURE * fieldSize + first, current.data() + HEAT * fieldSize + first, width);
+	}
+}
+
+void AtmosGrid::stepBand(size_t level, size_t firstRow, size_t lastRow, float rate) {
+	const size_t fieldSize = levels * levelSize;
+	for (size_t field = 0; field < FIELDS; field++) {
+		if (field == TEMPERATURE)
+			continue;
+		const size_t fieldOffset = field * fieldSize;
+		for (size_t row = firstRow; row < lastRow; row++) {
+			// The first cell of the row after the border
+			const size_t first = level * levelSize + (row + 1) * stride + 1;
+			diffuseRow(current.data() + fieldOffset + first, next.data() + fieldOffset + first,
+			           eastEdges.data() + first, southEdges.data() + first, keep.data() + first, stride, width, rate);
+		}
+	}
+
+	// Temperature is restored from the heat which came with the gas
+	for (size_t row = firstRow; row < lastRow; row++) {
+		const size_t first = level * levelSize + (row + 1) * stride + 1;
+		GasRows gases;
+		for (size_t gas = 0; gas < gases.size(); gas++)
+			gases[gas] = next.data() + gas * fieldSize + first;
+		temperatureRow(gases, next.data() + HEAT * fieldSize + first, next.data() + TEMPERATURE * fieldSize + first, width);
+	}
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <vector>
+
+#include <Shared/Types.hpp>
+
+#include "Gases.hpp"
+
+namespace uf {
+class ThreadPool;
+}
+
+// Gas state of the map as structure of arrays: float grid of every gas partial pressure
+// and of temperature per z-level. Every step gas flows through the open edges between
+// neighbour cells proportionally to the difference, so the amount of gas is conserved
+// except vacuum cells, which are emptied after each step.
+// Heat (total pressure by temperature) flows with the gas, then temperature is restored from it,
+// so temperature is the gas-weighted mean of the mixed cells. Cell without gas has no temperature.
+//
+// Grid has a border of one closed cell, so kernels don't check bounds.
+// Rows are padded to the SIMD width, kernels process 8 (AVX2) or 4 (SSE) cells at once.
+class AtmosGrid {
+public:
+	// Gases, temperature and heat which is diffused instead of temperature
+	static constexpr size_t FIELDS = size_t(Gas::Count) + 2;
+	static constexpr size_t TEMPERATURE = size_t(Gas::Count);
+	static constexpr size_t HEAT = size_t(Gas::Count) + 1;
+
+	// Share of the difference which flows through a fully open edge per second
+	static constexpr float DIFFUSION_RATE = 4.f;
+
+	// Openness of a cell side per Direction (SOUTH, WEST, NORTH, EAST), 0 is airtight
+	using Sides = std::array<float, 4>;
+
+	AtmosGrid(uint width, uint height, uint levels);
+
+	// Cell is closed and empty by default
+	void SetCell(apos pos, bool vacuum, const Sides &sides);
+	bool IsVacuum(apos pos) const;
+
+	pressure GetPressure(apos pos, Gas gas) const;
+	void SetPressure(apos pos, Gas gas, pressure value);
+	pressure GetTotalPressure(apos pos) const;
+	// Gas which is added by SetPressure has the temperature of the cell. Cell without gas has 0,
+	// so temperature of the empty cell is set after its pressure.
+	float GetTemperature(apos pos) const;
+	void SetTemperature(apos pos, float temperature);
+
+	// Rows of every level are split to bands, which are computed in parallel if pool is passed
+	void Update(std::chrono::microseconds timeElapsed, uf::ThreadPool *pool = nullptr);
+
+	uint GetWidth() const { return width; }
+	uint GetHeight() const { return height; }
+	uint GetLevels() const { return levels; }
+	// Name of the kernel chosen at compile time
+	static const char *GetKernelName();
+
+private:
+	size_t index(apos pos) const;
+	void updateEdges(size_t cell);
+	template <typename Func> void forEachBand(uf::ThreadPool *pool, Func &&func);
+	void heatBand(size_t level, size_t firstRow, size_t lastRow);
+	void stepBand(size_t level, size_t firstRow, size_t lastRow, float rate);
+
+private:
+	const uint width;
+	const uint height;
+	const uint levels;
+	// Cells in the padded row and in the padded level
+	const size_t stride;
+	const size_t levelSize;
+
+	// Field by field, level by level. Next fields are written by the step, then swapped with current.
+	std::vector<float> current;
+	std::vector<float> next;
+	// Conductance of the edge between the cell and its east or south neighbour
+	std::vector<float> eastEdges;
+	std::vector<float> southEdges;
+	// 0 for vacuum cells, 1 for others
+	std::vector<float> keep;
+	std::vector<Sides> sides;
+};
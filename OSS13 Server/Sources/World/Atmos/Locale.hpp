@@ -1,50 +1,40 @@
 ﻿#pragma once
 
-#include <vector>
 #include <list>
-#include <chrono>
 
 #include <Shared/Types.hpp>
 #include <Shared/IFaces/IHasRepeatableID.h>
 
-#include "Gases.hpp"
-
-class Tile;
 class Atmos;
 
+// Connected area of tiles with floor and without wall.
+//
+// Locales are nodes of disjoint-set forest. Merged locale is linked to the bigger one
+// and only forwards its tiles to it, so merge doesn't touch tiles. Tile refers to any node
+// of its set, the root represents the whole area and keeps its status.
+// Locales are owned and changed by Atmos.
 class Locale : public IHasRepeatableID {
 public:
-    explicit Locale(Atmos *, Tile *);
-
-    void Update(std::chrono::microseconds timeElapsed);
-
-    // Add Tile to locale
-    void AddTile(Tile *tile);
-    // Remove Tile from Locale
-    void RemoveTile(Tile *tile);
-    // Merge with other locale
-    void Merge(Locale *locale);
-    // Remove all tiles
-    void Clear();
-
-    // Call if neighbour tile became space
-    void Open();
-    // Call if wall was build at near tile
-    void CheckCloseness();
+    Locale *GetRoot();
+    const Locale *GetRoot() const;
 
-    bool IsEmpty() const;
+    // Area has no edges to space
     bool IsClosed() const;
     uint NumOfTiles() const;
 
     friend Atmos;
 
 private:
-    Atmos *atmos;
-    
-    std::list<pressure> gases;
-    std::list<Tile *> tiles;
-
-    // Status
-    bool closed;
-    bool needToCheckCloseness;
+    Locale *parent{nullptr};
+    // Tiles and merged locales which refer to this one
+    uint refs{0};
+
+    // Valid for the root only
+    uint numOfTiles{0};
+    // Sides of the area tiles which face space
+    uint spaceEdges{0};
+    // Area may be split, it'll be searched on the Atmos update
+    bool splitPending{false};
+
+    std::list<uptr<Locale>>::iterator self;
 };
@@ -1,21 +1,27 @@
 #include "Camera.hpp"
 
+#include <algorithm>
+
 #include <plog/Log.h>
 
 #include <IGame.h>
 #include <Player.hpp>
 #include <World/World.hpp>
 #include <World/Map.hpp>
+#include <World/MapChunk.hpp>
 #include <World/Objects/Control.hpp>
 #include <World/Atmos/AtmosCameraOverlay.h>
+#include <Profiling/HitchRecorder.h>
 
 #include <Shared/Array.hpp>
+#include <Shared/Network/Dispatch.h>
 #include <Shared/Network/Protocol/ServerToClient/Commands.h>
 
 #include <Shared/ErrorHandling.h>
+#include <Shared/Profiling/Profiler.h>
 
 Camera::Camera(const Tile * const tile) :
-    tile(nullptr), lasttile(nullptr), suspense(true),
+    tile(nullptr), lasttile(nullptr), needSync(false), suspense(true),
     changeFocus(false),
     unsuspensed(false), cameraMoved(false)
 {
@@ -38,21 +44,54 @@ void Camera::Update(std::chrono::microseconds timeElapsed) {
 void Camera::updateOverlay(std::chrono::microseconds timeElapsed) {
 	if (!overlay)
 		return;
-	if (overlay->IsShouldBeUpdated(timeElapsed)) {
-		auto command = std::make_unique<network::protocol::server::OverlayUpdateCommand>();
+	if (!overlay->IsShouldBeUpdated(timeElapsed))
+		return;
 
-		command->overlayInfo.reserve(visibleTilesSide*visibleTilesSide*visibleTilesHeight);
-		for (auto &tile: visibleBlocks) {
-			if (tile) {
-				command->overlayInfo.push_back(overlay->GetOverlayInfo(*tile));
-			}
-		}
+	auto command = std::make_unique<network::protocol::server::OverlayUpdateCommand>();
+	const size_t cells = visibleBlocks.size();
+
+	auto layer = overlay->GetOverlayInfo();
+	if (!overlayLayerSent || layer != overlayLayer) {
+		overlayLayer = layer;
+		overlayLayerSent = true;
+		overlayValues.assign(cells * layer.GetCellSize(), 0);
+		overlayKnown.assign(cells, false);
+		command->newLayer = true;
+		command->layer = std::move(layer);
+	}
 
-		player->AddCommandToClient(command.release());
+	const size_t valueSize = overlayLayer.GetValueSize();
+	const size_t cellSize = overlayLayer.GetCellSize();
+	std::vector<float> values(overlayLayer.channels.size());
+	std::vector<sf::Uint8> packed(cellSize);
+
+	command->changedCells.resize((cells + 7) / 8);
+	for (size_t cell = 0; cell < cells; cell++) {
+		Tile *tile = visibleBlocks[cell];
+		if (!tile)
+			continue;
+		overlay->GetValues(*tile, values.data());
+		for (size_t channel = 0; channel < values.size(); channel++)
+			overlayLayer.Pack(values[channel], packed.data() + channel * valueSize);
+
+		auto last = overlayValues.begin() + cell * cellSize;
+		if (overlayKnown[cell] && std::equal(packed.begin(), packed.end(), last))
+			continue;
+		std::copy(packed.begin(), packed.end(), last);
+		overlayKnown[cell] = true;
+
+		command->SetChanged(cell);
+		command->values.insert(command->values.end(), packed.begin(), packed.end());
 	}
+
+	if (command->newLayer || !command->values.empty())
+		player->AddCommandToClient(command.release());
 }
 
 void Camera::UpdateView(std::chrono::microseconds timeElapsed) {
+	PROFILE_SCOPE("tick/views/camera");
+	const auto start = std::chrono::steady_clock::now();
+
     if (unsuspensed && cameraMoved) 
         LOGE << "Logic error: camera unsuspensed and moved at one time";
 
@@ -75,15 +114,13 @@ void Camera::UpdateView(std::chrono::microseconds timeElapsed) {
 	Object *viewer = player->GetControl()->GetOwner();
 	uint viewerId = viewer ? viewer->ID() : 0;
 
-	std::vector<std::pair<std::shared_ptr<network::protocol::Diff>, sptr<Object>>> differencesWithObjects;
-
-	for (int i = 0; i < visibleTilesSide * visibleTilesSide * visibleTilesHeight; i++) {
-		Tile *tile = visibleBlocks[i];
-		if (tile) {
-			if (blocksSync[i]) {
-				// Collect differences
-				differencesWithObjects.insert(differencesWithObjects.end(), tile->GetDifferencesWithObject().begin(), tile->GetDifferencesWithObject().end());
-			} else {
+	// Send full info about unsynced tiles. They are marked synced after diffs processing,
+	// because their diffs of this tick are already included in the info
+	std::vector<int> syncedBlocks;
+	if (needSync) {
+		for (int i = 0; i < visibleTilesSide * visibleTilesSide * visibleTilesHeight; i++) {
+			Tile *tile = visibleBlocks[i];
+			if (tile && !blocksSync[i]) {
 				command->tilesInfo.push_back(tile->GetTileInfo(viewerId, seeInvisibleAbility));
 				for (auto &object: tile->Content()) {
 					if (!object->CheckVisibility(viewerId, seeInvisibleAbility)) {
@@ -91,72 +128,86 @@ void Camera::UpdateView(std::chrono::microseconds timeElapsed) {
 					}
 					visibleObjects.insert(object->ID());
 				}
-				blocksSync[i] = true;
+				syncedBlocks.push_back(i);
 			}
 		}
+		needSync = false;
 	}
 
-	// Sort differences
-	std::sort(differencesWithObjects.begin(), differencesWithObjects.end(), 
-			[](const std::pair<std::shared_ptr<network::protocol::Diff>, sptr<Object>> &a, const std::pair<std::shared_ptr<network::protocol::Diff>, sptr<Object>> &b) {
-				return a.first->GetDiffId() < b.first->GetDiffId();
-			}
-	);
-
-	// Process differences
-	for (auto &diffAndObject : differencesWithObjects) {
-		auto &generalDiff = diffAndObject.first;
-		auto &object = diffAndObject.second;
-
-		if (!object->CheckVisibility(viewerId, seeInvisibleAbility))
-			continue;
-
-		if (auto *diff = dynamic_cast<network::protocol::AddDiff *>(generalDiff.get())) {
-			CHECK(visibleObjects.find(diff->objId) == visibleObjects.end()); // debug
-			visibleObjects.insert(diff->objId);
-		} else if (auto *diff = dynamic_cast<network::protocol::MoveDiff *>(generalDiff.get())) {
-			if (visibleObjects.find(diff->objId) == visibleObjects.end()) {
-				apos to = apos(object->GetPosition() + DirectionToVect(diff->direction), 0);
-				auto addDiff = std::make_shared<network::protocol::AddDiff>();
-				addDiff->objId = diff->objId;
-				addDiff->objectInfo = object->GetObjectInfo();
-				addDiff->coords = to;
-				command->diffs.push_back(std::move(addDiff));
-				visibleObjects.insert(diff->objId);
-				continue;
-			}
-		} else if (auto *diff = dynamic_cast<network::protocol::RelocateAwayDiff *>(generalDiff.get())) {
-			CHECK(visibleObjects.find(diff->objId) != visibleObjects.end()); // debug
-			if (diff->newCoords >= rpos(firstBlockX, firstBlockY, firstBlockZ) &&
-				diff->newCoords < rpos(firstBlockX + visibleTilesSide, firstBlockY + visibleTilesSide, firstBlockZ + visibleTilesHeight))
-			{
-				continue;
+	const rpos firstBlock(firstBlockX, firstBlockY, firstBlockZ);
+	const rpos viewSize(visibleTilesSide, visibleTilesSide, visibleTilesHeight);
+
+	World *world = GGame->GetWorld();
+	Map *map = world->GetMap();
+
+	// Process differences of synced tiles in diff id order
+	diffsMerger.Merge(visibleChunks, [&](const MapChunk::DiffRecord &record) {
+		rpos blockPos = record.tile->GetPos() - firstBlock;
+		if (!(blockPos >= rpos(0) && blockPos < viewSize) || !blocksSync[flat_index(blockPos)])
+			return;
+
+		auto *generalDiff = record.diff;
+		Object *object = world->GetObject(record.object);
+
+		if (!object || !object->CheckVisibility(viewerId, seeInvisibleAbility))
+			return;
+
+		// Viewer can get another diff instead or nothing at all
+		bool forward = true;
+
+		uf::Dispatch<AddDiff, MoveDiff, RelocateAwayDiff, RelocateDiff, RemoveDiff>(*generalDiff, uf::Overloaded{
+			[&](AddDiff &diff) {
+				CHECK(visibleObjects.find(diff.objId) == visibleObjects.end()); // debug
+				visibleObjects.insert(diff.objId);
+			},
+			[&](MoveDiff &diff) {
+				if (visibleObjects.find(diff.objId) == visibleObjects.end()) {
+					apos to = apos(object->GetPosition() + DirectionToVect(diff.direction), 0);
+					auto addDiff = std::make_shared<AddDiff>();
+					addDiff->objId = diff.objId;
+					addDiff->objectInfo = object->GetObjectInfo();
+					addDiff->coords = to;
+					command->diffs.push_back(std::move(addDiff));
+					visibleObjects.insert(diff.objId);
+					forward = false;
+				}
+			},
+			[&](RelocateAwayDiff &diff) {
+				CHECK(visibleObjects.find(diff.objId) != visibleObjects.end()); // debug
+				forward = false;
+				if (diff.newCoords >= firstBlock && diff.newCoords < firstBlock + viewSize) {
+					return;
+				}
+				visibleObjects.erase(diff.objId);
+
+				auto removeDiff = std::make_shared<RemoveDiff>();
+				removeDiff->objId = diff.objId;
+
+				command->diffs.push_back(std::move(removeDiff));
+			},
+			[&](RelocateDiff &diff) {
+				if (visibleObjects.find(diff.objId) == visibleObjects.end()) {
+					auto addDiff = std::make_shared<AddDiff>();
+					addDiff->objId = diff.objId;
+					addDiff->objectInfo = object->GetObjectInfo();
+					addDiff->coords = diff.newCoords;
+					command->diffs.push_back(std::move(addDiff));
+					visibleObjects.insert(diff.objId);
+					forward = false;
+				}
+			},
+			[&](RemoveDiff &diff) {
+				CHECK(visibleObjects.find(diff.objId) != visibleObjects.end()); // debug
+				visibleObjects.erase(diff.objId);
 			}
-			visibleObjects.erase(diff->objId);
+		});
 
-			auto removeDiff = std::make_shared<network::protocol::RemoveDiff>();
-			removeDiff->objId = diff->objId;
+		if (forward)
+			command->diffs.push_back(map->ShareDiff(generalDiff));
+	});
 
-			command->diffs.push_back(std::move(removeDiff));
-			continue;
-
-		} else if (auto *diff = dynamic_cast<network::protocol::RelocateDiff *>(generalDiff.get())) {
-			if (visibleObjects.find(diff->objId) == visibleObjects.end()) {
-				auto addDiff = std::make_shared<network::protocol::AddDiff>();
-				addDiff->objId = diff->objId;
-				addDiff->objectInfo = object->GetObjectInfo();
-				addDiff->coords = diff->newCoords;
-				command->diffs.push_back(std::move(addDiff));
-				visibleObjects.insert(diff->objId);
-				continue;
-			}
-		} else if (auto *diff = dynamic_cast<network::protocol::RemoveDiff *>(generalDiff.get())) {
-			CHECK(visibleObjects.find(diff->objId) != visibleObjects.end()); // debug
-			visibleObjects.erase(diff->objId);
-		};
-
-		command->diffs.push_back(std::move(generalDiff));
-	}
+	for (int i : syncedBlocks)
+		blocksSync[i] = true;
 
 	if (blockShifted) {
 		updateOptions |= server::GraphicsUpdateCommand::Option::TILES_SHIFT;
@@ -181,6 +232,8 @@ void Camera::UpdateView(std::chrono::microseconds timeElapsed) {
 		player->AddCommandToClient(command.release());
 
 	updateOverlay(timeElapsed);
+
+	GGame->GetHitchRecorder()->RecordCamera(*this, std::chrono::steady_clock::now() - start);
 }
 
 void Camera::SetPlayer(Player * const player) { this->player = player; changeFocus = true; }
@@ -209,10 +262,12 @@ void Camera::Suspend() {
 
 void Camera::SetOverlay(uptr<ICameraOverlay> &&overlay) {
 	this->overlay = std::forward<uptr<ICameraOverlay>>(overlay);
+	overlayLayerSent = false;
 }
 
 void Camera::ResetOverlay() {
 	this->overlay.reset();
+	overlayLayerSent = false;
 	auto command = std::make_unique<network::protocol::server::OverlayResetCommand>();
 	player->AddCommandToClient(command.release());
 }
@@ -241,6 +296,11 @@ void Camera::fullRecountVisibleBlocks(const Tile * const tile) {
     blockShifted = true;
 
     fill(blocksSync.begin(), blocksSync.end(), false);
+    needSync = true;
+    // Client creates tiles anew, they are without overlay
+    fill(overlayKnown.begin(), overlayKnown.end(), false);
+
+    tile->GetMap()->GetChunks({firstBlockX, firstBlockY, firstBlockZ}, {visibleTilesSide, visibleTilesSide, visibleTilesHeight}, visibleChunks);
 }
 
 // Commit shift to Visible Blocks vector, saving seen blocks with their sync param
@@ -275,6 +335,10 @@ void Camera::refreshVisibleBlocks(const Tile * const tile) {
         const int block_dz = firstNewBlockZ - firstBlockZ;
 
         std::vector<bool> saved(visibleTilesSide*visibleTilesSide*visibleTilesHeight);
+        // Client shifts tiles with their overlay
+        std::vector<bool> savedOverlayKnown(overlayKnown.size());
+        std::vector<sf::Uint8> savedOverlayValues(overlayValues.size());
+        const size_t overlayCellSize = overlayLayer.GetCellSize();
 
         for (int y = 0; y < visibleTilesSide; y++)
             for (int x = 0; x < visibleTilesSide; x++)
@@ -284,7 +348,14 @@ void Camera::refreshVisibleBlocks(const Tile * const tile) {
 							y - block_dy >= 0 && y - block_dy < visibleTilesSide &&
 							z - block_dz >= 0 && z - block_dz < visibleTilesHeight)
 						{
-							saved[flat_index({x-block_dx,y-block_dy,z-block_dz})] = true;
+							const int from = flat_index({x,y,z});
+							const int to = flat_index({x-block_dx,y-block_dy,z-block_dz});
+							saved[to] = true;
+							if (!overlayKnown.empty() && overlayKnown[from]) {
+								savedOverlayKnown[to] = true;
+								std::copy_n(overlayValues.begin() + from * overlayCellSize, overlayCellSize,
+								            savedOverlayValues.begin() + to * overlayCellSize);
+							}
 						} else {
 							Tile *block = visibleBlocks[flat_index({x,y,z})];
 							if (block) {
@@ -298,6 +369,8 @@ void Camera::refreshVisibleBlocks(const Tile * const tile) {
 
         fullRecountVisibleBlocks(tile);
         blocksSync = saved; 
+        overlayKnown = std::move(savedOverlayKnown);
+        overlayValues = std::move(savedOverlayValues);
     }
 }
 
@@ -6,8 +6,10 @@
 #include <Shared/Types.hpp>
 
 #include "ICameraOverlay.h"
+#include "DiffsMerger.h"
 
 class Tile;
+class MapChunk;
 class Object;
 class Player;
 struct Diff;
@@ -33,6 +35,7 @@ public:
 
     bool IsSuspense() const { return suspense; }
 	const Tile * const GetPosition() const { return tile; }
+	Player *GetPlayer() const { return player; }
 	uint GetInvisibleVisibility() const { return seeInvisibleAbility; }
 
 private:
@@ -54,12 +57,23 @@ private:
 	int firstBlockZ;
 	std::vector<Tile *> visibleBlocks;
 	std::vector<bool> blocksSync;
+	// Some of visible blocks are not synced
+	bool needSync;
 	std::unordered_set<uint> visibleObjects;
 
+	// Chunks overlapping the view, camera takes diffs from their streams
+	std::vector<MapChunk *> visibleChunks;
+	DiffsMerger diffsMerger;
+
 	bool suspense;
 	bool changeFocus;
 
 	uptr<ICameraOverlay> overlay;
+	// Overlay as client has it, so only changed cells are sent
+	network::protocol::OverlayInfo overlayLayer;
+	bool overlayLayerSent{false};
+	std::vector<sf::Uint8> overlayValues;
+	std::vector<bool> overlayKnown;
 
 	// Update options
 	bool blockShifted;
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <vector>
+
+#include <World/MapChunk.hpp>
+
+// Merges diffs streams of several chunks in diff id order without copying them.
+// Every stream is already sorted, and there are only a few streams per view,
+// so the next diff is chosen by linear search over stream heads.
+class DiffsMerger {
+public:
+	// func(const MapChunk::DiffRecord &) is called for every diff of the chunks.
+	// func must not add diffs to the chunks.
+	template<class Func>
+	void Merge(const std::vector<MapChunk *> &chunks, Func &&func);
+
+private:
+	struct Cursor {
+		const MapChunk::DiffRecord *current;
+		const MapChunk::DiffRecord *end;
+	};
+
+	// Kept between calls to avoid allocations
+	std::vector<Cursor> cursors;
+};
+
+template<class Func>
+void DiffsMerger::Merge(const std::vector<MapChunk *> &chunks, Func &&func) {
+	cursors.clear();
+	for (auto *chunk : chunks) {
+		auto &diffs = chunk->GetDiffs();
+		if (!diffs.empty())
+			cursors.push_back({ diffs.data(), diffs.data() + diffs.size() });
+	}
+
+	while (!cursors.empty()) {
+		size_t min = 0;
+		for (size_t i = 1; i < cursors.size(); i++) {
+			if (cursors[i].current->diff->GetDiffId() < cursors[min].current->diff->GetDiffId())
+				min = i;
+		}
+
+		func(*cursors[min].current);
+
+		if (++cursors[min].current == cursors[min].end) {
+			cursors[min] = cursors.back();
+			cursors.pop_back();
+		}
+	}
+}
@@ -12,5 +12,8 @@ public:
 	virtual ~ICameraOverlay() = default;
 
 	virtual bool IsShouldBeUpdated(std::chrono::microseconds timeElapsed) const = 0;
-	virtual network::protocol::OverlayInfo GetOverlayInfo(Tile tile) const = 0;
+	// Values type and channels. When they are changed, values of the whole view are resent.
+	virtual network::protocol::OverlayInfo GetOverlayInfo() const = 0;
+	// Writes value of every channel of the overlay info
+	virtual void GetValues(const Tile &tile, float *values) const = 0;
 };
@@ -1,51 +1,121 @@
 #include "Map.hpp"
 
+#include <algorithm>
+#include <atomic>
+
 #include <plog/Log.h>
 
 #include "Tile.hpp"
 #include "Atmos/Atmos.hpp"
 #include "Shared/Global.hpp"
 #include "Shared/Array.hpp"
+#include "Shared/Profiling/Profiler.h"
 
 Map::Map(const uint sizeX, const uint sizeY, const uint sizeZ) :
-	size(sizeX, sizeY, sizeZ)
+	size(sizeX, sizeY, sizeZ),
+	chunksNum((sizeX + MapChunk::SIDE - 1) / MapChunk::SIDE, (sizeY + MapChunk::SIDE - 1) / MapChunk::SIDE, sizeZ),
+	diffsArena(std::make_shared<uf::Arena>())
 {
-	tiles.reserve(sizeX*sizeY*sizeZ);
-	for (uint z = 0; z < sizeZ; z++) {
-		for (uint y = 0; y < sizeY; y++) {
-			for (uint x = 0; x < sizeX; x++) {
-				tiles.push_back(std::make_unique<Tile>(this, apos(x,y,z)));
+	chunks.reserve(chunksNum.x * chunksNum.y * chunksNum.z);
+	for (uint z = 0; z < chunksNum.z; z++) {
+		for (uint y = 0; y < chunksNum.y; y++) {
+			for (uint x = 0; x < chunksNum.x; x++) {
+				apos origin(x * MapChunk::SIDE, y * MapChunk::SIDE, z);
+				uf::vec2u chunkSize(std::min(MapChunk::SIDE, sizeX - origin.x), std::min(MapChunk::SIDE, sizeY - origin.y));
+				chunks.push_back(std::make_unique<MapChunk>(this, origin, chunkSize));
 			}
 		}
 	}
-	LOGI << "Map is created with size: " << sizeX << "x" << sizeY << "x" << sizeZ;
+	LOGI << "Map is created with size: " << sizeX << "x" << sizeY << "x" << sizeZ
+	     << " (" << chunks.size() << " chunks)";
 
 	atmos = std::make_unique<Atmos>(this);
 }
 
 void Map::ClearDiffs() {
-	for (auto &tile : tiles)
-		tile->ClearDiffs();
+	for (auto *chunk : chunksWithDiffs)
+		chunk->ClearDiffs();
+	chunksWithDiffs.clear();
+	recycleDiffsArena();
 	network::protocol::Diff::ResetDiffCounter();
 }
 
 void Map::Update(std::chrono::microseconds timeElapsed) {
-    for (auto &tile : tiles)
-		tile->Update(timeElapsed);
-    atmos->Update(timeElapsed);
+	// Chunks registered while updating go to the fresh list and wait for the next pass
+	{
+		PROFILE_SCOPE("tick/world/map/tiles");
+		std::swap(chunksToUpdate, chunksUpdating);
+		for (auto *chunk : chunksUpdating)
+			chunk->Update(timeElapsed);
+		chunksUpdating.clear();
+	}
+	PROFILE_SCOPE("tick/world/map/atmos");
+	atmos->Update(timeElapsed);
+}
+
+sptr<network::protocol::Diff> Map::ShareDiff(network::protocol::Diff *diff) const {
+	return sptr<network::protocol::Diff>(diffsArena, diff);
+}
+
+const uf::Arena &Map::GetDiffsArena() const { return *diffsArena; }
+
+void Map::recycleDiffsArena() {
+	if (diffsArena.use_count() > 1) {
+		retiredArenas.push_back(std::move(diffsArena));
+		auto free = std::find_if(retiredArenas.begin(), retiredArenas.end(), [](const sptr<uf::Arena> &arena) { return arena.use_count() == 1; });
+		if (free != retiredArenas.end()) {
+			diffsArena = std::move(*free);
+			retiredArenas.erase(free);
+		} else {
+			diffsArena = std::make_shared<uf::Arena>();
+		}
+	}
+	// Network threads released their references, their reads of the diffs happened before
+	std::atomic_thread_fence(std::memory_order_acquire);
+	diffsArena->Reset();
 }
 
 apos Map::GetSize() const { return size; }
 Atmos* Map::GetAtmos() const { return atmos.get(); };
 
 Tile *Map::GetTile(vec3i pos) const {
-    if (pos >= vec3i(0) && pos < size)
-        return tiles[flat_index(pos)].get();
-    return nullptr;
+	if (MapChunk *chunk = GetChunk(pos)) {
+		apos upos(pos);
+		return chunk->GetTile({upos.x % MapChunk::SIDE, upos.y % MapChunk::SIDE});
+	}
+	return nullptr;
 }
 
-uint Map::flat_index(const apos c) const {
-	return uf::flat_index(c, size.x, size.y);
+MapChunk *Map::GetChunk(vec3i pos) const {
+	if (pos >= vec3i(0) && pos < size) {
+		apos upos(pos);
+		return chunks[uf::flat_index(apos(upos.x / MapChunk::SIDE, upos.y / MapChunk::SIDE, upos.z), chunksNum.x, chunksNum.y)].get();
+	}
+	return nullptr;
+}
+
+void Map::GetChunks(vec3i from, vec3i areaSize, vector<MapChunk *> &result) const {
+	result.clear();
+
+	const vec3i to(std::min(from.x + areaSize.x, int(size.x)),
+	               std::min(from.y + areaSize.y, int(size.y)),
+	               std::min(from.z + areaSize.z, int(size.z)));
+	from = vec3i(std::max(from.x, 0), std::max(from.y, 0), std::max(from.z, 0));
+
+	// Step by chunk borders
+	const int side = int(MapChunk::SIDE);
+	for (int z = from.z; z < to.z; z++)
+		for (int y = from.y; y < to.y; y = (y / side + 1) * side)
+			for (int x = from.x; x < to.x; x = (x / side + 1) * side)
+				result.push_back(GetChunk({x, y, z}));
 }
 
-const vector< uptr<Tile>>& Map::GetTiles() const { return tiles; }
\ No newline at end of file
+const vector<uptr<MapChunk>> &Map::GetChunks() const { return chunks; }
+
+void Map::addChunkWithDiffs(MapChunk *chunk) {
+	chunksWithDiffs.push_back(chunk);
+}
+
+void Map::addChunkToUpdate(MapChunk *chunk) {
+	chunksToUpdate.push_back(chunk);
+}
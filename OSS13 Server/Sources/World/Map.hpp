@@ -3,7 +3,10 @@
 #include <vector>
 
 #include "Shared/Types.hpp"
+#include "Shared/Arena.h"
+#include "Shared/ErrorHandling.h"
 #include "Tile.hpp"
+#include "MapChunk.hpp"
 #include "Atmos/Atmos.hpp"
 
 using std::vector;
@@ -11,21 +14,61 @@ using namespace uf;
 
 class Map {
 public:
+    friend MapChunk;
+
     explicit Map(const uint sizeX, const uint sizeY, const uint sizeZ);
 
+    // Per-tick passes touch only chunks which were changed since the last pass
     void ClearDiffs();
     void Update(std::chrono::microseconds timeElapsed);
 
     apos GetSize() const;
     Atmos *GetAtmos() const;
     Tile *GetTile(vec3i) const;
-    const vector<uptr<Tile>> &GetTiles() const;
+    // Chunk which contains tile with such position
+    MapChunk *GetChunk(vec3i) const;
+    // Fills result by chunks which overlap the area [from, from + areaSize)
+    void GetChunks(vec3i from, vec3i areaSize, vector<MapChunk *> &result) const;
+    const vector<uptr<MapChunk>> &GetChunks() const;
+
+    // Diffs are allocated from the per-tick arena and live until the next ClearDiffs
+    template<class T>
+    T *CreateDiff();
+    // Pointer for commands, which can outlive the tick: the arena isn't reused while they hold it
+    sptr<network::protocol::Diff> ShareDiff(network::protocol::Diff *diff) const;
+    const uf::Arena &GetDiffsArena() const;
+
+    // Views are built in parallel and only read the map, so changes are errors meanwhile
+    void SetReadOnly(bool readOnly) { this->readOnly = readOnly; }
+    bool IsReadOnly() const { return readOnly; }
+
+private:
+    void addChunkWithDiffs(MapChunk *chunk);
+    void addChunkToUpdate(MapChunk *chunk);
+    // Takes an arena which is not shared with any command
+    void recycleDiffsArena();
 
 private:
     apos size;
+    // number of chunks by every axis
+    apos chunksNum;
 
     uptr<Atmos> atmos;
+    bool readOnly{false};
+
+    vector<uptr<MapChunk>> chunks;
+    vector<MapChunk *> chunksWithDiffs;
+    vector<MapChunk *> chunksToUpdate;
+    // chunksToUpdate snapshot processed by current Update
+    vector<MapChunk *> chunksUpdating;
 
-    vector<uptr<Tile>> tiles;
-	uint flat_index(const apos c) const;
+    sptr<uf::Arena> diffsArena;
+    // Arenas of previous ticks whose diffs are still in network queues
+    vector<sptr<uf::Arena>> retiredArenas;
 };
+
+template<class T>
+T *Map::CreateDiff() {
+    EXPECT_WITH_MSG(!readOnly, "Map is changed while it's read only");
+    return diffsArena->Create<T>();
+}
@@ -0,0 +1,68 @@
+#include "MapChunk.hpp"
+
+#include <algorithm>
+
+#include <Shared/Array.hpp>
+#include <Shared/ErrorHandling.h>
+
+#include "Map.hpp"
+
+MapChunk::MapChunk(Map *map, apos origin, uf::vec2u size) :
+	map(map), origin(origin), size(size),
+	tilesToUpdate(nullptr)
+{
+	tiles.reserve(size.x * size.y);
+	for (uint y = 0; y < size.y; y++) {
+		for (uint x = 0; x < size.x; x++) {
+			tiles.emplace_back(map, this, apos(origin.x + x, origin.y + y, origin.z));
+		}
+	}
+}
+
+void MapChunk::ClearDiffs() {
+	diffs.clear();
+}
+
+void MapChunk::Update(std::chrono::microseconds timeElapsed) {
+	// Tiles registered while updating (neighbours, locale tiles) will be updated on the next pass,
+	// so every tile is updated at most once per tick
+	Tile *tile = tilesToUpdate;
+	tilesToUpdate = nullptr;
+	while (tile) {
+		Tile *next = tile->nextToUpdate;
+		tile->nextToUpdate = nullptr;
+		tile->update(timeElapsed);
+		tile = next;
+	}
+}
+
+void MapChunk::AddDiff(Tile *tile, network::protocol::Diff *diff, ObjectHandle object) {
+	EXPECT_WITH_MSG(!map->IsReadOnly(), "Map is changed while it's read only");
+	if (diffs.empty())
+		map->addChunkWithDiffs(this);
+
+	// Diffs are almost always added in creation order, so it's just push_back
+	auto iter = diffs.end();
+	if (!diffs.empty() && diffs.back().diff->GetDiffId() > diff->GetDiffId()) {
+		iter = std::upper_bound(diffs.begin(), diffs.end(), diff->GetDiffId(),
+			[](uint32_t id, const DiffRecord &record) { return id < record.diff->GetDiffId(); });
+	}
+	diffs.insert(iter, { diff, object, tile });
+}
+
+void MapChunk::AddTileToUpdate(Tile *tile) {
+	EXPECT_WITH_MSG(!map->IsReadOnly(), "Map is changed while it's read only");
+	if (!tilesToUpdate)
+		map->addChunkToUpdate(this);
+	tile->nextToUpdate = tilesToUpdate;
+	tilesToUpdate = tile;
+}
+
+Tile *MapChunk::GetTile(uf::vec2u pos) {
+	return &tiles[uf::flat_index(pos, size.x)];
+}
+
+apos MapChunk::GetOrigin() const { return origin; }
+uf::vec2u MapChunk::GetSize() const { return size; }
+Map *MapChunk::GetMap() const { return map; }
+const std::vector<MapChunk::DiffRecord> &MapChunk::GetDiffs() const { return diffs; }
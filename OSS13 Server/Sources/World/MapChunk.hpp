@@ -0,0 +1,62 @@
+#pragma once
+
+#include <vector>
+
+#include <Shared/Types.hpp>
+
+#include "Tile.hpp"
+#include "Objects/ObjectHandle.h"
+
+class Map;
+class Object;
+
+// Square part of one Z-level of the Map.
+// Tiles are stored by value in one contiguous block which is never reallocated,
+// so Tile pointers stay valid for the whole Map lifetime.
+class MapChunk {
+public:
+	static constexpr uint SIDE = 16;
+
+	// origin - absolute position of the first tile, size - chunk size (less than SIDE at the map border)
+	MapChunk(Map *map, apos origin, uf::vec2u size);
+
+	MapChunk(const MapChunk &) = delete;
+	MapChunk &operator=(const MapChunk &) = delete;
+
+	struct DiffRecord {
+		// Owned by the Map diffs arena
+		network::protocol::Diff *diff;
+		ObjectHandle object;
+		Tile *tile;
+	};
+
+	void ClearDiffs();
+	// Walks only tiles registered since the last pass
+	void Update(std::chrono::microseconds timeElapsed);
+
+	// Appends diff to the chunk stream. Stream is kept sorted by diff id.
+	void AddDiff(Tile *tile, network::protocol::Diff *diff, ObjectHandle object);
+	// Tile calls it when it should be updated on next Map::Update
+	void AddTileToUpdate(Tile *tile);
+
+	// pos - position relative to chunk origin
+	Tile *GetTile(uf::vec2u pos);
+	apos GetOrigin() const;
+	uf::vec2u GetSize() const;
+	Map *GetMap() const;
+	// All diffs of the chunk tiles since the last ClearDiffs
+	const std::vector<DiffRecord> &GetDiffs() const;
+
+private:
+	Map *map;
+	apos origin;
+	uf::vec2u size;
+
+	std::vector<Tile> tiles;
+
+	std::vector<DiffRecord> diffs;
+
+	// Head of intrusive list linked through Tile::nextToUpdate.
+	// Chunk is registered in Map dirty lists while its diffs stream or update list is not empty.
+	Tile *tilesToUpdate;
+};
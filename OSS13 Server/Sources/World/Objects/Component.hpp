@@ -2,11 +2,24 @@
 
 #include <string>
 #include <chrono>
+#include <cstdint>
 
 class Object;
 
+// Native component types. Every type has its own storage in ComponentRegistry
+// and its own slot in the object, so lookups by type don't hash strings.
+enum class ComponentType : uint8_t {
+	Control,
+	Count
+};
+
 class Component {
+	template<class T>
+	friend class ComponentStorage;
+
 	std::string id;
+	// Index in the storage of the component type
+	uint32_t storageSlot{0};
 
 protected:
 	Object *owner{};
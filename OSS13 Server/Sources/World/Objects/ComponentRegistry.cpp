@@ -0,0 +1,40 @@
+#include "ComponentRegistry.h"
+
+#include "Control.hpp"
+
+namespace {
+
+const std::array<std::string, size_t(ComponentType::Count)> COMPONENT_NAMES = {
+	"Control",
+};
+
+} // namespace
+
+ComponentRegistry::ComponentRegistry() {
+	storages[size_t(ComponentType::Control)] = std::make_unique<ComponentStorage<Control>>();
+
+	for (auto &storage : storages)
+		EXPECT_WITH_MSG(storage, "Component type has no storage!");
+}
+
+ComponentRegistry &ComponentRegistry::Get() {
+	static ComponentRegistry registry;
+	return registry;
+}
+
+ComponentType ComponentRegistry::GetType(const std::string &name) {
+	for (size_t i = 0; i < COMPONENT_NAMES.size(); i++) {
+		if (COMPONENT_NAMES[i] == name)
+			return ComponentType(i);
+	}
+	return ComponentType::Count;
+}
+
+const std::string &ComponentRegistry::GetName(ComponentType type) {
+	return COMPONENT_NAMES[size_t(type)];
+}
+
+void ComponentRegistry::Update(std::chrono::microseconds timeElapsed) {
+	for (auto &storage : storages)
+		storage->Update(timeElapsed);
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <deque>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <Shared/Types.hpp>
+#include <Shared/ErrorHandling.h>
+
+#include "Component.hpp"
+
+class ComponentStorageBase {
+public:
+	virtual ~ComponentStorageBase() = default;
+
+	virtual Component *Create() = 0;
+	virtual void Destroy(Component *) = 0;
+	// Updates all components of the type in one pass
+	virtual void Update(std::chrono::microseconds timeElapsed) = 0;
+
+	virtual size_t GetCount() const = 0;
+};
+
+// Dense storage of the components of one type. Slots of destroyed components are reused.
+// Components are referenced by pointers (from players and scripts), so they are never moved:
+// deque doesn't relocate elements when it grows.
+template<class T>
+class ComponentStorage : public ComponentStorageBase {
+public:
+	Component *Create() override {
+		uint32_t slot;
+		if (freeSlots.empty()) {
+			slot = uint32_t(slots.size());
+			slots.emplace_back();
+		} else {
+			slot = freeSlots.back();
+			freeSlots.pop_back();
+		}
+		T &component = slots[slot].emplace();
+		component.storageSlot = slot;
+		count++;
+		return &component;
+	}
+
+	void Destroy(Component *component) override {
+		const uint32_t slot = component->storageSlot;
+		EXPECT(slot < slots.size() && slots[slot] && &*slots[slot] == component);
+		slots[slot].reset();
+		freeSlots.push_back(slot);
+		count--;
+	}
+
+	void Update(std::chrono::microseconds timeElapsed) override {
+		for (auto &slot : slots) {
+			if (slot)
+				slot->T::Update(timeElapsed); // the type is known, so the call isn't virtual
+		}
+	}
+
+	size_t GetCount() const override { return count; }
+
+private:
+	std::deque<std::optional<T>> slots;
+	std::vector<uint32_t> freeSlots;
+	size_t count{0};
+};
+
+// Owns the storages of all native component types. Objects keep pointers to their components.
+class ComponentRegistry {
+public:
+	static ComponentRegistry &Get();
+
+	// ComponentType::Count if there is no component type with this name
+	static ComponentType GetType(const std::string &name);
+	static const std::string &GetName(ComponentType type);
+
+	ComponentStorageBase &GetStorage(ComponentType type) { return *storages[size_t(type)]; }
+
+	// One pass per component type
+	void Update(std::chrono::microseconds timeElapsed);
+
+private:
+	ComponentRegistry();
+
+private:
+	std::array<uptr<ComponentStorageBase>, size_t(ComponentType::Count)> storages;
+};
@@ -18,16 +18,20 @@ void Control::Update(std::chrono::microseconds timeElapsed) {
 	ui->Update(timeElapsed);
 }
 
+// Orders are handled by the owner update
 void Control::MoveCommand(uf::vec2i order) {
 	moveOrder = order;
+	wakeOwner();
 }
 
 void Control::MoveZCommand(bool order) {
 	moveZOrder = order?1:-1;
+	wakeOwner();
 }
 
 void Control::ClickObjectCommand(uint id) {
     clickedObjectID = id;
+	wakeOwner();
 }
 
 void Control::SetOwner(Object *owner) {
@@ -47,6 +51,11 @@ ControlUI *Control::GetUI() const { return ui.get(); }
 uf::vec2i Control::GetAndDropMoveOrder() { auto tmp = moveOrder; moveOrder = {}; return tmp; };
 int Control::GetAndDropMoveZOrder() { auto tmp = moveZOrder; moveZOrder = {}; return tmp; };
 
+void Control::wakeOwner() {
+	if (owner)
+		owner->Wake();
+}
+
 Object *Control::GetAndDropClickedObject() {
 	Object *obj = nullptr;
 	if (clickedObjectID) {
@@ -13,6 +13,8 @@ class Control : public Component {
 public:
     friend Player;
 
+	static constexpr ComponentType TYPE = ComponentType::Control;
+
     explicit Control();
 
     void Update(std::chrono::microseconds timeElapsed) override;
@@ -34,6 +36,10 @@ public:
 	int GetAndDropMoveZOrder();
 	Object *GetAndDropClickedObject();
 
+private:
+	friend ControlUI;
+	void wakeOwner();
+
 private:
 	float speed;
 	uint camera_seeInvisibleAbility{0}; // crutch. TODO: divide camera and control logics
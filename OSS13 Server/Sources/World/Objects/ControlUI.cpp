@@ -40,7 +40,8 @@ ControlUI::ControlUI(Control *control) :
 }
 
 void ControlUI::Update(std::chrono::microseconds /*timeElapsed*/) {
-	if (!updated)
+	// Changes are kept until a player takes the control
+	if (!updated || !control->GetPlayer())
 		return;
 	updated = false;
 
@@ -58,11 +59,13 @@ void ControlUI::Update(std::chrono::microseconds /*timeElapsed*/) {
 void ControlUI::UpdateElement(std::shared_ptr<ControlUIElement> element) {
 	elements[element->GetId()] = std::move(element);
 	updated = true;
+	control->wakeOwner();
 }
 
 void ControlUI::RemoveElement(const std::string &key) {
 	elements.erase(key);
 	updated = true;
+	control->wakeOwner();
 }
 
 uf::vec2i ControlUI::GetResolution() const { return { Global::control_ui::SIDE_SIZE, Global::control_ui::SIDE_SIZE }; }
@@ -8,6 +8,7 @@
 #include <World/World.hpp>
 #include <World/Map.hpp>
 #include <World/Objects/Control.hpp>
+#include <World/Objects/ComponentRegistry.h>
 
 #include <Shared/Math.hpp>
 #include <Shared/Physics/MovePhysics.hpp>
@@ -23,14 +24,22 @@ Object::Object() :
     moveSpeed(0)
 { }
 
+Object::~Object() {
+	// Callback of the animation can refer to the object
+	if (GGame)
+		GGame->GetTimers()->Cancel(animationTimer);
+
+	auto &registry = ComponentRegistry::Get();
+	for (size_t type = 0; type < components.size(); type++) {
+		if (components[type])
+			registry.GetStorage(ComponentType(type)).Destroy(components[type]);
+	}
+}
+
 void Object::Update(std::chrono::microseconds timeElapsed) {
 	if (!GetTile())
 		return;
 
-	for (auto &idAndComponent : components) {
-		idAndComponent.second->Update(timeElapsed);
-	}
-
 	uf::vec2f deltaShift = uf::phys::countDeltaShift(sf::microseconds(timeElapsed.count()), shift, moveSpeed, moveIntent, speed);
 	shift += deltaShift;
 
@@ -62,17 +71,27 @@ void Object::Update(std::chrono::microseconds timeElapsed) {
 
 	if (iconsOutdated) {
 		updateIcons();
-		auto diff = std::make_shared<network::protocol::UpdateIconsDiff>();
+		auto *diff = GetTile()->GetMap()->CreateDiff<network::protocol::UpdateIconsDiff>();
 		diff->objId = ID();
 		for (auto &iconInfo : icons)
 			diff->iconsIds.push_back(iconInfo.id + static_cast<uint32_t>(iconInfo.state));
 		GetTile()->AddDiff(diff, this);
 		iconsOutdated = false;
 	}
+}
 
-	animationTimer.Update(timeElapsed);
+void Object::Wake() {
+	if (markedToBeDeleted)
+		return;
+	wakeRequested = true;
+	if (!awake && objectHolder) {
+		awake = true;
+		objectHolder->wake(this);
+	}
 }
 
+bool Object::IsAwake() const { return awake; }
+
 void Object::Move(uf::vec2i order) {
 	if (!order)
 		return;
@@ -114,26 +133,26 @@ void Object::Move(uf::vec2i order) {
 	}
 }
 
-void Object::AddComponent(Component *new_component) {
-	if (!new_component) return;
-	new_component->SetOwner(this);
-	components[new_component->ID()] = uptr<Component>(new_component);
+void Object::AddComponent(const std::string &id) {
+	ComponentType type = ComponentRegistry::GetType(id);
+	EXPECT_WITH_MSG(type != ComponentType::Count, "Unknown component \"" + id + "\"");
+	addComponent(type);
 }
 
-void Object::AddComponent(const std::string &id) {
-	uptr<Component> component;
-	if (id == "Control") {
-		component.reset(new Control());	
-	}
+Component *Object::GetComponent(const std::string &id) {
+	ComponentType type = ComponentRegistry::GetType(id);
+	if (type == ComponentType::Count)
+		return nullptr;
+	return components[size_t(type)];
+}
 
-	if (component) {
+Component *Object::addComponent(ComponentType type) {
+	Component *&component = components[size_t(type)];
+	if (!component) {
+		component = ComponentRegistry::Get().GetStorage(type).Create();
 		component->SetOwner(this);
-		components[component->ID()] = std::move(component);
 	}
-}
-
-Component *Object::GetComponent(const std::string &id) {
-	return components[id].get();
+	return component;
 }
 
 void Object::AddObject(Object *obj) {
@@ -171,6 +190,7 @@ void Object::Delete() {
 }
 
 uint Object::ID() const { return id; }
+ObjectHandle Object::GetHandle() const { return { id, generation }; }
 
 const std::string &Object::GetName() const { return name; }
 void Object::SetName(const std::string& name) { this->name = name; };
@@ -189,31 +209,51 @@ void Object::SetSpriteState(Global::ItemSpriteState newState) {
 }
 
 bool Object::PlayAnimation(const std::string &animation, std::function<void()> callback) {
-	if (!animationTimer.IsStopped())
+	if (GGame->GetTimers()->IsPending(animationTimer))
 		return false;
 
 	auto iconInfo = IServer::RM()->GetIconInfo(animation);
 
-	auto playAnimationDiff = std::make_shared<network::protocol::PlayAnimationDiff>();
+	auto *playAnimationDiff = GetTile()->GetMap()->CreateDiff<network::protocol::PlayAnimationDiff>();
 	playAnimationDiff->objId = ID();
 	playAnimationDiff->animationId = iconInfo.id;
 
-	GetTile()->AddDiff(std::move(playAnimationDiff), this);
+	GetTile()->AddDiff(playAnimationDiff, this);
 
-	animationTimer.Start(iconInfo.animation_time, std::forward<std::function<void()>>(callback));
+	animationTimer = GGame->GetTimers()->Add(iconInfo.animation_time, [this, callback = std::move(callback)] {
+		if (callback)
+			callback();
+		Wake();
+	});
 	return true;
 }
 
 bool Object::GetDensity() const { return solidity.IsExistsOne({Direction::CENTER}); };
-void Object::SetDensity(bool density) { density ? solidity.Add({Direction::CENTER}) : solidity.Remove({Direction::CENTER}); }
+void Object::SetDensity(bool density) {
+	uf::DirectionSet newSolidity = solidity;
+	density ? newSolidity.Add({Direction::CENTER}) : newSolidity.Remove({Direction::CENTER});
+	SetSolidity(newSolidity);
+}
 
-void Object::SetSolidity(uf::DirectionSet directions) { solidity = directions; }
+void Object::SetSolidity(uf::DirectionSet directions) {
+	// Tile aggregates solidity of its content. Objects inside another object aren't in the content.
+	Tile *contentTile = holder ? nullptr : tile;
+	if (contentTile)
+		contentTile->removeSolidity(solidity);
+	solidity = directions;
+	if (contentTile)
+		contentTile->addSolidity(solidity);
+}
 const uf::DirectionSet &Object::GetSolidity() const { return solidity; }
 
 void Object::SetOpacity(uf::DirectionSetFractional fractionalDirections) { opacity = fractionalDirections; }
 const uf::DirectionSetFractional &Object::GetOpacity() const { return opacity; };
 
-void Object::SetAirtightness(uf::DirectionSetFractional fractionalDirections) {airtightness = fractionalDirections; }
+void Object::SetAirtightness(uf::DirectionSetFractional fractionalDirections) {
+	airtightness = fractionalDirections;
+	if (tile && !holder)
+		tile->invalidateAtmos();
+}
 const uf::DirectionSetFractional &Object::GetAirtightness() const { return airtightness; }
 
 void Object::SetPosition(uf::vec2i newPos) {
@@ -249,7 +289,11 @@ void Object::SetTile(Tile *tile) {
 void Object::SetMoveSpeed(float speed) { this->moveSpeed = speed; }
 float Object::GetMoveSpeed() const { return moveSpeed; }
 
-void Object::SetSpeed(uf::vec2f speed) { this->speed = speed; }
+void Object::SetSpeed(uf::vec2f speed) {
+	this->speed = speed;
+	if (speed)
+		Wake();
+}
 uf::vec2f Object::GetSpeed() const { return speed; }
 
 Object *Object::GetHolder() const { return holder; }
@@ -275,13 +319,15 @@ void Object::SetInvisibility(uint invisibility) { this->invisibility = invisibil
 
 void Object::SetMoveIntent(uf::vec2i moveIntent) {
 	if (tile) {
-		auto moveIntentDiff = std::make_shared<network::protocol::MoveIntentDiff>();
+		auto *moveIntentDiff = tile->GetMap()->CreateDiff<network::protocol::MoveIntentDiff>();
 		moveIntentDiff->objId = ID();
 		moveIntentDiff->direction = uf::VectToDirection(moveIntent);
-		tile->AddDiff(std::move(moveIntentDiff), this);
+		tile->AddDiff(moveIntentDiff, this);
 	}
 	if (moveIntent.x) this->moveIntent.x = moveIntent.x;
 	if (moveIntent.y) this->moveIntent.y = moveIntent.y;
+	if (moveIntent)
+		Wake();
 }
 
 uf::vec2i Object::GetMoveIntent() const {
@@ -293,10 +339,10 @@ void Object::SetDirection(uf::Direction direction) {
         direction = uf::Direction(char(direction) % 4);
     this->direction = direction;
 	if (tile) {
-		auto changeDirectionDiff = std::make_shared<network::protocol::ChangeDirectionDiff>();
+		auto *changeDirectionDiff = tile->GetMap()->CreateDiff<network::protocol::ChangeDirectionDiff>();
 		changeDirectionDiff->objId = ID();
 		changeDirectionDiff->direction = direction;
-		tile->AddDiff(std::move(changeDirectionDiff), this);
+		tile->AddDiff(changeDirectionDiff, this);
 	}
 }
 
@@ -338,10 +384,20 @@ void Object::pushToIcons(const IconInfo &icon) {
 
 void Object::askToUpdateIcons() {
 	iconsOutdated = true;
+	Wake();
 }
 
 void Object::setTile(Tile *newTile) {
 	tile = newTile;
 	for (auto *obj: content)
 		obj->setTile(newTile);
+	// Icons aren't updated without tile
+	if (tile && iconsOutdated)
+		Wake();
+}
+
+bool Object::isActive() const {
+	if (!tile)
+		return false;
+	return speed || shift || (moveIntent && moveSpeed) || iconsOutdated;
 }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <array>
 #include <string>
 #include <list>
 #include <vector>
@@ -7,11 +8,12 @@
 
 #include <VerbsHolder.h>
 #include <World/Objects/Component.hpp>
+#include <World/Objects/ObjectHandle.h>
 #include <Resources/IconInfo.h>
 
 #include <Shared/Types.hpp>
 #include <Shared/Global.hpp>
-#include <Shared/Timer.h>
+#include <Shared/TimerWheel.h>
 #include <Shared/IFaces/INonCopyable.h>
 #include <Shared/Geometry/DirectionSet.h>
 #include <Shared/Network/Protocol/ServerToClient/WorldInfo.h>
@@ -25,19 +27,27 @@ class Object : public VerbsHolder, public INonCopyable {
 
 public:
 	Object(); // Use ObjectHolder to create objects!
-	virtual ~Object() = default;
+	virtual ~Object();
 
     virtual void Update(std::chrono::microseconds timeElapsed);
 
+	// Only awake objects are updated. Movement, icons update, control commands and animation end wake the object.
+	// It falls asleep after an update with nothing to do, unless Wake is called during the update.
+	void Wake();
+	bool IsAwake() const;
+
 	virtual bool InteractedBy(Object *) = 0;
 
 	virtual void Move(uf::vec2i order);
 	virtual void MoveZ(int order) {};
 
-	void AddComponent(Component *);
+	// Does nothing if the object has the component already
 	void AddComponent(const std::string &componentId);
+	template<class T>
+	T *AddComponent();
+	// nullptr if the object hasn't such component
 	Component *GetComponent(const std::string &componentId);
-	template<class T> 
+	template<class T>
 	T *GetComponent();
 
 	void AddObject(Object *);
@@ -46,6 +56,7 @@ public:
     virtual void Delete();
 
     uint ID() const;
+	ObjectHandle GetHandle() const;
 
     const std::string &GetName() const;
 	void SetName(const std::string& name);
@@ -86,7 +97,6 @@ public:
 
 	Object *GetHolder() const;
 	virtual sptr<Object> GetOwnershipPointer() = 0;
-	bool CheckIfJustCreated() { return justCreated ? justCreated = false, true : false; }; // TODO: remove this
 	bool CheckIfMarkedToBeDeleted() { return markedToBeDeleted; }
 	int IncreaseDeleteAttempts() { return ++deleteAttempts; }
 
@@ -124,13 +134,17 @@ public:
 private:
 	// for use from Tile
 	void setTile(Tile *);
+	// True if the next update has something to do
+	bool isActive() const;
+	Component *addComponent(ComponentType type);
 
 protected:
     std::string name;
     bool movable;
     std::string sprite;
 	Global::ItemSpriteState spriteState; // TODO: move it to Item? Also there is need to reimplement packing???
-	uf::Timer animationTimer;
+	// Animation is playing while the timer is pending
+	uf::TimerWheel::Handle animationTimer;
     // Object layer 0-100. The smaller layer is lower.
     uint layer;
     uf::Direction direction;
@@ -149,10 +163,13 @@ protected:
 
 private:
 	uint id;
+	// Distinguishes objects with reused id
+	uint32_t generation{0};
     Tile *tile;
 	Object *holder;
 	std::list<Object *> content;
-	std::unordered_map<std::string, uptr<Component>> components;
+	// Components are owned by ComponentRegistry, slot per component type
+	std::array<Component *, size_t(ComponentType::Count)> components{};
 
 	// Movement
 	float moveSpeed;
@@ -165,16 +182,18 @@ private:
 
     uf::vec2f shift;
 
-	bool justCreated{true};
+	ObjectHolder *objectHolder{nullptr};
+	bool awake{false};
+	bool wakeRequested{false};
 	bool markedToBeDeleted{false};
 	int deleteAttempts{0};
 	bool iconsOutdated{true};
 };
 
+template <class T> T *Object::AddComponent() {
+	return static_cast<T *>(addComponent(T::TYPE));
+}
+
 template <class T> T *Object::GetComponent() {
-	for (auto &idAndComponent : components) {
-		if (auto temp = dynamic_cast<T *>(idAndComponent.second.get()))
-			return temp;
-	}
-	return nullptr;
+	return static_cast<T *>(components[size_t(T::TYPE)]);
 }
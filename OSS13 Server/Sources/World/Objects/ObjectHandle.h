@@ -0,0 +1,14 @@
+#pragma once
+
+#include <cstdint>
+
+// Weak reference to an object of the World. It doesn't keep the object alive:
+// World::GetObject returns nullptr for a deleted object, even if its id is taken by another one.
+struct ObjectHandle {
+	uint32_t id{0};
+	uint32_t generation{0};
+
+	explicit operator bool() const { return id != 0; }
+	bool operator==(const ObjectHandle &other) const { return id == other.id && generation == other.generation; }
+	bool operator!=(const ObjectHandle &other) const { return !(*this == other); }
+};
@@ -22,6 +22,7 @@ Object *ObjectHolder::CreateScriptObject(const std::string &module, apos coords)
 }
 
 void ObjectHolder::AddObject(std::shared_ptr<Object> obj) {
+	obj->generation = ++lastGeneration;
 	if (free_ids.empty()) {
 		objects.push_back(obj);
 		obj->id = uint32_t(objects.size());
@@ -31,6 +32,37 @@ void ObjectHolder::AddObject(std::shared_ptr<Object> obj) {
 		objects[id - 1] = obj;
 		obj->id = id;
 	}
+	obj->objectHolder = this;
+	// New object is updated once at least to send its icons
+	obj->Wake();
+}
+
+void ObjectHolder::updateAwakeObjects(std::chrono::microseconds timeElapsed) {
+	std::swap(awakeObjects, updatingObjects);
+	size_t i = 0;
+	try {
+		for (; i < updatingObjects.size(); i++) {
+			Object *object = updatingObjects[i];
+			if (object->CheckIfMarkedToBeDeleted()) // will be deleted on the next tick
+				continue;
+			object->wakeRequested = false;
+			object->Update(timeElapsed);
+			if (object->wakeRequested || object->isActive())
+				awakeObjects.push_back(object);
+			else
+				object->awake = false;
+		}
+	} catch (...) {
+		// Failed object and the rest of the pass stay awake
+		awakeObjects.insert(awakeObjects.end(), updatingObjects.begin() + i, updatingObjects.end());
+		updatingObjects.clear();
+		throw;
+	}
+	updatingObjects.clear();
+}
+
+void ObjectHolder::wake(Object *obj) {
+	awakeObjects.push_back(obj);
 }
 
 void ObjectHolder::placeTo(Object *obj, Tile *tile) {
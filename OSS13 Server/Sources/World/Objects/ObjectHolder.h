@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chrono>
 #include <vector>
 
 #include <Shared/Types.hpp>
@@ -7,6 +8,8 @@
 #include "Object.hpp"
 
 class ObjectHolder {
+	friend Object;
+
 public:
 	virtual ~ObjectHolder() = default;
 
@@ -21,13 +24,27 @@ public:
 
 	void AddObject(std::shared_ptr<Object> obj);
 
+	size_t GetObjectsCount() const { return objects.size() - free_ids.size(); }
+	size_t GetAwakeObjectsCount() const { return awakeObjects.size(); }
+
+protected:
+	// Updates awake objects. Objects woken during the pass are updated on the next call.
+	void updateAwakeObjects(std::chrono::microseconds timeElapsed);
+
 private:
+	void wake(Object *);
 	void placeTo(Object *, Tile *);
 	Tile *getTile(apos);
 
 protected: // TODO: make it private!
 	std::vector<sptr<Object>> objects;
 	std::vector<uint> free_ids;
+	uint32_t lastGeneration{0};
+	// Objects to update on the next tick
+	std::vector<Object *> awakeObjects;
+
+private:
+	std::vector<Object *> updatingObjects;
 };
 
 namespace detail {
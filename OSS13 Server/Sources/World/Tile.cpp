@@ -6,92 +6,43 @@
 #include <Resources/ResourceManager.hpp>
 #include <World/World.hpp>
 #include <World/Map.hpp>
+#include <World/MapChunk.hpp>
 #include <World/Objects.hpp>
 #include <World/Atmos/Atmos.hpp>
 #include <Shared/Network/Protocol/ServerToClient/WorldInfo.h>
 
-Tile::Tile(Map *map, apos pos) :
-    map(map), pos(pos),
-    hasFloor(false), fullBlocked(false), directionsBlocked(4, false),
-    locale(nullptr), needToUpdateLocale(false), gases(int(Gas::Count), 0)
+Tile::Tile(Map *map, MapChunk *chunk, apos pos) :
+    map(map), chunk(chunk), pos(pos),
+    solidityCounters(),
+    hasFloor(false), fullBlocked(false),
+    locale(nullptr), needToUpdateLocale(false), countedAsSpace(true),
+    splitMark(0), splitSearch(0), atmosOutdated(false),
+    nextToUpdate(nullptr)
 {
     uint ux = uint(pos.x);
     uint uy = uint(pos.y);
 	icon = IServer::RM()->GetIconInfo("space");
 	icon.id += ((ux + uy) ^ ~(ux * uy)) % 25;
-
-    totalPressure = 0;
 }
 
-void Tile::Update(std::chrono::microseconds timeElapsed) {
+void Tile::update(std::chrono::microseconds timeElapsed) {
     // Update locale, if wall/floor state was changed
     if (needToUpdateLocale) {
-        // Atmos-available tile
-        if (hasFloor && !fullBlocked) {
-            for (int dx = -1; dx <= 1; dx++)
-                for (int dy = -1; dy <= 1; dy++) {
-                    Tile *neighbour = map->GetTile(pos + rpos(dx, dy, 0));
-                    if (!neighbour ||
-                        dx == 0 && dy == 0 ||
-                        dx * dy != 0) // diag tiles
-                        continue;
-                    if (neighbour->locale) {
-                        if (locale) {
-                            locale->Merge(neighbour->locale);
-                        } else {
-                            neighbour->locale->AddTile(this);
-                            locale = neighbour->locale;
-                        }
-                    }
-                }
-            if (!locale) {
-                map->GetAtmos()->CreateLocale(this);
-            }
-        } else { // Space
-            if (!hasFloor && !fullBlocked) {
-                for (int dx = -1; dx <= 1; dx++)
-                    for (int dy = -1; dy <= 1; dy++) {
-                        Tile *neighbour = map->GetTile(pos + rpos(dx, dy, 0));
-                        if (!neighbour ||
-                            dx == 0 && dy == 0 ||
-                            dx * dy != 0) // diag tiles
-                            continue;
-                        if (neighbour->locale) {
-                            neighbour->locale->Open();
-                        }
-                    }
-                if (locale) locale->RemoveTile(this);
-            } else { // fullBlocked
-                // if here was locale then remove it
-                if (locale) { 
-                    map->GetAtmos()->RemoveLocale(locale);
-                }
-                // if here was a space then we need to update neighbors locals 
-                // so we delete them, after that Atmos::Update recreate them
-                for (int dx = -1; dx <= 1; dx++)
-                    for (int dy = -1; dy <= 1; dy++) {
-                        Tile *neighbour = map->GetTile(pos + rpos(dx, dy, 0));
-                        if (!neighbour ||
-                            dx == 0 && dy == 0 ||
-                            dx * dy != 0) // diag tiles
-                            continue;
-                        if (neighbour->locale) {
-                            neighbour->locale->CheckCloseness();
-                        }
-                    }
-            }
-        }
+        map->GetAtmos()->UpdateLocale(this);
         needToUpdateLocale = false;
     }
 }
 
 void Tile::CheckLocale() {
-    needToUpdateLocale = true;
+    if (!needToUpdateLocale) {
+        needToUpdateLocale = true;
+        chunk->AddTileToUpdate(this);
+    }
 }
 
 bool Tile::RemoveObject(Object *obj) {
 	if (removeObject(obj)) {
-		auto diff = std::make_shared<network::protocol::RemoveDiff>();
+		auto *diff = map->CreateDiff<network::protocol::RemoveDiff>();
 		diff->objId = obj->ID();
 		AddDiff(diff, obj);
 		return true;
@@ -107,12 +58,8 @@ bool Tile::MoveTo(Object *obj) {
 		return false;
 	}
 
-	if (obj->GetDensity())
-		for (auto &object : content)
-			if (object)
-				if (object->GetDensity()) {
-					return false;
-				}
+	if (obj->GetDensity() && IsDense())
+		return false;
 
 	Tile *lastTile = obj->GetTile();
 	rpos delta = GetPos() - lastTile->GetPos();
@@ -122,15 +69,15 @@ bool Tile::MoveTo(Object *obj) {
 		LOGW << "Warning! Moving between Z-levels. (Tile::MoveTo)";
 	const uf::Direction direction = uf::VectToDirection(delta);
 
-	auto relocateAwayDiff = std::make_shared<network::protocol::RelocateAwayDiff>(); // TODO: MoveAway???
+	auto *relocateAwayDiff = map->CreateDiff<network::protocol::RelocateAwayDiff>(); // TODO: MoveAway???
 	relocateAwayDiff->objId = obj->ID();
 	relocateAwayDiff->newCoords = pos;
 
-	lastTile->AddDiff(std::move(relocateAwayDiff), obj);
+	lastTile->AddDiff(relocateAwayDiff, obj);
 
 	addObject(obj);
 
-	auto moveDiff = std::make_shared<network::protocol::MoveDiff>();
+	auto *moveDiff = map->CreateDiff<network::protocol::MoveDiff>();
 	moveDiff->objId = obj->ID();
 	moveDiff->direction = direction;
 	moveDiff->speed = obj->GetMoveSpeed();
@@ -151,7 +98,7 @@ void Tile::PlaceTo(Object *obj) {
 		if (hasFloor) {
 			for (auto iter = content.begin(); iter != content.end(); iter++) {
 				if ((*iter)->IsFloor()) {
-					content.erase(iter);
+					eraseContent(iter);
 					break;
 				}
 			}
@@ -166,7 +113,7 @@ void Tile::PlaceTo(Object *obj) {
 		if (fullBlocked) {
 			for (auto iter = content.begin(); iter != content.end(); iter++) {
 				if ((*iter)->IsWall()) {
-					content.erase(iter);
+					eraseContent(iter);
 					break;
 				}
 			}
@@ -179,25 +126,27 @@ void Tile::PlaceTo(Object *obj) {
 	auto objInfo = obj->GetObjectInfo();
 
 	if (lastTile) {
-		auto relocateAwayDiff = std::make_shared<network::protocol::RelocateAwayDiff>();
+		auto *relocateAwayDiff = map->CreateDiff<network::protocol::RelocateAwayDiff>();
 		relocateAwayDiff->objId = obj->ID();
 		relocateAwayDiff->newCoords = pos;
 		lastTile->AddDiff(relocateAwayDiff, obj);
 	}
 	addObject(obj);
 
-	auto relocateDiff = std::make_shared<network::protocol::RelocateDiff>();
+	auto *relocateDiff = map->CreateDiff<network::protocol::RelocateDiff>();
 	relocateDiff->objId = obj->ID();
 	relocateDiff->newCoords = pos;
 	AddDiff(relocateDiff, obj);
 }
 
-const std::list<Object *> &Tile::Content() const {
+const TileContent &Tile::Content() const {
     return content;
 }
 
 Object *Tile::GetDenseObject() const
 {
+    if (!IsDense())
+        return nullptr;
     for (auto &obj : content)
         if (obj->GetDensity()) return obj;
     return nullptr;
@@ -208,17 +157,14 @@ uf::vec3i Tile::GetPos() const {
 }
 
 Map *Tile::GetMap() const { return map; }
+MapChunk *Tile::GetChunk() const { return chunk; }
 
 bool Tile::IsDense() const {
-    for (auto &obj : content)
-        if (obj->GetDensity()) return true;
-    return false;
+    return solidity.IsExistsOne({ uf::Direction::CENTER });
 }
 
 bool Tile::IsDense(const std::initializer_list<uf::Direction> &directions) const {
-	for (auto &obj : content)
-		if (obj->GetSolidity().IsExistsOne(directions)) return true;
-	return false;
+	return solidity.IsExistsOne(directions);
 }
 
 bool Tile::IsSpace() const {
@@ -226,7 +172,7 @@ bool Tile::IsSpace() const {
 }
 
 Locale *Tile::GetLocale() const {
-	return locale;
+	return locale ? locale->GetRoot() : nullptr;
 }
 
 network::protocol::TileInfo Tile::GetTileInfo(uint viewerId, uint visibility) const {
@@ -261,6 +207,8 @@ void Tile::addObject(Object *obj) {
 	while (iter != content.end() && (*iter)->GetLayer() <= obj->GetLayer())
 		iter++;
 	content.insert(iter, obj);
+	addSolidity(obj->GetSolidity());
+	invalidateAtmos();
 
 	obj->setTile(this);
 	obj->SetSpriteState(Global::ItemSpriteState::DEFAULT);
@@ -278,19 +226,50 @@ bool Tile::removeObject(Object *obj) {
 				fullBlocked = false;
 				CheckLocale();
 			}
-			obj->setTile(nullptr);
-			content.erase(iter);
+			eraseContent(iter);
 			return true;
 		}
 	}
 	return false;
 }
 
-void Tile::AddDiff(std::shared_ptr<network::protocol::Diff> diff, Object *obj) {
-	EXPECT(uf::CreateSerializableById(diff->Id())); // debug
-	differencesWithObject.push_back({diff, obj->GetOwnershipPointer()});
+void Tile::eraseContent(TileContent::iterator iter) {
+	(*iter)->setTile(nullptr);
+	removeSolidity((*iter)->GetSolidity());
+	content.erase(iter);
+	invalidateAtmos();
+}
+
+void Tile::invalidateAtmos() {
+	map->GetAtmos()->InvalidateTile(this);
+}
+
+void Tile::addSolidity(const uf::DirectionSet &objectSolidity) {
+	auto &directions = objectSolidity.GetBuffer();
+	if (directions.none())
+		return;
+	for (size_t i = 0; i < solidityCounters.size(); i++) {
+		if (directions[i])
+			solidityCounters[i]++;
+	}
+	solidity.Add(objectSolidity);
+}
+
+void Tile::removeSolidity(const uf::DirectionSet &objectSolidity) {
+	auto &directions = objectSolidity.GetBuffer();
+	if (directions.none())
+		return;
+	std::bitset<5> buffer = solidity.GetBuffer();
+	for (size_t i = 0; i < solidityCounters.size(); i++) {
+		if (directions[i]) {
+			EXPECT(solidityCounters[i]);
+			if (!--solidityCounters[i])
+				buffer[i] = false;
+		}
+	}
+	solidity.SetBuffer(buffer);
 }
 
-void Tile::ClearDiffs() {
-	differencesWithObject.clear();
+void Tile::AddDiff(network::protocol::Diff *diff, Object *obj) {
+	chunk->AddDiff(this, diff, obj->GetHandle());
 }
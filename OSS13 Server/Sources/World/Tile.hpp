@@ -1,7 +1,8 @@
 #pragma once
 
-#include <list>
 #include <vector>
+#include <array>
+#include <bitset>
 
 #include <SFML/System.hpp>
 
@@ -10,20 +11,26 @@
 
 #include <Shared/Global.hpp>
 #include <Shared/Types.hpp>
+#include <Shared/SmallVector.hpp>
 #include <Shared/Geometry/DirectionSet.h>
 #include <Shared/Network/Protocol/ServerToClient/WorldInfo.h>
 #include <Shared/Network/Protocol/ServerToClient/Diff.h>
 
 class Object;
 class Map;
+class MapChunk;
 class Locale;
+class Atmos;
+
+// Sorted by layer. Most tiles have a floor and a couple of objects, they fit inline.
+using TileContent = uf::SmallVector<Object *, 4>;
 
 class Tile {
 public:
-    friend Locale;
-    Tile(Map *map, apos pos);
-
-    void Update(std::chrono::microseconds timeElapsed);
+    friend MapChunk;
+    friend Object;
+    friend Atmos;
+    Tile(Map *map, MapChunk *chunk, apos pos);
 
     // Call it when atmos initialized or tile atmos properties changed (floor or wall status updated)
     void CheckLocale();
@@ -36,11 +43,12 @@ public:
 	// Teleport or add to tile from nowhere
     void PlaceTo(Object *);
 
-    const std::list<Object *> &Content() const;
+    const TileContent &Content() const;
     Object *GetDenseObject() const;
 
 	uf::vec3i GetPos() const;
     Map *GetMap() const;
+    MapChunk *GetChunk() const;
     bool IsDense() const;
 	bool IsDense(const std::initializer_list<uf::Direction> &directions) const;
     bool IsSpace() const;
@@ -48,9 +56,8 @@ public:
 
 	network::protocol::TileInfo GetTileInfo(uint viewerId, uint visibility) const;
 
-	void AddDiff(std::shared_ptr<network::protocol::Diff> diff, Object *object);
-    const std::vector<std::pair<std::shared_ptr<network::protocol::Diff>, sptr<Object>>> &GetDifferencesWithObject() const { return differencesWithObject; }
-    void ClearDiffs();
+	// Diff is appended to the chunk diffs stream
+	void AddDiff(network::protocol::Diff *diff, Object *object);
 
     int X() const { return pos.x; }
     int Y() const { return pos.y; }
@@ -58,28 +65,50 @@ public:
 
 private:
     Map *map;
+    MapChunk *chunk;
     uf::vec3i pos;
     IconInfo icon;
 
-    std::list<Object *> content;
+    TileContent content;
+    // Number of content objects solid in every direction of DirectionSet buffer
+    std::array<uint16_t, 5> solidityCounters;
+    // Directions in which some object is solid, so collision checks don't walk the content
+    uf::DirectionSet solidity;
     bool hasFloor;
     // true if has wall
     bool fullBlocked;
     // for thin walls
-    std::vector<bool> directionsBlocked;
+    std::bitset<4> directionsBlocked;
 
 
+    // Any locale of the set, GetLocale returns its root
     Locale *locale;
     bool needToUpdateLocale;
-    // Partional pressures of gases by index
-    std::vector<pressure> gases;
-    pressure totalPressure;
+    // Neighbour locales count edges with this tile as open to space
+    bool countedAsSpace;
+    // Last locale split search which visited the tile, and which of its searches
+    uint splitMark;
+    uint splitSearch;
+    // Waits in the Atmos list to pass its openness to the gas grid
+    bool atmosOutdated;
+
+    // Intrusive link of MapChunk "touched this tick" list
+    Tile *nextToUpdate;
 
-    std::vector<std::pair<std::shared_ptr<network::protocol::Diff>, sptr<Object>>> differencesWithObject;
+    // Called by MapChunk only for registered tiles
+    void update(std::chrono::microseconds timeElapsed);
 
     // Add object to the tile, and change object.tile pointer
     // For moving use MoveTo, for placing PlaceTo
     void addObject(Object *obj);
     // Not generate Diff
     bool removeObject(Object *obj);
+    // Erases object from content and aggregated solidity, and change object.tile pointer
+    void eraseContent(TileContent::iterator iter);
+
+    // Object calls them when solidity of the content object changes
+    void addSolidity(const uf::DirectionSet &objectSolidity);
+    void removeSolidity(const uf::DirectionSet &objectSolidity);
+    // Content or walls are changed, so gas flows differently
+    void invalidateAtmos();
 };
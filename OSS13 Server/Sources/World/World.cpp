@@ -1,12 +1,16 @@
 #include "World.hpp"
 
+#include <algorithm>
+
 #include "Map.hpp"
 #include "Tile.hpp"
 #include "Objects.hpp"
 #include "Objects/Control.hpp"
+#include "Objects/ComponentRegistry.h"
 #include "Player.hpp"
 
 #include <Shared/ErrorHandling.h>
+#include <Shared/Profiling/Profiler.h>
 
 using namespace std::string_literals;
 
@@ -16,6 +20,8 @@ World::World() :
 
 void World::Update(std::chrono::microseconds timeElapsed) {
 	map->ClearDiffs();
+	// Diffs refer to objects by handles, so objects marked on the previous tick are deleted only now
+	deleteMarkedObjects();
 
 	// Simple walking mob AI for moving testing
 	if (testMob) {
@@ -28,30 +34,42 @@ void World::Update(std::chrono::microseconds timeElapsed) {
 			if (test_dx == -1 && x == 47) test_dx = 0, test_dy = -1;
 			if (test_dy == -1 && y == 47) test_dx = 1, test_dy = 0;
 
-			dynamic_cast<Control *>(testMob->GetComponent("Control"))->MoveCommand(sf::Vector2i(test_dx, test_dy));
+			testMob->GetComponent<Control>()->MoveCommand(sf::Vector2i(test_dx, test_dy));
 		}
 	}
     
-    map->Update(timeElapsed);
+    {
+        PROFILE_SCOPE("tick/world/map");
+        map->Update(timeElapsed);
+    }
+
+    {
+        PROFILE_SCOPE("tick/world/components");
+        ComponentRegistry::Get().Update(timeElapsed);
+    }
 
     // update objects
+    PROFILE_SCOPE("tick/world/objects");
+    updateAwakeObjects(timeElapsed);
+}
+
+void World::deleteMarkedObjects() {
+	awakeObjects.erase(std::remove_if(awakeObjects.begin(), awakeObjects.end(), [](Object *object) {
+		return object->CheckIfMarkedToBeDeleted();
+	}), awakeObjects.end());
+
     for (uint i = 0; i < objects.size(); i++) {
-        if (!objects[i]) continue; // already deleted
-        if (objects[i]->CheckIfMarkedToBeDeleted()) {
-			// Broke cycle ref: PyObject <-> C++ Object
-			if (objects[i].use_count() > 2) { // Object can be captured by Tile's diffs list
-				auto deleteAttempts = objects[i]->IncreaseDeleteAttempts();
-				CHECK_WITH_MSG(deleteAttempts == 5, "Object (id="s + std::to_string(i) + ") wasn't deleted 5 times!"s);
-				CHECK_WITH_MSG(deleteAttempts == 20, "Object (id="s + std::to_string(i) + ") can't be deleted!"s);
-			} else {
-				objects[i].reset();
-				free_ids.push_back(i + 1);
-			}
-			continue;
-        }
-		if (objects[i]->CheckIfJustCreated()) // don't update objects created at current tick
-			continue;
-        objects[i]->Update(timeElapsed);
+        if (!objects[i] || !objects[i]->CheckIfMarkedToBeDeleted())
+            continue;
+		// Broke cycle ref: PyObject <-> C++ Object
+		if (objects[i].use_count() > 2) { // Object can be owned by someone else yet
+			auto deleteAttempts = objects[i]->IncreaseDeleteAttempts();
+			CHECK_WITH_MSG(deleteAttempts == 5, "Object (id="s + std::to_string(i) + ") wasn't deleted 5 times!"s);
+			CHECK_WITH_MSG(deleteAttempts == 20, "Object (id="s + std::to_string(i) + ") can't be deleted!"s);
+		} else {
+			objects[i].reset();
+			free_ids.push_back(i + 1);
+		}
     }
 }
 
@@ -82,6 +100,15 @@ Object *World::GetObject(uint id) const {
     return nullptr;
 }
 
+Object *World::GetObject(ObjectHandle handle) const {
+	if (!handle)
+		return nullptr;
+	Object *object = GetObject(handle.id);
+	if (!object || object->GetHandle() != handle)
+		return nullptr;
+	return object;
+}
+
 Map *World::GetMap() const {
 	return map.get();
 }
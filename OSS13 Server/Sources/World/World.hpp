@@ -20,8 +20,13 @@ public:
 	Object *CreateNewPlayerCreature();
 
     Object *GetObject(uint id) const;
+	// nullptr if the object is deleted
+	Object *GetObject(ObjectHandle handle) const;
 	Map *GetMap() const;
 
+private:
+    void deleteMarkedObjects();
+
 private:
     uptr<Map> map;
 
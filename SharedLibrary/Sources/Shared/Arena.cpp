@@ -0,0 +1,48 @@
+#include "Arena.h"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace uf {
+
+Arena::Arena(size_t blockSize) :
+	blockSize(blockSize)
+{ }
+
+Arena::~Arena() {
+	Reset();
+}
+
+void *Arena::Allocate(size_t size, size_t alignment) {
+	while (currentBlock < blocks.size()) {
+		auto &block = blocks[currentBlock];
+		const uintptr_t base = reinterpret_cast<uintptr_t>(block.data.get());
+		const size_t begin = ((base + offset + alignment - 1) & ~(alignment - 1)) - base;
+		if (begin + size <= block.size) {
+			offset = begin + size;
+			bytesUsed += size;
+			return block.data.get() + begin;
+		}
+		currentBlock++;
+		offset = 0;
+	}
+
+	// Oversized allocations get their own block
+	const size_t newBlockSize = std::max(blockSize, size + alignment);
+	blocks.push_back({ std::make_unique<char[]>(newBlockSize), newBlockSize });
+	currentBlock = blocks.size() - 1;
+	offset = 0;
+	return Allocate(size, alignment);
+}
+
+void Arena::Reset() {
+	for (auto iter = destructors.rbegin(); iter != destructors.rend(); iter++)
+		iter->destroy(iter->object);
+	destructors.clear();
+	currentBlock = 0;
+	offset = 0;
+	objectsCount = 0;
+	bytesUsed = 0;
+}
+
+} // namespace uf
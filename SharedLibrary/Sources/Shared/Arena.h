@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace uf {
+
+// Bump allocator for objects with the same lifetime: they are created one by one and destroyed all at once by Reset.
+// Memory blocks are kept after Reset, so in steady state the arena doesn't touch the heap at all.
+// Not thread-safe.
+class Arena {
+public:
+	explicit Arena(size_t blockSize = 64 * 1024);
+	~Arena();
+
+	Arena(const Arena &) = delete;
+	Arena &operator=(const Arena &) = delete;
+
+	template<class T, class... TArgs>
+	T *Create(TArgs &&... args);
+
+	void *Allocate(size_t size, size_t alignment);
+
+	// Destroys created objects in reverse order and rewinds to the first block
+	void Reset();
+
+	// Objects created since the last Reset
+	size_t GetObjectsCount() const { return objectsCount; }
+	// Bytes allocated since the last Reset
+	size_t GetBytesUsed() const { return bytesUsed; }
+	// Blocks taken from the heap for the whole arena lifetime
+	size_t GetBlocksCount() const { return blocks.size(); }
+
+private:
+	struct Block {
+		std::unique_ptr<char[]> data;
+		size_t size;
+	};
+
+	struct Destructor {
+		void (*destroy)(void *);
+		void *object;
+	};
+
+private:
+	const size_t blockSize;
+	std::vector<Block> blocks;
+	size_t currentBlock{0};
+	size_t offset{0};
+
+	std::vector<Destructor> destructors;
+	size_t objectsCount{0};
+	size_t bytesUsed{0};
+};
+
+template<class T, class... TArgs>
+T *Arena::Create(TArgs &&... args) {
+	T *object = new (Allocate(sizeof(T), alignof(T))) T(std::forward<TArgs>(args)...);
+	if constexpr (!std::is_trivially_destructible_v<T>)
+		destructors.push_back({ [](void *object) { static_cast<T *>(object)->~T(); }, object });
+	objectsCount++;
+	return object;
+}
+
+} // namespace uf
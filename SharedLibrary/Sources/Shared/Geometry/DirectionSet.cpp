@@ -9,15 +9,9 @@ constexpr size_t directionToIndex(Direction direction) {
 	return char(direction);
 }
 
-DirectionSet::DirectionSet(std::list<Direction> directions) {
-	Add(directions);
-}
-
-void DirectionSet::Add(DirectionSet directions) {
-	buffer |= directions.buffer;
-}
-
-void DirectionSet::Add(const std::list<Direction> &directions) {
+template<class Directions>
+std::bitset<5> DirectionSet::toBuffer(const Directions &directions) {
+	std::bitset<5> buffer;
 	for (auto direction : directions) {
 		if (direction == Direction::NONE)
 			continue;
@@ -29,30 +23,61 @@ void DirectionSet::Add(const std::list<Direction> &directions) {
 			buffer[directionToIndex(direction)] = true;
 		}
 	}
+	return buffer;
+}
+
+DirectionSet::DirectionSet(std::list<Direction> directions) {
+	Add(directions);
+}
+
+void DirectionSet::Add(DirectionSet directions) {
+	buffer |= directions.buffer;
+}
+
+void DirectionSet::Add(std::initializer_list<Direction> directions) {
+	buffer |= toBuffer(directions);
+}
+
+void DirectionSet::Add(const std::list<Direction> &directions) {
+	buffer |= toBuffer(directions);
 }
 
 void DirectionSet::Remove(DirectionSet directions) {
 	buffer &= ~directions.buffer;
 }
 
+void DirectionSet::Remove(std::initializer_list<Direction> directions) {
+	buffer &= ~toBuffer(directions);
+}
+
 void DirectionSet::Remove(const std::list<Direction> &directions) {
-	Remove(DirectionSet(directions));
+	buffer &= ~toBuffer(directions);
 }
 
 bool DirectionSet::IsExistsOne(DirectionSet directions) const {
 	return (buffer & directions.buffer).any();
 }
 
+bool DirectionSet::IsExistsOne(std::initializer_list<Direction> directions) const {
+	return (buffer & toBuffer(directions)).any();
+}
+
 bool DirectionSet::IsExistsOne(const std::list<Direction> &directions) const {
-	return IsExistsOne(DirectionSet(directions));
+	return (buffer & toBuffer(directions)).any();
 }
 
 bool DirectionSet::AreExistAll(DirectionSet directions) const {
 	return (buffer & directions.buffer) == directions.buffer;
 }
 
+bool DirectionSet::AreExistAll(std::initializer_list<Direction> directions) const {
+	const auto other = toBuffer(directions);
+	return (buffer & other) == other;
+}
+
 bool DirectionSet::AreExistAll(const std::list<Direction> &directions) const {
-	return AreExistAll(DirectionSet(directions));
+	const auto other = toBuffer(directions);
+	return (buffer & other) == other;
 }
 
 void DirectionSet::Reset() {
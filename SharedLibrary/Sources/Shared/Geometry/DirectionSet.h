@@ -20,16 +20,21 @@ public:
 	DirectionSet &operator=(const DirectionSet &) = default;
 	DirectionSet &operator=(DirectionSet &&) = default;
 
+	// initializer_list overloads don't allocate, std::list ones are for scripts
 	void Add(DirectionSet directions);
+	void Add(std::initializer_list<Direction> directions);
 	void Add(const std::list<Direction> &directions);
 
 	void Remove(DirectionSet directions);
+	void Remove(std::initializer_list<Direction> directions);
 	void Remove(const std::list<Direction> &directions);
 
 	bool IsExistsOne(DirectionSet directions) const;
+	bool IsExistsOne(std::initializer_list<Direction> directions) const;
 	bool IsExistsOne(const std::list<Direction> &directions) const;
 
 	bool AreExistAll(DirectionSet directions) const;
+	bool AreExistAll(std::initializer_list<Direction> directions) const;
 	bool AreExistAll(const std::list<Direction> &directions) const;
 
 	void Reset();
@@ -37,6 +42,10 @@ public:
 	const std::bitset<5> &GetBuffer() const;
 	void SetBuffer(std::bitset<5> buffer);
 
+private:
+	template<class Directions>
+	static std::bitset<5> toBuffer(const Directions &directions);
+
 private:
 	std::bitset<5> buffer;
 };
@@ -66,7 +75,7 @@ public:
 	void SetFractions(std::array<float, 5> &&fractions);
 
 private:
-	std::array<float, 5> fractions;
+	std::array<float, 5> fractions{};
 };
 
 }
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+namespace uf {
+
+// Unbounded lock-free queue for many producers and one consumer (Vyukov's node-based MPSC).
+// Push is one atomic exchange, Pop doesn't touch any shared counter.
+// Push is safe from any thread, everything else is for the consumer thread only.
+// The element pushed just now could be not visible for a moment, while its producer links it.
+template<class T>
+class MPSCQueue {
+public:
+	MPSCQueue();
+	~MPSCQueue();
+
+	MPSCQueue(const MPSCQueue &) = delete;
+	MPSCQueue &operator=(const MPSCQueue &) = delete;
+
+	void Push(T value);
+
+	// return false if the queue is empty
+	bool TryPop(T &value);
+	// Legacy interface of ThreadSafeQueue for pointers: nullptr if the queue is empty
+	T Pop();
+	// Calls func(T &&) for every available element, returns their number
+	template<class Func>
+	size_t Drain(Func &&func);
+
+	bool Empty() const;
+
+	// Blocks until the queue is not empty or timeout is over. return false on timeout.
+	bool Wait(std::chrono::microseconds timeout);
+
+private:
+	struct Node {
+		std::atomic<Node *> next{nullptr};
+		T value{};
+	};
+
+	// Producers append here
+	alignas(64) std::atomic<Node *> head;
+	// Consumer's stub node, the next one is the first element
+	alignas(64) Node *tail;
+
+	// Producers notify only if the consumer waits
+	std::atomic<bool> waiting{false};
+	std::mutex waitMutex;
+	std::condition_variable wakeup;
+};
+
+template<class T>
+MPSCQueue<T>::MPSCQueue() {
+	tail = new Node;
+	head.store(tail, std::memory_order_relaxed);
+}
+
+template<class T>
+MPSCQueue<T>::~MPSCQueue() {
+	while (tail) {
+		Node *next = tail->next.load(std::memory_order_relaxed);
+		delete tail;
+		tail = next;
+	}
+}
+
+template<class T>
+void MPSCQueue<T>::Push(T value) {
+	Node *node = new Node;
+	node->value = std::move(value);
+	Node *previous = head.exchange(node, std::memory_order_acq_rel);
+	previous->next.store(node, std::memory_order_release);
+
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (waiting.load(std::memory_order_relaxed)) {
+		std::unique_lock<std::mutex> lock(waitMutex);
+		wakeup.notify_one();
+	}
+}
+
+template<class T>
+bool MPSCQueue<T>::TryPop(T &value) {
+	Node *next = tail->next.load(std::memory_order_acquire);
+	if (!next)
+		return false;
+	value = std::move(next->value);
+	delete tail;
+	tail = next;
+	return true;
+}
+
+template<class T>
+T MPSCQueue<T>::Pop() {
+	T value{};
+	TryPop(value);
+	return value;
+}
+
+template<class T>
+template<class Func>
+size_t MPSCQueue<T>::Drain(Func &&func) {
+	size_t count = 0;
+	T value;
+	while (TryPop(value)) {
+		func(std::move(value));
+		count++;
+	}
+	return count;
+}
+
+template<class T>
+bool MPSCQueue<T>::Empty() const {
+	return !tail->next.load(std::memory_order_acquire);
+}
+
+template<class T>
+bool MPSCQueue<T>::Wait(std::chrono::microseconds timeout) {
+	if (!Empty())
+		return true;
+
+	std::unique_lock<std::mutex> lock(waitMutex);
+	waiting.store(true, std::memory_order_relaxed);
+	// Pairs with the fence of Push: either the producer sees waiting, or we see its element
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	bool ready = wakeup.wait_for(lock, timeout, [this] { return !Empty(); });
+	waiting.store(false, std::memory_order_relaxed);
+	return ready;
+}
+
+} // namespace uf
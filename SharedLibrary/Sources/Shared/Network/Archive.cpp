@@ -9,15 +9,24 @@ using namespace uf;
 // Archive
 
 Archive::Archive(sf::Packet &packet) :
-	packet(packet)
+	packet(&packet),
+	buffer(nullptr),
+	memoryResource(nullptr),
+	names(nullptr),
+	omitNextId(false)
 { }
 
-#define DECLARE_SER(name) \
-	case #name##_crc32: { uptr<ISerializable> p = std::make_unique<name>(); p->Serialize(*this); return p; }
+Archive::Archive(Buffer &buffer) :
+	packet(nullptr),
+	buffer(&buffer),
+	memoryResource(nullptr),
+	names(nullptr),
+	omitNextId(false)
+{ }
 
 uptr<ISerializable> Archive::UnpackSerializable() {
-	sf::Int32 id;
-	packet >> id;
+	sf::Int32 id = 0;
+	serialize(id);
 
 	auto serializable = CreateSerializableById(id);
 	serializable->Serialize(*this);
@@ -25,6 +34,34 @@ uptr<ISerializable> Archive::UnpackSerializable() {
 	return serializable;
 }
 
+sptr<ISerializable> Archive::unpackSharedSerializable() {
+	if (!memoryResource)
+		return UnpackSerializable();
+
+	sf::Int32 id = 0;
+	serialize(id);
+
+	auto serializable = CreateSharedSerializableById(id, memoryResource);
+	serializable->Serialize(*this);
+
+	return serializable;
+}
+
+void Archive::WriteBytes(const void *data, std::size_t size) {
+	EXPECT(!isOut);
+	if (buffer)
+		buffer->Append(data, size);
+	else
+		packet->append(data, size);
+}
+
+void Archive::SetMemoryResource(std::pmr::memory_resource *resource) {
+	memoryResource = resource;
+}
+
+void Archive::SetCompact(NameTable *names) {
+	this->names = names;
+}
 
 // InputArchive
 
@@ -34,6 +71,12 @@ InputArchive::InputArchive(sf::Packet &packet) :
 	isOut = false;
 }
 
+InputArchive::InputArchive(Buffer &buffer) :
+	Archive(buffer)
+{
+	isOut = false;
+}
+
 // OutputArchive
 
 OutputArchive::OutputArchive(sf::Packet &packet) :
@@ -41,3 +84,9 @@ OutputArchive::OutputArchive(sf::Packet &packet) :
 { 
 	isOut = true;
 }
+
+OutputArchive::OutputArchive(Buffer &buffer) :
+	Archive(buffer)
+{
+	isOut = true;
+}
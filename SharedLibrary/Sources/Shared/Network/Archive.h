@@ -1,16 +1,23 @@
 #pragma once
 
 #include <any>
+#include <memory_resource>
+#include <utility>
 #include <SFML/Network/Packet.hpp>
 
 #include <Shared/Types.hpp>
 #include <Shared/Network/ISerializable.h>
+#include <Shared/Network/Buffer.h>
 
 namespace uf {
 
+class NameTable;
+
+// Serializes into sf::Packet or into uf::Buffer. Both backends produce the same bytes.
 class Archive  {
 public:
 	Archive(sf::Packet &packet);
+	Archive(Buffer &buffer);
 	virtual ~Archive() = default;
 
 	template<class T>
@@ -40,13 +47,37 @@ public:
 	uptr<ISerializable> UnpackSerializable();
 	bool IsOutput() { return isOut; }
 
+	// Append already serialized data (input archive only)
+	void WriteBytes(const void *data, std::size_t size);
+
+	// Shared serializables (e.g. diffs) will be allocated from the resource while unpacking.
+	// Resource should outlive all unpacked objects. nullptr - use the heap.
+	void SetMemoryResource(std::pmr::memory_resource *resource);
+
+	// Compact wire mode: varints, skipped default fields and interned names (see Compact.h).
+	// Both sides should use the same mode and synchronized name tables.
+	void SetCompact(NameTable *names);
+	bool IsCompact() const { return names != nullptr; }
+	NameTable *GetNameTable() const { return names; }
+
+	// In compact mode coordinates are encoded as deltas from origin
+	void SetCoordsOrigin(vec3i origin) { coordsOrigin = origin; }
+	vec3i GetCoordsOrigin() const { return coordsOrigin; }
+
+	// Next ISerializable::Serialize won't write type id. For structs of known type in compact mode.
+	void OmitNextId() { omitNextId = true; }
+	bool TakeOmitNextId() { return std::exchange(omitNextId, false); }
+
 protected:
 	template<class T>
 	void serialize(T &ser) {
-		if (isOut)
-			packet >> ser;
-		else
-			packet << ser;
+		if (isOut) {
+			if (buffer) *buffer >> ser;
+			else *packet >> ser;
+		} else {
+			if (buffer) *buffer << ser;
+			else *packet << ser;
+		}
 	}
 
 	template<class T>
@@ -60,26 +91,35 @@ protected:
 	template<class T>
 	void serialize(sptr<T> &ser) {
 		if (isOut)
-			ser.reset(dynamic_cast<T *>(this->UnpackSerializable().release()));
+			ser = std::dynamic_pointer_cast<T>(this->unpackSharedSerializable());
 		else
 			reinterpret_cast<uf::ISerializable *>(ser.get())->Serialize(*this);
 	}
 
+	sptr<ISerializable> unpackSharedSerializable();
+
 protected:
 	bool isOut;
 
 private:
-	sf::Packet &packet;
+	sf::Packet *packet;
+	Buffer *buffer;
+	std::pmr::memory_resource *memoryResource;
+	NameTable *names;
+	vec3i coordsOrigin;
+	bool omitNextId;
 };
 
 class InputArchive : public Archive {
 public:
 	explicit InputArchive(sf::Packet &packet);
+	explicit InputArchive(Buffer &buffer);
 };
 
 class OutputArchive : public Archive {
 public:
 	explicit OutputArchive(sf::Packet &packet);
+	explicit OutputArchive(Buffer &buffer);
 };
 
 }
@@ -0,0 +1,167 @@
+#include "Buffer.h"
+
+#include <cstring>
+#include <type_traits>
+
+#include <Shared/ErrorHandling.h>
+
+using namespace uf;
+
+// Buffer
+
+Buffer::Buffer(const void *data, std::size_t size) :
+	data(reinterpret_cast<const char *>(data)), size(size), isView(true)
+{ }
+
+void Buffer::Append(const void *bytes, std::size_t count) {
+	EXPECT_WITH_MSG(!isView, "Try to write to read-only Buffer");
+	if (!bytes || !count)
+		return;
+	storage.insert(storage.end(), reinterpret_cast<const char *>(bytes), reinterpret_cast<const char *>(bytes) + count);
+	data = storage.data();
+	size = storage.size();
+}
+
+void Buffer::Clear() {
+	EXPECT_WITH_MSG(!isView, "Try to clear read-only Buffer");
+	storage.clear();
+	data = storage.data();
+	size = 0;
+	readPos = 0;
+	isValid = true;
+}
+
+void Buffer::BeginFrame() {
+	Clear();
+	*this << sf::Uint32(0);
+}
+
+void Buffer::EndFrame() {
+	EXPECT(size >= sizeof(sf::Uint32));
+	const sf::Uint32 payloadSize = sf::Uint32(size - sizeof(sf::Uint32));
+	for (int i = 0; i < 4; i++)
+		storage[i] = char((payloadSize >> (8 * (3 - i))) & 0xFF);
+}
+
+template<class T>
+void Buffer::writeInteger(T value) {
+	using Unsigned = std::make_unsigned_t<T>;
+	char bytes[sizeof(T)];
+	for (std::size_t i = 0; i < sizeof(T); i++)
+		bytes[i] = char((Unsigned(value) >> (8 * (sizeof(T) - 1 - i))) & 0xFF);
+	Append(bytes, sizeof(T));
+}
+
+template<class T>
+void Buffer::readInteger(T &value) {
+	using Unsigned = std::make_unsigned_t<T>;
+	if (!checkSize(sizeof(T)))
+		return;
+	Unsigned result = 0;
+	for (std::size_t i = 0; i < sizeof(T); i++)
+		result = Unsigned(result << 8) | Unsigned(static_cast<unsigned char>(data[readPos + i]));
+	value = T(result);
+	readPos += sizeof(T);
+}
+
+bool Buffer::checkSize(std::size_t count) {
+	isValid = isValid && (readPos + count <= size);
+	return isValid;
+}
+
+Buffer &Buffer::operator>>(bool &value) {
+	sf::Uint8 byte;
+	if (checkSize(sizeof(byte))) {
+		*this >> byte;
+		value = byte != 0;
+	}
+	return *this;
+}
+
+Buffer &Buffer::operator>>(sf::Int8 &value) { readInteger(value); return *this; }
+Buffer &Buffer::operator>>(sf::Uint8 &value) { readInteger(value); return *this; }
+Buffer &Buffer::operator>>(sf::Int16 &value) { readInteger(value); return *this; }
+Buffer &Buffer::operator>>(sf::Uint16 &value) { readInteger(value); return *this; }
+Buffer &Buffer::operator>>(sf::Int32 &value) { readInteger(value); return *this; }
+Buffer &Buffer::operator>>(sf::Uint32 &value) { readInteger(value); return *this; }
+Buffer &Buffer::operator>>(sf::Int64 &value) { readInteger(value); return *this; }
+Buffer &Buffer::operator>>(sf::Uint64 &value) { readInteger(value); return *this; }
+
+// Floating point numbers are written as is, as sf::Packet does
+Buffer &Buffer::operator>>(float &value) {
+	if (checkSize(sizeof(value))) {
+		std::memcpy(&value, data + readPos, sizeof(value));
+		readPos += sizeof(value);
+	}
+	return *this;
+}
+
+Buffer &Buffer::operator>>(double &value) {
+	if (checkSize(sizeof(value))) {
+		std::memcpy(&value, data + readPos, sizeof(value));
+		readPos += sizeof(value);
+	}
+	return *this;
+}
+
+Buffer &Buffer::operator>>(std::string &value) {
+	sf::Uint32 length = 0;
+	*this >> length;
+	value.clear();
+	if (length > 0 && checkSize(length)) {
+		value.assign(data + readPos, length);
+		readPos += length;
+	}
+	return *this;
+}
+
+Buffer &Buffer::operator<<(bool value) { return *this << sf::Uint8(value); }
+Buffer &Buffer::operator<<(sf::Int8 value) { writeInteger(value); return *this; }
+Buffer &Buffer::operator<<(sf::Uint8 value) { writeInteger(value); return *this; }
+Buffer &Buffer::operator<<(sf::Int16 value) { writeInteger(value); return *this; }
+Buffer &Buffer::operator<<(sf::Uint16 value) { writeInteger(value); return *this; }
+Buffer &Buffer::operator<<(sf::Int32 value) { writeInteger(value); return *this; }
+Buffer &Buffer::operator<<(sf::Uint32 value) { writeInteger(value); return *this; }
+Buffer &Buffer::operator<<(sf::Int64 value) { writeInteger(value); return *this; }
+Buffer &Buffer::operator<<(sf::Uint64 value) { writeInteger(value); return *this; }
+Buffer &Buffer::operator<<(float value) { Append(&value, sizeof(value)); return *this; }
+Buffer &Buffer::operator<<(double value) { Append(&value, sizeof(value)); return *this; }
+
+Buffer &Buffer::operator<<(const std::string &value) {
+	*this << sf::Uint32(value.size());
+	Append(value.data(), value.size());
+	return *this;
+}
+
+Buffer &Buffer::operator<<(const char *value) {
+	const sf::Uint32 length = sf::Uint32(std::strlen(value));
+	*this << length;
+	Append(value, length);
+	return *this;
+}
+
+// BufferPool
+
+BufferPool::PooledBuffer BufferPool::Acquire() {
+	uptr<Buffer> buffer;
+	{
+		std::scoped_lock lock(mutex);
+		if (!buffers.empty()) {
+			buffer = std::move(buffers.back());
+			buffers.pop_back();
+		}
+	}
+	if (!buffer)
+		buffer = std::make_unique<Buffer>();
+	return PooledBuffer(buffer.release(), Releaser{ this });
+}
+
+void BufferPool::Releaser::operator()(Buffer *buffer) const {
+	pool->release(buffer);
+}
+
+void BufferPool::release(Buffer *buffer) {
+	buffer->Clear();
+	std::scoped_lock lock(mutex);
+	buffers.emplace_back(buffer);
+}
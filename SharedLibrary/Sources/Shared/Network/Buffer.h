@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <SFML/Config.hpp>
+
+#include <Shared/Types.hpp>
+
+namespace uf {
+
+// Byte buffer with the same encoding as sf::Packet (big-endian integers, length prefixed strings),
+// so data written to Buffer can be read from sf::Packet and vice versa.
+// Unlike sf::Packet, it keeps its memory after Clear, and can be a read-only view of foreign data.
+class Buffer {
+public:
+	Buffer() = default;
+	// Read-only view, data should outlive the buffer
+	Buffer(const void *data, std::size_t size);
+
+	void Append(const void *data, std::size_t size);
+	// Drops data and resets reading, but keeps allocated memory
+	void Clear();
+
+	const char *GetData() const { return data; }
+	std::size_t GetSize() const { return size; }
+	bool EndOfBuffer() const { return readPos >= size; }
+	explicit operator bool() const { return isValid; }
+
+	// sf::Packet compatible framing: 32-bit big-endian payload size before the payload.
+	// BeginFrame clears the buffer and reserves the size, EndFrame writes it.
+	void BeginFrame();
+	void EndFrame();
+
+	Buffer &operator>>(bool &value);
+	Buffer &operator>>(sf::Int8 &value);
+	Buffer &operator>>(sf::Uint8 &value);
+	Buffer &operator>>(sf::Int16 &value);
+	Buffer &operator>>(sf::Uint16 &value);
+	Buffer &operator>>(sf::Int32 &value);
+	Buffer &operator>>(sf::Uint32 &value);
+	Buffer &operator>>(sf::Int64 &value);
+	Buffer &operator>>(sf::Uint64 &value);
+	Buffer &operator>>(float &value);
+	Buffer &operator>>(double &value);
+	Buffer &operator>>(std::string &value);
+
+	Buffer &operator<<(bool value);
+	Buffer &operator<<(sf::Int8 value);
+	Buffer &operator<<(sf::Uint8 value);
+	Buffer &operator<<(sf::Int16 value);
+	Buffer &operator<<(sf::Uint16 value);
+	Buffer &operator<<(sf::Int32 value);
+	Buffer &operator<<(sf::Uint32 value);
+	Buffer &operator<<(sf::Int64 value);
+	Buffer &operator<<(sf::Uint64 value);
+	Buffer &operator<<(float value);
+	Buffer &operator<<(double value);
+	Buffer &operator<<(const std::string &value);
+	Buffer &operator<<(const char *value);
+
+private:
+	template<class T> void writeInteger(T value);
+	template<class T> void readInteger(T &value);
+	bool checkSize(std::size_t size);
+
+private:
+	std::vector<char> storage;
+	// Points to storage or to viewed data
+	const char *data{nullptr};
+	std::size_t size{0};
+	std::size_t readPos{0};
+	bool isValid{true};
+	bool isView{false};
+};
+
+// Thread-safe pool of buffers. Buffers return to the pool with their memory,
+// so after warming up encoding doesn't allocate.
+class BufferPool {
+public:
+	struct Releaser {
+		BufferPool *pool;
+		void operator()(Buffer *buffer) const;
+	};
+	using PooledBuffer = std::unique_ptr<Buffer, Releaser>;
+
+	// Returns empty buffer
+	PooledBuffer Acquire();
+
+private:
+	void release(Buffer *buffer);
+
+	std::mutex mutex;
+	std::vector<uptr<Buffer>> buffers;
+};
+
+} // namespace uf
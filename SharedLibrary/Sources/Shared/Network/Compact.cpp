@@ -0,0 +1,33 @@
+#include "Compact.h"
+
+namespace uf {
+
+void SerializeCoords(Archive &ar, vec3i &coords) {
+	if (!ar.IsCompact()) {
+		ar & coords;
+		return;
+	}
+
+	const vec3i origin = ar.GetCoordsOrigin();
+	vec3i delta = coords - origin;
+	SerializeVarint(ar, delta.x);
+	SerializeVarint(ar, delta.y);
+	SerializeVarint(ar, delta.z);
+	if (ar.IsOutput())
+		coords = origin + delta;
+}
+
+void SerializeName(Archive &ar, std::string &name) {
+	if (!ar.IsCompact()) {
+		ar & name;
+		return;
+	}
+
+	NameTable *names = ar.GetNameTable();
+	uint32_t index = ar.IsOutput() ? 0 : names->Intern(name);
+	SerializeVarint(ar, index);
+	if (ar.IsOutput())
+		name = names->Get(index);
+}
+
+} // namespace uf
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <Shared/Network/Archive.h>
+#include <Shared/Network/ArchiveConverters.h>
+#include <Shared/Network/NameTable.h>
+#include <Shared/ErrorHandling.h>
+
+// Serialization of fields which have special encoding in compact wire mode.
+// In plain mode every function is the same as "ar & value".
+namespace uf {
+
+// Unsigned LEB128, signed values are zigzag encoded before
+template<class T>
+void SerializeVarint(Archive &ar, T &value) {
+	static_assert(std::is_integral_v<T> && !std::is_same_v<T, bool>, "Varint should be integer");
+
+	if (!ar.IsCompact()) {
+		ar & value;
+		return;
+	}
+
+	using Unsigned = std::make_unsigned_t<T>;
+	if (ar.IsOutput()) {
+		Unsigned result = 0;
+		for (unsigned shift = 0; ; shift += 7) {
+			EXPECT_WITH_MSG(shift < sizeof(T) * 8, "Varint is too long");
+			sf::Uint8 byte = 0;
+			ar >> byte;
+			result |= Unsigned(byte & 0x7F) << shift;
+			if (!(byte & 0x80))
+				break;
+		}
+		if constexpr (std::is_signed_v<T>)
+			value = T((result >> 1) ^ (Unsigned(0) - (result & 1)));
+		else
+			value = result;
+	} else {
+		Unsigned rest;
+		if constexpr (std::is_signed_v<T>)
+			rest = (Unsigned(value) << 1) ^ Unsigned(value >> (sizeof(T) * 8 - 1));
+		else
+			rest = value;
+		while (rest >= 0x80) {
+			ar << sf::Uint8((rest & 0x7F) | 0x80);
+			rest >>= 7;
+		}
+		ar << sf::Uint8(rest);
+	}
+}
+
+template<class T>
+void SerializeVarint(Archive &ar, std::vector<T> &values) {
+	if (!ar.IsCompact()) {
+		ar & values;
+		return;
+	}
+
+	uint32_t size = uint32_t(values.size());
+	SerializeVarint(ar, size);
+	if (ar.IsOutput()) {
+		EXPECT_WITH_MSG(values.empty(), "Try unpack Archive to non-empty vector");
+		values.resize(size);
+	}
+	for (auto &value : values)
+		SerializeVarint(ar, value);
+}
+
+// Struct of known type. Type id is omitted in compact mode.
+template<class T>
+void SerializeStruct(Archive &ar, T &value) {
+	static_assert(std::is_base_of_v<ISerializable, T>, "Struct should be serializable");
+
+	if (!ar.IsCompact()) {
+		ar & value;
+		return;
+	}
+
+	ar.OmitNextId();
+	value.Serialize(ar);
+}
+
+// Vector with varint size, serializable items have no type ids
+template<class T>
+void SerializeVector(Archive &ar, std::vector<T> &values) {
+	if (!ar.IsCompact()) {
+		ar & values;
+		return;
+	}
+
+	uint32_t size = uint32_t(values.size());
+	SerializeVarint(ar, size);
+	if (ar.IsOutput()) {
+		EXPECT_WITH_MSG(values.empty(), "Try unpack Archive to non-empty vector");
+		values.resize(size);
+	}
+	for (auto &value : values) {
+		if constexpr (std::is_base_of_v<ISerializable, T>)
+			SerializeStruct(ar, value);
+		else
+			ar & value;
+	}
+}
+
+// Zigzag varints of the delta from the archive coordinates origin
+void SerializeCoords(Archive &ar, vec3i &coords);
+
+// Index in the archive name table
+void SerializeName(Archive &ar, std::string &name);
+
+} // namespace uf
@@ -0,0 +1,221 @@
+#include "Compression.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <Shared/ErrorHandling.h>
+
+using namespace uf;
+using namespace uf::compression;
+
+namespace {
+
+const int HASH_BITS = 14;
+const std::size_t MAX_OFFSET = WINDOW;
+
+void writeLength(Buffer &out, std::size_t length) {
+	while (length >= 255) {
+		out << sf::Uint8(255);
+		length -= 255;
+	}
+	out << sf::Uint8(length);
+}
+
+// Reads compressed data with bounds checks
+class Reader {
+public:
+	Reader(const char *data, std::size_t size) : data(data), size(size), pos(0) { }
+
+	uint8_t Byte() {
+		EXPECT_WITH_MSG(pos < size, "Compressed packet is corrupted");
+		return static_cast<uint8_t>(data[pos++]);
+	}
+
+	std::size_t Length(std::size_t base) {
+		std::size_t length = base;
+		if (base == 15) {
+			uint8_t byte;
+			do {
+				byte = Byte();
+				length += byte;
+			} while (byte == 255);
+		}
+		return length;
+	}
+
+	const char *Bytes(std::size_t count) {
+		EXPECT_WITH_MSG(count <= size - pos, "Compressed packet is corrupted");
+		const char *result = data + pos;
+		pos += count;
+		return result;
+	}
+
+private:
+	const char *data;
+	std::size_t size;
+	std::size_t pos;
+};
+
+} // namespace
+
+// StreamCompressor
+
+StreamCompressor::StreamCompressor(const std::vector<char> &dictionary, std::size_t threshold) :
+	threshold(threshold),
+	hashTable(std::size_t(1) << HASH_BITS, 0),
+	hashed(0),
+	rawBytes(0),
+	compressedBytes(0)
+{
+	const std::size_t size = std::min(dictionary.size(), WINDOW);
+	append(dictionary.data() + dictionary.size() - size, size);
+	insertHashes(window.size());
+}
+
+void StreamCompressor::Compress(const void *data, std::size_t size, Buffer &out) {
+	const std::size_t outStart = out.GetSize();
+	const std::size_t start = window.size();
+	append(data, size);
+	const std::size_t end = window.size();
+
+	if (size < threshold) {
+		out << sf::Uint8(RAW);
+		out.Append(data, size);
+		insertHashes(end);
+	} else {
+		out << sf::Uint8(COMPRESSED) << sf::Uint32(size);
+
+		// Previous packet tail can be hashed only now
+		insertHashes(start);
+
+		std::size_t pos = start;
+		std::size_t anchor = start;
+		while (pos + MIN_MATCH <= end) {
+			const uint32_t sequence = read32(pos);
+			uint32_t &entry = hashTable[hash(sequence)];
+			const std::size_t candidate = entry;
+			entry = uint32_t(pos + 1);
+
+			if (!candidate || pos - (candidate - 1) > MAX_OFFSET || read32(candidate - 1) != sequence) {
+				pos++;
+				continue;
+			}
+
+			const std::size_t match = candidate - 1;
+			std::size_t matchSize = MIN_MATCH;
+			while (pos + matchSize < end && window[match + matchSize] == window[pos + matchSize])
+				matchSize++;
+
+			writeSequence(out, anchor, pos - anchor, pos - match, matchSize);
+
+			for (std::size_t i = pos + 1; i < pos + matchSize && i + MIN_MATCH <= end; i++)
+				hashTable[hash(read32(i))] = uint32_t(i + 1);
+			pos += matchSize;
+			anchor = pos;
+		}
+		hashed = pos;
+
+		writeSequence(out, anchor, end - anchor, 0, 0);
+	}
+
+	rawBytes += size;
+	compressedBytes += out.GetSize() - outStart;
+	slide();
+}
+
+void StreamCompressor::append(const void *data, std::size_t size) {
+	auto bytes = reinterpret_cast<const char *>(data);
+	window.insert(window.end(), bytes, bytes + size);
+}
+
+void StreamCompressor::insertHashes(std::size_t end) {
+	for (; hashed < end && hashed + MIN_MATCH <= window.size(); hashed++)
+		hashTable[hash(read32(hashed))] = uint32_t(hashed + 1);
+}
+
+void StreamCompressor::writeSequence(Buffer &out, std::size_t literals, std::size_t literalsSize, std::size_t offset, std::size_t matchSize) {
+	const std::size_t matchCode = matchSize ? matchSize - MIN_MATCH : 0;
+	out << sf::Uint8((std::min<std::size_t>(literalsSize, 15) << 4) | std::min<std::size_t>(matchCode, 15));
+	if (literalsSize >= 15)
+		writeLength(out, literalsSize - 15);
+	out.Append(window.data() + literals, literalsSize);
+
+	if (!matchSize)
+		return;
+	out << sf::Uint8(offset & 0xFF) << sf::Uint8(offset >> 8);
+	if (matchCode >= 15)
+		writeLength(out, matchCode - 15);
+}
+
+void StreamCompressor::slide() {
+	if (window.size() <= 2 * WINDOW)
+		return;
+
+	const std::size_t shift = window.size() - WINDOW;
+	window.erase(window.begin(), window.begin() + shift);
+	for (auto &entry : hashTable)
+		entry = entry > shift ? uint32_t(entry - shift) : 0;
+	hashed = hashed > shift ? hashed - shift : 0;
+}
+
+uint32_t StreamCompressor::hash(uint32_t sequence) {
+	return (sequence * 2654435761u) >> (32 - HASH_BITS);
+}
+
+uint32_t StreamCompressor::read32(std::size_t pos) const {
+	uint32_t result;
+	std::memcpy(&result, window.data() + pos, sizeof(result));
+	return result;
+}
+
+// StreamDecompressor
+
+StreamDecompressor::StreamDecompressor(const std::vector<char> &dictionary) {
+	const std::size_t size = std::min(dictionary.size(), WINDOW);
+	window.assign(dictionary.end() - size, dictionary.end());
+}
+
+void StreamDecompressor::Decompress(const void *data, std::size_t size, Buffer &out) {
+	Reader reader(reinterpret_cast<const char *>(data), size);
+	const std::size_t start = window.size();
+
+	if (reader.Byte() == RAW) {
+		const char *bytes = reader.Bytes(size - 1);
+		window.insert(window.end(), bytes, bytes + size - 1);
+	} else {
+		uint32_t rawSize = 0;
+		for (int i = 0; i < 4; i++)
+			rawSize = (rawSize << 8) | reader.Byte();
+		window.reserve(start + rawSize);
+
+		while (true) {
+			const uint8_t token = reader.Byte();
+
+			const std::size_t literalsSize = reader.Length(token >> 4);
+			EXPECT_WITH_MSG(literalsSize <= start + rawSize - window.size(), "Compressed packet is corrupted");
+			const char *literals = reader.Bytes(literalsSize);
+			window.insert(window.end(), literals, literals + literalsSize);
+			if (window.size() == start + rawSize)
+				break;
+
+			std::size_t offset = reader.Byte();
+			offset |= std::size_t(reader.Byte()) << 8;
+			const std::size_t matchSize = reader.Length(token & 0x0F) + MIN_MATCH;
+			EXPECT_WITH_MSG(offset && offset <= window.size(), "Compressed packet is corrupted");
+			EXPECT_WITH_MSG(matchSize <= start + rawSize - window.size(), "Compressed packet is corrupted");
+
+			// Match can overlap with itself, so copy byte by byte
+			std::size_t from = window.size() - offset;
+			for (std::size_t i = 0; i < matchSize; i++)
+				window.push_back(window[from + i]);
+		}
+	}
+
+	out.Append(window.data() + start, window.size() - start);
+	slide();
+}
+
+void StreamDecompressor::slide() {
+	if (window.size() > 2 * WINDOW)
+		window.erase(window.begin(), window.end() - WINDOW);
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <Shared/Network/Buffer.h>
+
+namespace uf {
+
+// LZ77 stream compression of packets (LZ4-like sequences).
+// Every packet can reference bytes of previous packets of the same stream and of the dictionary,
+// so compressor and decompressor should be created with the same dictionary and see the same packets.
+//
+// Packet format: flag byte, then raw data or Uint32 raw size and sequences:
+//   token (literals length << 4 | match length - MIN_MATCH), extra length bytes, literals,
+//   2-byte little-endian match offset, extra match length bytes.
+// The last sequence has only literals.
+namespace compression {
+
+const std::size_t WINDOW = 0xFFFF;
+const std::size_t MIN_MATCH = 4;
+
+enum Flag : uint8_t {
+	RAW = 0,
+	COMPRESSED = 1
+};
+
+} // namespace compression
+
+class StreamCompressor {
+public:
+	// Packets smaller than threshold are not compressed, but still can be referenced by next packets
+	StreamCompressor(const std::vector<char> &dictionary, std::size_t threshold);
+
+	// Appends compressed packet to out
+	void Compress(const void *data, std::size_t size, Buffer &out);
+
+	// Statistics for reports
+	std::size_t GetRawBytes() const { return rawBytes; }
+	std::size_t GetCompressedBytes() const { return compressedBytes; }
+
+private:
+	void append(const void *data, std::size_t size);
+	void insertHashes(std::size_t end);
+	void writeSequence(Buffer &out, std::size_t literals, std::size_t literalsSize, std::size_t offset, std::size_t matchSize);
+	void slide();
+
+	static uint32_t hash(uint32_t sequence);
+	uint32_t read32(std::size_t pos) const;
+
+private:
+	std::size_t threshold;
+
+	// Last bytes of the stream, at least WINDOW of them
+	std::vector<char> window;
+	// Position + 1 of the last 4-byte sequence with such hash, 0 - empty
+	std::vector<uint32_t> hashTable;
+	// Positions before it are already in hash table
+	std::size_t hashed;
+
+	std::size_t rawBytes;
+	std::size_t compressedBytes;
+};
+
+class StreamDecompressor {
+public:
+	explicit StreamDecompressor(const std::vector<char> &dictionary);
+
+	// Appends decompressed packet to out. Throws if packet is corrupted.
+	void Decompress(const void *data, std::size_t size, Buffer &out);
+
+private:
+	void slide();
+
+private:
+	std::vector<char> window;
+};
+
+} // namespace uf
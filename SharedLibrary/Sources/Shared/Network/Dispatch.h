@@ -0,0 +1,79 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace uf {
+
+// Visitor built from several lambdas
+template<class... Ts> struct Overloaded : Ts... { using Ts::operator()...; };
+template<class... Ts> Overloaded(Ts...) -> Overloaded<Ts...>;
+
+namespace detail {
+
+// Smallest modulus which maps every id to its own slot
+template<std::size_t N>
+constexpr uint32_t findPerfectModulus(const std::array<uint32_t, N> &ids) {
+	for (uint32_t modulus = N; ; modulus++) {
+		bool unique = true;
+		for (std::size_t i = 0; i < N && unique; i++)
+			for (std::size_t j = i + 1; j < N && unique; j++)
+				if (ids[i] % modulus == ids[j] % modulus)
+					unique = false;
+		if (unique)
+			return modulus;
+	}
+}
+
+// Jump table indexed by StaticId() % modulus, built at compile time
+template<class Base, class Handler, class... Types>
+struct DispatchTable {
+	using Func = void (*)(Base &, Handler &);
+
+	struct Entry {
+		uint32_t id;
+		Func func;
+	};
+
+	template<class T>
+	static void call(Base &serializable, Handler &handler) {
+		handler(static_cast<T &>(serializable));
+	}
+
+	static constexpr std::array<uint32_t, sizeof...(Types)> ids = { Types::StaticId()... };
+	static constexpr uint32_t modulus = findPerfectModulus(ids);
+
+	static constexpr std::array<Entry, modulus> build() {
+		std::array<Entry, modulus> table{};
+		((table[Types::StaticId() % modulus] = Entry{ Types::StaticId(), &call<Types> }), ...);
+		return table;
+	}
+
+	static constexpr std::array<Entry, modulus> table = build();
+};
+
+} // namespace detail
+
+// O(1) replacement of dynamic_cast chains over serializables.
+// Calls handler(static_cast<T &>(serializable)) for T from Types with T::StaticId() == serializable.Id().
+// Only exact types are matched, so derived types should be listed explicitly.
+// Returns false if serializable type is not in Types.
+template<class... Types, class Base, class Handler>
+bool Dispatch(Base &serializable, Handler &&handler) {
+	static_assert(sizeof...(Types) > 0, "Dispatch needs at least one type");
+	static_assert((std::is_base_of_v<Base, Types> && ...), "Every type should be derived from Base");
+
+	using Table = detail::DispatchTable<Base, std::remove_reference_t<Handler>, Types...>;
+
+	const uint32_t id = serializable.Id();
+	auto &entry = Table::table[id % Table::modulus];
+	if (entry.func && entry.id == id) {
+		entry.func(serializable, handler);
+		return true;
+	}
+	return false;
+}
+
+} // namespace uf
@@ -14,15 +14,24 @@ using namespace network::protocol;
 namespace uf {
 
 void ISerializable::Serialize(Archive &archive) {
+	if (archive.TakeOmitNextId())
+		return;
 	archive << sf::Int32(Id());
 }
 
+namespace {
+
+template<class T> struct TypeTag { using type = T; };
+
 #define DECLARE_SER(name) \
-	case #name##_crc32: { return std::make_unique<name>(); }
+	case #name##_crc32: { return factory(TypeTag<name>()); }
 
-std::unique_ptr<ISerializable> CreateSerializableById(uint32_t id) {
+// Calls factory(TypeTag<T>()) for serializable type T with specified id
+template<class Ptr, class Factory>
+Ptr createById(uint32_t id, Factory &&factory) {
 	switch (id) {
 		using namespace client;
+		DECLARE_SER(ProtocolOptionsCommand)
 		DECLARE_SER(AuthorizationCommand)
 		DECLARE_SER(RegistrationCommand)
 		DECLARE_SER(GamelistRequestCommand)
@@ -35,6 +44,7 @@ std::unique_ptr<ISerializable> CreateSerializableById(uint32_t id) {
 		DECLARE_SER(UITriggerCommand)
 		DECLARE_SER(CallVerbCommand)
 		DECLARE_SER(DisconnectionCommand)
+		DECLARE_SER(PingCommand)
 	}
 
 	switch (id) {
@@ -52,6 +62,8 @@ std::unique_ptr<ISerializable> CreateSerializableById(uint32_t id) {
 		DECLARE_SER(OpenWindowCommand)
 		DECLARE_SER(UpdateWindowCommand)
 		DECLARE_SER(AddChatMessageCommand)
+		DECLARE_SER(ObjectNamesCommand)
+		DECLARE_SER(PongCommand)
 	}
 
 	switch (id) {
@@ -76,4 +88,19 @@ std::unique_ptr<ISerializable> CreateSerializableById(uint32_t id) {
 	EXPECT_WITH_MSG(false, "Unknown serializable id: " + std::to_string(id));
 }
 
+} // namespace
+
+std::unique_ptr<ISerializable> CreateSerializableById(uint32_t id) {
+	return createById<std::unique_ptr<ISerializable>>(id, [](auto tag) -> std::unique_ptr<ISerializable> {
+		return std::make_unique<typename decltype(tag)::type>();
+	});
+}
+
+std::shared_ptr<ISerializable> CreateSharedSerializableById(uint32_t id, std::pmr::memory_resource *resource) {
+	return createById<std::shared_ptr<ISerializable>>(id, [resource](auto tag) -> std::shared_ptr<ISerializable> {
+		using T = typename decltype(tag)::type;
+		return std::allocate_shared<T>(std::pmr::polymorphic_allocator<T>(resource));
+	});
+}
+
 } // namespace uf
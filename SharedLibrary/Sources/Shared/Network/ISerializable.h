@@ -2,6 +2,7 @@
 
 #include <cstdint>
 #include <memory>
+#include <memory_resource>
 
 #include <Shared/CRC32.h>
 
@@ -27,6 +28,8 @@ public:
 };
 
 std::unique_ptr<ISerializable> CreateSerializableById(uint32_t id);
+// Object and its control block are allocated from resource
+std::shared_ptr<ISerializable> CreateSharedSerializableById(uint32_t id, std::pmr::memory_resource *resource);
 
 }
 
@@ -0,0 +1,47 @@
+#include "NameTable.h"
+
+#include <Shared/ErrorHandling.h>
+
+using namespace uf;
+
+uint32_t NameTable::Intern(const std::string &name) {
+	std::scoped_lock lock(mutex);
+	auto iter = indices.find(name);
+	if (iter != indices.end())
+		return iter->second;
+
+	uint32_t index = uint32_t(names.size());
+	names.push_back(name);
+	indices.emplace(name, index);
+	return index;
+}
+
+void NameTable::Add(const std::string &name) {
+	std::scoped_lock lock(mutex);
+	indices.emplace(name, uint32_t(names.size()));
+	names.push_back(name);
+}
+
+void NameTable::Clear() {
+	std::scoped_lock lock(mutex);
+	names.clear();
+	indices.clear();
+}
+
+std::string NameTable::Get(uint32_t index) {
+	std::scoped_lock lock(mutex);
+	EXPECT_WITH_MSG(index < names.size(), "Unknown name index: " + std::to_string(index));
+	return names[index];
+}
+
+uint32_t NameTable::Size() {
+	std::scoped_lock lock(mutex);
+	return uint32_t(names.size());
+}
+
+std::vector<std::string> NameTable::GetNames(uint32_t first) {
+	std::scoped_lock lock(mutex);
+	if (first >= names.size())
+		return {};
+	return std::vector<std::string>(names.begin() + first, names.end());
+}
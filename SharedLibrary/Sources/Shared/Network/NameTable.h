@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace uf {
+
+// Append-only table of strings which are sent by index in compact wire mode.
+// Server interns names while encoding and sends new entries to every client before
+// packets which use them, so indices are the same on both sides.
+class NameTable {
+public:
+	// Returns index of name, adds it if needed
+	uint32_t Intern(const std::string &name);
+	// Client side: appends entries received from server
+	void Add(const std::string &name);
+	void Clear();
+
+	std::string Get(uint32_t index);
+	uint32_t Size();
+	// Entries starting from first, to send them to the client
+	std::vector<std::string> GetNames(uint32_t first);
+
+private:
+	std::mutex mutex;
+	std::vector<std::string> names;
+	std::unordered_map<std::string, uint32_t> indices;
+};
+
+} // namespace uf
@@ -30,6 +30,22 @@ DEFINE_SERIALIZABLE(RegistrationCommand, Command)
 	}
 DEFINE_SERIALIZABLE_END
 
+// Sent right after connection. Server applies options to all following commands to the client.
+DEFINE_SERIALIZABLE(ProtocolOptionsCommand, Command)
+	bool compact;
+	// Stream compression of packets, see uf::StreamCompressor
+	bool compression;
+	// All commands of the server tick are sent in one packet one after another
+	bool batching;
+
+	void Serialize(uf::Archive &ar) override {
+		Command::Serialize(ar);
+		ar & compact;
+		ar & compression;
+		ar & batching;
+	}
+DEFINE_SERIALIZABLE_END
+
 DEFINE_PURE_SERIALIZABLE(GamelistRequestCommand, Command)
 
 DEFINE_SERIALIZABLE(JoinGameCommand, Command)
@@ -43,6 +59,16 @@ DEFINE_SERIALIZABLE_END
 
 DEFINE_PURE_SERIALIZABLE(DisconnectionCommand, Command)
 
+// Server answers with PongCommand with the same id. Used to measure round trip.
+DEFINE_SERIALIZABLE(PingCommand, Command)
+	uint32_t id;
+
+	void Serialize(uf::Archive &ar) override {
+		Command::Serialize(ar);
+		ar & id;
+	}
+DEFINE_SERIALIZABLE_END
+
 DEFINE_SERIALIZABLE(MoveCommand, Command)
 	uf::Direction direction;
 
@@ -0,0 +1,99 @@
+#include "CompressionDictionary.h"
+
+#include <Shared/Network/Archive.h>
+#include <Shared/Network/Buffer.h>
+#include <Shared/Network/NameTable.h>
+#include <Shared/Network/Protocol/ServerToClient/Commands.h>
+
+namespace network {
+namespace protocol {
+
+namespace {
+
+struct Sample {
+	const char *name;
+	uint32_t layer;
+	bool solid;
+};
+
+// Objects of GameLogic which fill the most of tiles
+const Sample SAMPLES[] = {
+	{ "Stun Orb", 100, false },
+	{ "uniform", 50, false },
+	{ "Python Ghost", 80, false },
+	{ "Python Human", 75, true },
+	{ "Window", 80, true },
+	{ "Airlock", 25, true },
+	{ "Wall", 25, true },
+	{ "Floor", 15, false }
+};
+
+ObjectInfo createObjectInfo(const Sample &sample) {
+	ObjectInfo info;
+	info.id = 1;
+	info.name = sample.name;
+	info.spriteIds = { 1 };
+	info.layer = sample.layer;
+	info.direction = uf::Direction::SOUTH;
+	info.opacity.SetFractions({});
+	if (sample.solid) {
+		info.solidity.Add({ uf::Direction::CENTER });
+		info.opacity.SetFractions({ 0, 0, 0, 0, 1 });
+	}
+	info.moveSpeed = 0;
+	info.speed = uf::vec2f(0);
+	return info;
+}
+
+void encodeSamples(uf::Buffer &buffer, uf::NameTable *names) {
+	uf::InputArchive ar(buffer);
+	if (names)
+		ar.SetCompact(names);
+
+	for (auto &sample : SAMPLES) {
+		AddDiff addDiff;
+		addDiff.objId = 1;
+		addDiff.objectInfo = createObjectInfo(sample);
+		addDiff.coords = uf::vec3i(1, 1, 0);
+		addDiff.layer = sample.layer;
+		ar << addDiff;
+
+		TileInfo tileInfo;
+		tileInfo.coords = uf::vec3i(1, 1, 0);
+		tileInfo.sprite = 1;
+		tileInfo.content = { createObjectInfo(sample) };
+		ar << tileInfo;
+	}
+
+	MoveDiff moveDiff;
+	moveDiff.objId = 1;
+	moveDiff.direction = uf::Direction::SOUTH;
+	moveDiff.speed = 4;
+	ar << moveDiff;
+
+	RelocateDiff relocateDiff;
+	relocateDiff.objId = 1;
+	relocateDiff.newCoords = uf::vec3i(1, 1, 0);
+	relocateDiff.layer = 75;
+	ar << relocateDiff;
+
+	RemoveDiff removeDiff;
+	removeDiff.objId = 1;
+	ar << removeDiff;
+}
+
+} // namespace
+
+const std::vector<char> &GetCompressionDictionary() {
+	static const std::vector<char> dictionary = [] {
+		uf::Buffer buffer;
+		uf::NameTable names;
+		encodeSamples(buffer, &names);
+		encodeSamples(buffer, nullptr);
+		return std::vector<char>(buffer.GetData(), buffer.GetData() + buffer.GetSize());
+	}();
+	return dictionary;
+}
+
+} // namespace protocol
+} // namespace network
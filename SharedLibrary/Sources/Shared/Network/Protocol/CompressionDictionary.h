@@ -0,0 +1,13 @@
+#pragma once
+
+#include <vector>
+
+namespace network {
+namespace protocol {
+
+// Encoded samples of the most common protocol structs (ObjectInfo of turfs and creatures, diffs).
+// Server and client prime stream compression with it, so even the first packets are compressed well.
+const std::vector<char> &GetCompressionDictionary();
+
+} // namespace protocol
+} // namespace network
@@ -53,13 +53,24 @@ DEFINE_SERIALIZABLE(GraphicsUpdateCommand, Command)
 		
 		if (options & TILES_SHIFT) {
 			ar & firstTile;
-			ar & tilesInfo;
+			// Tiles are near the first one, so in compact mode their coordinates are short deltas
+			ar.SetCoordsOrigin(firstTile);
+			uf::SerializeVector(ar, tilesInfo);
+			ar.SetCoordsOrigin(uf::vec3i());
 		}
 		if (options & CAMERA_MOVE) {
 			ar & camera;
 		}
 		if (options & DIFFERENCES) {
-			ar & diffs;
+			if (ar.IsOutput()) {
+				uf::SerializeVector(ar, diffs);
+			} else {
+				// The same diffs are sent to every viewer, so take their cached bytes
+				uint32_t size = uint32_t(diffs.size());
+				uf::SerializeVarint(ar, size);
+				for (auto &diff : diffs)
+					diff->SerializeCached(ar);
+			}
 		}
 		if (options & NEW_CONTROLLABLE) {
 			ar & controllableId;
@@ -77,12 +88,26 @@ DEFINE_SERIALIZABLE(ControlUIUpdateCommand, Command)
 	}
 DEFINE_SERIALIZABLE_END
 
+// Values of the overlay cells which are changed since the last update
 DEFINE_SERIALIZABLE(OverlayUpdateCommand, Command)
-	std::vector<network::protocol::OverlayInfo> overlayInfo;
+	// Layer is sent when it's changed, then values of every cell follow
+	bool newLayer{false};
+	network::protocol::OverlayInfo layer;
+	// Bit per cell of the camera view, set for cells which values are sent
+	std::vector<sf::Uint8> changedCells;
+	// Packed values of the changed cells in the view order, every layer channel of the cell
+	std::vector<sf::Uint8> values;
+
+	void SetChanged(size_t cell) { changedCells[cell / 8] |= sf::Uint8(1 << (cell % 8)); }
+	bool IsChanged(size_t cell) const { return cell / 8 < changedCells.size() && changedCells[cell / 8] & (1 << (cell % 8)); }
 
 	void Serialize(uf::Archive &ar) override {
 		uf::ISerializable::Serialize(ar);
-		ar & overlayInfo;
+		ar & newLayer;
+		if (newLayer)
+			uf::SerializeStruct(ar, layer);
+		ar & changedCells;
+		ar & values;
 	}
 DEFINE_SERIALIZABLE_END
 
@@ -117,6 +142,29 @@ DEFINE_SERIALIZABLE(AddChatMessageCommand, Command)
 	}
 DEFINE_SERIALIZABLE_END
 
+// New entries of the server name table (compact wire mode).
+// Sent before the first command which uses them.
+DEFINE_SERIALIZABLE(ObjectNamesCommand, Command)
+	uint32_t first;
+	std::vector<std::string> names;
+
+	void Serialize(uf::Archive &ar) override {
+		uf::ISerializable::Serialize(ar);
+		ar & first;
+		ar & names;
+	}
+DEFINE_SERIALIZABLE_END
+
+// Answer to client::PingCommand
+DEFINE_SERIALIZABLE(PongCommand, Command)
+	uint32_t id;
+
+	void Serialize(uf::Archive &ar) override {
+		uf::ISerializable::Serialize(ar);
+		ar & id;
+	}
+DEFINE_SERIALIZABLE_END
+
 } // namespace server
 } // namespace protocol
 } // namespace network
@@ -1,3 +1,19 @@
 #include "Diff.h"
 
-uint32_t network::protocol::Diff::diffCounter;
+#include <Shared/Network/Archive.h>
+
+std::atomic<uint32_t> network::protocol::Diff::diffCounter{0};
+
+void network::protocol::Diff::SerializeCached(uf::Archive &ar) {
+	auto &encoding = ar.IsCompact() ? compactEncoding : plainEncoding;
+	std::call_once(encoding.flag, [this, &ar, &encoding] {
+		uf::Buffer buffer;
+		uf::InputArchive encoder(buffer);
+		// Name table is shared by all connections, so compact bytes are the same for every receiver
+		if (ar.IsCompact())
+			encoder.SetCompact(ar.GetNameTable());
+		Serialize(encoder);
+		encoding.bytes.assign(buffer.GetData(), buffer.GetData() + buffer.GetSize());
+	});
+	ar.WriteBytes(encoding.bytes.data(), encoding.bytes.size());
+}
@@ -1,8 +1,12 @@
 #pragma once
 
+#include <atomic>
 #include <chrono>
+#include <mutex>
+#include <vector>
 
 #include <Shared/Network/ISerializable.h>
+#include <Shared/Network/Compact.h>
 #include <Shared/Network/Protocol/ServerToClient/WorldInfo.h>
 #include <Shared/Types.hpp>
 
@@ -14,17 +18,30 @@ DEFINE_SERIALIZABLE(Diff, uf::ISerializable)
 
 	void Serialize(uf::Archive &ar) override {
 		uf::ISerializable::Serialize(ar);
-		ar & objId;
+		uf::SerializeVarint(ar, objId);
 	}
 
-	// Server side infrastructure
-	Diff() { diffId = ++diffCounter; }
-	static void ResetDiffCounter() { diffCounter = 0; }
+	// Server side infrastructure. Diffs are created by camera views in parallel, so ids are atomic.
+	Diff() { diffId = diffCounter.fetch_add(1, std::memory_order_relaxed) + 1; }
+	static void ResetDiffCounter() { diffCounter.store(0, std::memory_order_relaxed); }
+	// Diffs created since the last reset
+	static uint32_t GetDiffCounter() { return diffCounter.load(std::memory_order_relaxed); }
 	uint32_t GetDiffId() { return diffId; }
 
+	// Same as Serialize, but diff is serialized only once per wire mode, then its bytes are reused by all receivers.
+	// So diff must not be changed after the first sending. Coordinates are always absolute.
+	void SerializeCached(uf::Archive &ar);
+
 private:
 	uint32_t diffId;
-	static uint32_t diffCounter;
+	static std::atomic<uint32_t> diffCounter;
+
+	struct Encoding {
+		std::once_flag flag;
+		std::vector<char> bytes;
+	};
+	Encoding plainEncoding;
+	Encoding compactEncoding;
 DEFINE_SERIALIZABLE_END
 
 DEFINE_SERIALIZABLE(RelocateDiff, Diff)
@@ -32,8 +49,8 @@ DEFINE_SERIALIZABLE(RelocateDiff, Diff)
 	uint32_t layer;
 	void Serialize(uf::Archive &ar) override {
 		Diff::Serialize(ar);
-		ar & newCoords;
-		ar & layer;
+		uf::SerializeCoords(ar, newCoords);
+		uf::SerializeVarint(ar, layer);
 	}
 DEFINE_SERIALIZABLE_END
 
@@ -45,9 +62,9 @@ DEFINE_SERIALIZABLE(AddDiff, Diff)
 	uint32_t layer;
 	void Serialize(uf::Archive &ar) override {
 		Diff::Serialize(ar);
-		ar & objectInfo;
-		ar & coords;
-		ar & layer;
+		uf::SerializeStruct(ar, objectInfo);
+		uf::SerializeCoords(ar, coords);
+		uf::SerializeVarint(ar, layer);
 	}
 DEFINE_SERIALIZABLE_END
 
@@ -75,7 +92,7 @@ DEFINE_SERIALIZABLE(UpdateIconsDiff, Diff)
 	std::vector<uint32_t> iconsIds;
 	void Serialize(uf::Archive &ar) override {
 		Diff::Serialize(ar);
-		ar & iconsIds;
+		uf::SerializeVarint(ar, iconsIds);
 	}
 DEFINE_SERIALIZABLE_END
 
@@ -83,7 +100,7 @@ DEFINE_SERIALIZABLE(PlayAnimationDiff, Diff)
 	uint animationId;
 	void Serialize(uf::Archive &ar) override {
 		Diff::Serialize(ar);
-		ar & animationId;
+		uf::SerializeVarint(ar, animationId);
 	}
 DEFINE_SERIALIZABLE_END
 
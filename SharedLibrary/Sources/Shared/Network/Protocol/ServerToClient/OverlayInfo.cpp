@@ -0,0 +1,93 @@
+#include "OverlayInfo.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+
+#include <Shared/ErrorHandling.h>
+
+using namespace network::protocol;
+
+namespace {
+
+// Little endian, the same on every platform
+void packBytes(uint32_t value, size_t size, sf::Uint8 *out) {
+	for (size_t i = 0; i < size; i++)
+		out[i] = sf::Uint8(value >> (8 * i));
+}
+
+uint32_t unpackBytes(const sf::Uint8 *in, size_t size) {
+	uint32_t value = 0;
+	for (size_t i = 0; i < size; i++)
+		value |= uint32_t(in[i]) << (8 * i);
+	return value;
+}
+
+uint32_t toUnsigned(float value, double max) {
+	return uint32_t(std::clamp(std::round(double(value)), 0.0, max));
+}
+
+} // namespace
+
+size_t OverlayInfo::GetValueSize() const {
+	EXPECT_WITH_MSG(type <= OverlayValueType::Float, "Unknown overlay value type");
+	switch (type) {
+		case OverlayValueType::UInt8: return 1;
+		case OverlayValueType::UInt16: return 2;
+		default: return 4;
+	}
+}
+
+void OverlayInfo::Pack(float value, sf::Uint8 *out) const {
+	switch (type) {
+		case OverlayValueType::UInt8:
+			packBytes(toUnsigned(value, 0xFF), 1, out);
+			break;
+		case OverlayValueType::UInt16:
+			packBytes(toUnsigned(value, 0xFFFF), 2, out);
+			break;
+		case OverlayValueType::UInt32:
+			packBytes(toUnsigned(value, 0xFFFFFFFF), 4, out);
+			break;
+		case OverlayValueType::Float: {
+			const float scale = std::pow(10.f, float(precision));
+			const float rounded = std::round(value * scale) / scale;
+			uint32_t bits;
+			std::memcpy(&bits, &rounded, sizeof(bits));
+			packBytes(bits, 4, out);
+			break;
+		}
+	}
+}
+
+float OverlayInfo::Unpack(const sf::Uint8 *in) const {
+	const uint32_t bits = unpackBytes(in, GetValueSize());
+	if (type != OverlayValueType::Float)
+		return float(bits);
+	float value;
+	std::memcpy(&value, &bits, sizeof(value));
+	return value;
+}
+
+std::string OverlayInfo::Format(const float *values) const {
+	std::ostringstream text;
+	text << std::fixed << std::setprecision(precision);
+	bool first = true;
+	for (size_t channel = 0; channel < channels.size(); channel++) {
+		if (values[channel] == 0)
+			continue;
+		if (!first)
+			text << "\n";
+		if (channels.size() > 1)
+			text << channels[channel] << " ";
+		text << values[channel];
+		first = false;
+	}
+	return text.str();
+}
+
+bool OverlayInfo::operator==(const OverlayInfo &other) const {
+	return type == other.type && precision == other.precision && channels == other.channels;
+}
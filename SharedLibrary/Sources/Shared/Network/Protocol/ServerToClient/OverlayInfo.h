@@ -1,19 +1,50 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 #include <Shared/Network/ISerializable.h>
 #include <Shared/Network/Archive.h>
+#include <Shared/Network/ArchiveConverters.h>
 
 namespace network {
 namespace protocol {
 
+enum class OverlayValueType : sf::Uint8 {
+	UInt8,
+	UInt16,
+	UInt32,
+	Float
+};
+
+// Layer of numeric values over the camera view, e.g. heatmap of pressure.
+// Every tile has a value per channel, values are packed to the type size on the wire.
 DEFINE_SERIALIZABLE(OverlayInfo, uf::ISerializable)
-	std::string text;
+	OverlayValueType type{OverlayValueType::Float};
+	// Digits after the point. Float values are rounded to them, so smaller changes aren't sent.
+	sf::Uint8 precision{0};
+	// Names are shown before values if there are several channels
+	std::vector<std::string> channels;
+
+	size_t GetValueSize() const;
+	size_t GetCellSize() const { return GetValueSize() * channels.size(); }
+
+	// Value is rounded and clamped to the type range
+	void Pack(float value, sf::Uint8 *out) const;
+	float Unpack(const sf::Uint8 *in) const;
+	// Text of the tile with values of every channel, zeros are skipped
+	std::string Format(const float *values) const;
+
+	bool operator==(const OverlayInfo &other) const;
+	bool operator!=(const OverlayInfo &other) const { return !(*this == other); }
 
-	void Serialize(uf::Archive &archive) {
+	void Serialize(uf::Archive &archive) override {
 		uf::ISerializable::Serialize(archive);
-		archive & text;
+		sf::Uint8 typeValue = sf::Uint8(type);
+		archive & typeValue;
+		type = OverlayValueType(typeValue);
+		archive & precision;
+		archive & channels;
 	}
 DEFINE_SERIALIZABLE_END
 
@@ -1,8 +1,11 @@
 #pragma once
 
+#include <algorithm>
+
 #include <Shared/Network/ISerializable.h>
 #include <Shared/Network/Archive.h>
 #include <Shared/Network/ArchiveConverters.h>
+#include <Shared/Network/Compact.h>
 #include <Shared/Geometry/DirectionSet.h>
 #include <Shared/Types.hpp>
 
@@ -23,6 +26,10 @@ DEFINE_SERIALIZABLE(ObjectInfo, uf::ISerializable)
 
 	void Serialize(uf::Archive &ar) override {
 		uf::ISerializable::Serialize(ar);
+		if (ar.IsCompact()) {
+			serializeCompact(ar);
+			return;
+		}
 		ar & id;
 		ar & name;
 		ar & spriteIds;
@@ -33,6 +40,42 @@ DEFINE_SERIALIZABLE(ObjectInfo, uf::ISerializable)
 		ar & moveSpeed;
 		ar & speed;
 	}
+
+private:
+	// Fields which are usually default, they are sent only when differ
+	enum Field : sf::Uint8 {
+		SOLIDITY = 1,
+		OPACITY = 1 << 1,
+		MOVE_SPEED = 1 << 2,
+		SPEED = 1 << 3
+	};
+
+	void serializeCompact(uf::Archive &ar) {
+		sf::Uint8 fields = 0;
+		if (!ar.IsOutput()) {
+			const auto &fractions = opacity.GetFractions();
+			if (solidity.GetBuffer().any()) fields |= SOLIDITY;
+			if (std::any_of(fractions.begin(), fractions.end(), [](float f) { return f != 0; })) fields |= OPACITY;
+			if (moveSpeed != 0) fields |= MOVE_SPEED;
+			if (speed.x != 0 || speed.y != 0) fields |= SPEED;
+		}
+		ar & fields;
+
+		uf::SerializeVarint(ar, id);
+		uf::SerializeName(ar, name);
+		uf::SerializeVarint(ar, spriteIds);
+		uf::SerializeVarint(ar, layer);
+		ar & direction;
+
+		if (fields & SOLIDITY) ar & solidity;
+		else if (ar.IsOutput()) solidity.Reset();
+		if (fields & OPACITY) ar & opacity;
+		else if (ar.IsOutput()) opacity.SetFractions({});
+		if (fields & MOVE_SPEED) ar & moveSpeed;
+		else if (ar.IsOutput()) moveSpeed = 0;
+		if (fields & SPEED) ar & speed;
+		else if (ar.IsOutput()) speed = uf::vec2f(0);
+	}
 DEFINE_SERIALIZABLE_END
 
 DEFINE_SERIALIZABLE(TileInfo, uf::ISerializable)
@@ -42,9 +85,9 @@ DEFINE_SERIALIZABLE(TileInfo, uf::ISerializable)
 
 	void Serialize(uf::Archive &ar) override {
 		uf::ISerializable::Serialize(ar);
-		ar & coords;
-		ar & sprite;
-		ar & content;
+		uf::SerializeCoords(ar, coords);
+		uf::SerializeVarint(ar, sprite);
+		uf::SerializeVector(ar, content);
 	}
 DEFINE_SERIALIZABLE_END
 
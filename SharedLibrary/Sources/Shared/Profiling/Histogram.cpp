@@ -0,0 +1,112 @@
+#include "Histogram.h"
+
+#include <algorithm>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace uf {
+
+namespace {
+
+uint32_t log2(uint64_t value) {
+#ifdef _MSC_VER
+	unsigned long index;
+	_BitScanReverse64(&index, value);
+	return uint32_t(index);
+#else
+	return uint32_t(63 - __builtin_clzll(value));
+#endif
+}
+
+} // namespace
+
+HistogramSnapshot HistogramSnapshot::operator-(const HistogramSnapshot &other) const {
+	HistogramSnapshot result;
+	std::size_t highest = 0;
+	for (std::size_t i = 0; i < HISTOGRAM_BUCKETS; i++) {
+		result.counts[i] = counts[i] - other.counts[i];
+		if (result.counts[i])
+			highest = i;
+	}
+	result.count = count - other.count;
+	result.sum = sum - other.sum;
+	// Exact maximum of the interval is unknown, the highest bucket limits it
+	result.max = result.count ? std::min(max, Histogram::BucketUpperBound(highest)) : 0;
+	return result;
+}
+
+std::chrono::nanoseconds HistogramSnapshot::Mean() const {
+	return std::chrono::nanoseconds(count ? sum / count : 0);
+}
+
+std::chrono::nanoseconds HistogramSnapshot::Percentile(double p) const {
+	if (!count)
+		return std::chrono::nanoseconds::zero();
+
+	const uint64_t rank = std::max<uint64_t>(1, uint64_t(p * double(count) + 0.5));
+	uint64_t seen = 0;
+	for (std::size_t i = 0; i < HISTOGRAM_BUCKETS; i++) {
+		seen += counts[i];
+		if (seen >= rank) {
+			uint64_t middle = (Histogram::BucketLowerBound(i) + Histogram::BucketUpperBound(i)) / 2;
+			return std::chrono::nanoseconds(std::min(middle, max));
+		}
+	}
+	return std::chrono::nanoseconds(max);
+}
+
+void Histogram::Record(std::chrono::nanoseconds duration) {
+	const uint64_t value = uint64_t(std::max<int64_t>(duration.count(), 0));
+	counts[BucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+	count.fetch_add(1, std::memory_order_relaxed);
+	sum.fetch_add(value, std::memory_order_relaxed);
+
+	uint64_t currentMax = max.load(std::memory_order_relaxed);
+	while (value > currentMax && !max.compare_exchange_weak(currentMax, value, std::memory_order_relaxed));
+}
+
+HistogramSnapshot Histogram::Snapshot() const {
+	HistogramSnapshot snapshot;
+	for (std::size_t i = 0; i < HISTOGRAM_BUCKETS; i++)
+		snapshot.counts[i] = counts[i].load(std::memory_order_relaxed);
+	snapshot.count = count.load(std::memory_order_relaxed);
+	snapshot.sum = sum.load(std::memory_order_relaxed);
+	snapshot.max = max.load(std::memory_order_relaxed);
+	return snapshot;
+}
+
+void Histogram::Reset() {
+	for (auto &bucket : counts)
+		bucket.store(0, std::memory_order_relaxed);
+	count.store(0, std::memory_order_relaxed);
+	sum.store(0, std::memory_order_relaxed);
+	max.store(0, std::memory_order_relaxed);
+}
+
+std::size_t Histogram::BucketIndex(uint64_t value) {
+	if (value < HISTOGRAM_SUB_BUCKETS)
+		return std::size_t(value);
+	const uint32_t exponent = log2(value);
+	const std::size_t subBucket = std::size_t(value >> (exponent - HISTOGRAM_SUB_BUCKET_BITS)) & (HISTOGRAM_SUB_BUCKETS - 1);
+	const std::size_t index = (exponent - HISTOGRAM_SUB_BUCKET_BITS + 1) * HISTOGRAM_SUB_BUCKETS + subBucket;
+	return std::min(index, HISTOGRAM_BUCKETS - 1);
+}
+
+uint64_t Histogram::BucketLowerBound(std::size_t index) {
+	if (index < HISTOGRAM_SUB_BUCKETS)
+		return index;
+	const std::size_t exponent = index / HISTOGRAM_SUB_BUCKETS + HISTOGRAM_SUB_BUCKET_BITS - 1;
+	const uint64_t subBucket = index % HISTOGRAM_SUB_BUCKETS;
+	return (HISTOGRAM_SUB_BUCKETS + subBucket) << (exponent - HISTOGRAM_SUB_BUCKET_BITS);
+}
+
+uint64_t Histogram::BucketUpperBound(std::size_t index) {
+	if (index < HISTOGRAM_SUB_BUCKETS)
+		return index + 1;
+	const std::size_t exponent = index / HISTOGRAM_SUB_BUCKETS + HISTOGRAM_SUB_BUCKET_BITS - 1;
+	return BucketLowerBound(index) + (uint64_t(1) << (exponent - HISTOGRAM_SUB_BUCKET_BITS));
+}
+
+} // namespace uf
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace uf {
+
+// Log-linear buckets: 8 sub-buckets per power of two, so a bucket is at most 12.5% wide.
+// Covers durations up to 2^40 ns (~18 minutes), longer ones go to the last bucket.
+constexpr std::size_t HISTOGRAM_SUB_BUCKET_BITS = 3;
+constexpr std::size_t HISTOGRAM_SUB_BUCKETS = 1 << HISTOGRAM_SUB_BUCKET_BITS;
+constexpr std::size_t HISTOGRAM_BUCKETS = (40 - HISTOGRAM_SUB_BUCKET_BITS + 1) * HISTOGRAM_SUB_BUCKETS;
+
+// Plain copy of Histogram
+struct HistogramSnapshot {
+	std::array<uint64_t, HISTOGRAM_BUCKETS> counts{};
+	uint64_t count{0};
+	uint64_t sum{0};
+	uint64_t max{0};
+
+	// Records made between other and this snapshot
+	HistogramSnapshot operator-(const HistogramSnapshot &other) const;
+
+	std::chrono::nanoseconds Mean() const;
+	std::chrono::nanoseconds Sum() const { return std::chrono::nanoseconds(sum); }
+	std::chrono::nanoseconds Max() const { return std::chrono::nanoseconds(max); }
+	// p in [0, 1]. Middle of the bucket, so the error is less than half of the bucket width.
+	std::chrono::nanoseconds Percentile(double p) const;
+};
+
+// Lock-free histogram of durations, can be recorded from any thread.
+// Record is a few relaxed atomic increments.
+class Histogram {
+public:
+	void Record(std::chrono::nanoseconds duration);
+	// Not atomic as a whole, but every counter is consistent by itself
+	HistogramSnapshot Snapshot() const;
+	void Reset();
+
+	// Cheaper than Snapshot when only totals are needed
+	uint64_t Count() const { return count.load(std::memory_order_relaxed); }
+	std::chrono::nanoseconds Sum() const { return std::chrono::nanoseconds(sum.load(std::memory_order_relaxed)); }
+
+	static std::size_t BucketIndex(uint64_t value);
+	static uint64_t BucketLowerBound(std::size_t index);
+	static uint64_t BucketUpperBound(std::size_t index);
+
+private:
+	std::array<std::atomic<uint64_t>, HISTOGRAM_BUCKETS> counts{};
+	std::atomic<uint64_t> count{0};
+	std::atomic<uint64_t> sum{0};
+	std::atomic<uint64_t> max{0};
+};
+
+} // namespace uf
@@ -0,0 +1,87 @@
+#include "Profiler.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+namespace uf {
+
+namespace {
+
+std::string formatMicroseconds(std::chrono::nanoseconds duration) {
+	std::ostringstream stream;
+	stream << std::fixed << std::setprecision(1) << double(duration.count()) / 1000.0;
+	return stream.str();
+}
+
+} // namespace
+
+Profiler &Profiler::Get() {
+	static Profiler profiler;
+	return profiler;
+}
+
+ProfilerSection &Profiler::Section(const std::string &name) {
+	std::unique_lock<std::mutex> lock(mutex);
+	auto &section = sections[name];
+	if (!section)
+		section = std::make_unique<ProfilerSection>(name);
+	return *section;
+}
+
+std::vector<ProfilerSection *> Profiler::Sections() const {
+	std::unique_lock<std::mutex> lock(mutex);
+	std::vector<ProfilerSection *> result;
+	result.reserve(sections.size());
+	for (auto &[name, section] : sections)
+		result.push_back(section.get());
+	return result;
+}
+
+ProfilerSnapshot Profiler::Snapshot() const {
+	std::unique_lock<std::mutex> lock(mutex);
+	ProfilerSnapshot snapshot;
+	for (auto &[name, section] : sections)
+		snapshot[name] = section->histogram.Snapshot();
+	return snapshot;
+}
+
+void Profiler::Reset() {
+	std::unique_lock<std::mutex> lock(mutex);
+	for (auto &[name, section] : sections)
+		section->histogram.Reset();
+}
+
+std::string Profiler::Report(const ProfilerSnapshot &current, const ProfilerSnapshot *previous) {
+	std::ostringstream report;
+	report << std::left << std::setw(40) << "section" << std::right
+	       << std::setw(10) << "calls"
+	       << std::setw(10) << "mean us"
+	       << std::setw(10) << "p50 us"
+	       << std::setw(10) << "p99 us"
+	       << std::setw(10) << "max us" << "\n";
+
+	for (auto &[name, snapshot] : current) {
+		HistogramSnapshot histogram = snapshot;
+		if (previous) {
+			auto iter = previous->find(name);
+			if (iter != previous->end())
+				histogram = snapshot - iter->second;
+		}
+		if (!histogram.count)
+			continue;
+
+		// Nested sections are indented under their parent
+		const auto depth = std::count(name.begin(), name.end(), '/');
+		const auto lastPart = name.substr(name.rfind('/') + 1);
+		report << std::left << std::setw(40) << std::string(depth * 2, ' ') + lastPart << std::right
+		       << std::setw(10) << histogram.count
+		       << std::setw(10) << formatMicroseconds(histogram.Mean())
+		       << std::setw(10) << formatMicroseconds(histogram.Percentile(0.5))
+		       << std::setw(10) << formatMicroseconds(histogram.Percentile(0.99))
+		       << std::setw(10) << formatMicroseconds(histogram.Max()) << "\n";
+	}
+	return report.str();
+}
+
+} // namespace uf
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <Shared/Types.hpp>
+
+#include "Histogram.h"
+#include "Tracer.h"
+
+namespace uf {
+
+// Durations of one measured place
+struct ProfilerSection {
+	explicit ProfilerSection(std::string name) : name(std::move(name)) { }
+
+	const std::string name;
+	Histogram histogram;
+};
+
+using ProfilerSnapshot = std::map<std::string, HistogramSnapshot>;
+
+// Registry of named sections. Names are paths ("tick/world/map"), reports show them as a tree.
+// Sections are never removed, so references to them stay valid.
+class Profiler {
+public:
+	static Profiler &Get();
+
+	ProfilerSection &Section(const std::string &name);
+	// All sections sorted by name
+	std::vector<ProfilerSection *> Sections() const;
+
+	ProfilerSnapshot Snapshot() const;
+	void Reset();
+
+	void SetEnabled(bool enabled) { this->enabled.store(enabled, std::memory_order_relaxed); }
+	bool IsEnabled() const { return enabled.load(std::memory_order_relaxed); }
+
+	// Table with calls, mean, median, p99 and max of every section.
+	// If previous is set, only records made after it are counted.
+	static std::string Report(const ProfilerSnapshot &current, const ProfilerSnapshot *previous = nullptr);
+
+private:
+	mutable std::mutex mutex;
+	std::map<std::string, uptr<ProfilerSection>> sections;
+	std::atomic<bool> enabled{true};
+};
+
+// Records time from construction to destruction to the section histogram,
+// and the span to the trace if tracing is on
+class ScopedTimer {
+public:
+	explicit ScopedTimer(ProfilerSection &section) :
+		section(section),
+		profiled(Profiler::Get().IsEnabled()),
+		traced(Tracer::Get().IsEnabled())
+	{
+		if (profiled || traced)
+			start = std::chrono::steady_clock::now();
+	}
+
+	~ScopedTimer() {
+		if (!profiled && !traced)
+			return;
+		auto finish = std::chrono::steady_clock::now();
+		if (profiled)
+			section.histogram.Record(finish - start);
+		if (traced)
+			Tracer::Get().Record(section.name, start, finish);
+	}
+
+	ScopedTimer(const ScopedTimer &) = delete;
+	ScopedTimer &operator=(const ScopedTimer &) = delete;
+
+private:
+	ProfilerSection &section;
+	const bool profiled;
+	const bool traced;
+	std::chrono::steady_clock::time_point start;
+};
+
+} // namespace uf
+
+#define PROFILE_CONCAT_IMPL(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_IMPL(a, b)
+
+// Measures the rest of the scope. Section is looked up once per call site.
+#define PROFILE_SCOPE(name) \
+	static uf::ProfilerSection &PROFILE_CONCAT(profilerSection, __LINE__) = uf::Profiler::Get().Section(name); \
+	uf::ScopedTimer PROFILE_CONCAT(profilerTimer, __LINE__)(PROFILE_CONCAT(profilerSection, __LINE__))
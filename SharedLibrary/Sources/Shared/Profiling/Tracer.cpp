@@ -0,0 +1,132 @@
+#include "Tracer.h"
+
+#include <fstream>
+#include <iomanip>
+
+#include <plog/Log.h>
+
+namespace uf {
+
+namespace {
+
+std::string escape(const std::string &text) {
+	std::string result;
+	result.reserve(text.size());
+	for (char c : text) {
+		if (c == '"' || c == '\\')
+			result += '\\';
+		if (static_cast<unsigned char>(c) >= 0x20)
+			result += c;
+	}
+	return result;
+}
+
+// Trace event format wants microseconds
+void writeMicroseconds(std::ostream &stream, int64_t nanoseconds) {
+	stream << nanoseconds / 1000 << '.' << std::setw(3) << std::setfill('0') << nanoseconds % 1000 << std::setfill(' ');
+}
+
+} // namespace
+
+Tracer &Tracer::Get() {
+	static Tracer tracer;
+	return tracer;
+}
+
+Tracer::Tracer() :
+	epoch(Clock::now())
+{ }
+
+void Tracer::Start() {
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		for (auto &thread : threads) {
+			std::unique_lock<std::mutex> threadLock(thread->mutex);
+			thread->events.clear();
+		}
+	}
+	enabled.store(true, std::memory_order_relaxed);
+}
+
+bool Tracer::Stop(const std::string &path) {
+	enabled.store(false, std::memory_order_relaxed);
+
+	std::ofstream file(path);
+	if (!file) {
+		LOGE << "Failed to open " << path;
+		return false;
+	}
+
+	file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+	bool first = true;
+	auto separate = [&file, &first]() {
+		if (!first)
+			file << ",\n";
+		first = false;
+	};
+
+	std::unique_lock<std::mutex> lock(mutex);
+	for (auto &thread : threads) {
+		std::vector<Event> events;
+		std::string name;
+		{
+			std::unique_lock<std::mutex> threadLock(thread->mutex);
+			events.swap(thread->events);
+			name = thread->name;
+		}
+
+		if (!name.empty()) {
+			separate();
+			file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << thread->id
+			     << ",\"args\":{\"name\":\"" << escape(name) << "\"}}";
+		}
+		for (auto &event : events) {
+			separate();
+			file << "{\"name\":\"" << escape(*event.name) << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << thread->id << ",\"ts\":";
+			writeMicroseconds(file, event.start);
+			file << ",\"dur\":";
+			writeMicroseconds(file, event.duration);
+			file << "}";
+		}
+	}
+	file << "]}\n";
+
+	return bool(file);
+}
+
+void Tracer::Record(const std::string &name, Clock::time_point start, Clock::time_point finish) {
+	if (!IsEnabled())
+		return;
+	// Span was started before the tracer
+	if (start < epoch)
+		return;
+
+	auto &thread = threadBuffer();
+	std::unique_lock<std::mutex> lock(thread.mutex);
+	if (thread.events.size() >= MAX_EVENTS_PER_THREAD)
+		return;
+	thread.events.push_back({
+		&name,
+		std::chrono::duration_cast<std::chrono::nanoseconds>(start - epoch).count(),
+		std::chrono::duration_cast<std::chrono::nanoseconds>(finish - start).count()
+	});
+}
+
+void Tracer::SetThreadName(const std::string &name) {
+	auto &thread = threadBuffer();
+	std::unique_lock<std::mutex> lock(thread.mutex);
+	thread.name = name;
+}
+
+Tracer::ThreadBuffer &Tracer::threadBuffer() {
+	thread_local ThreadBuffer *buffer = nullptr;
+	if (!buffer) {
+		std::unique_lock<std::mutex> lock(mutex);
+		threads.push_back(std::make_unique<ThreadBuffer>());
+		buffer = threads.back().get();
+		buffer->id = uint(threads.size());
+	}
+	return *buffer;
+}
+
+} // namespace uf
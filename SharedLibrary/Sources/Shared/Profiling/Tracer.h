@@ -0,0 +1,68 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <Shared/Types.hpp>
+
+namespace uf {
+
+// Timeline of spans for chrome://tracing and ui.perfetto.dev.
+// Every thread writes to its own buffer, so threads don't contend while tracing.
+// When tracing is off, recording place costs one relaxed atomic load.
+class Tracer {
+public:
+	using Clock = std::chrono::steady_clock;
+
+	static Tracer &Get();
+
+	// Drops previous events and starts collecting
+	void Start();
+	// Stops collecting and writes events in trace event JSON format
+	bool Stop(const std::string &path);
+
+	bool IsEnabled() const { return enabled.load(std::memory_order_relaxed); }
+
+	// Name should live until Stop (section names live forever)
+	void Record(const std::string &name, Clock::time_point start, Clock::time_point finish);
+
+	// Shown in the viewer instead of thread id
+	void SetThreadName(const std::string &name);
+
+private:
+	Tracer();
+
+	struct Event {
+		const std::string *name;
+		// Nanoseconds since tracer creation
+		int64_t start;
+		int64_t duration;
+	};
+
+	struct ThreadBuffer {
+		uint id;
+		std::string name;
+		// Locked by the thread itself and by Stop only
+		std::mutex mutex;
+		std::vector<Event> events;
+	};
+
+	ThreadBuffer &threadBuffer();
+
+private:
+	// Trace of a long session is cut to keep memory bounded
+	const std::size_t MAX_EVENTS_PER_THREAD = 1 << 20;
+
+	const Clock::time_point epoch;
+	std::atomic<bool> enabled{false};
+
+	std::mutex mutex;
+	// Buffers are never removed, threads keep pointers to them
+	std::vector<uptr<ThreadBuffer>> threads;
+};
+
+} // namespace uf
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace uf {
+
+// Bounded lock-free ring for one producer and one consumer.
+// Every side caches the other's index, so shared cache lines are touched only when the cache is outdated.
+template<class T>
+class SPSCRing {
+public:
+	// Capacity is rounded up to a power of two
+	explicit SPSCRing(size_t capacity);
+
+	SPSCRing(const SPSCRing &) = delete;
+	SPSCRing &operator=(const SPSCRing &) = delete;
+
+	// Producer only. return false if the ring is full.
+	bool TryPush(T value);
+
+	// Consumer only. return false if the ring is empty.
+	bool TryPop(T &value);
+	// Consumer only. Calls func(T &&) for every available element, returns their number.
+	template<class Func>
+	size_t Drain(Func &&func);
+	bool Empty() const;
+
+	size_t Capacity() const { return slots.size(); }
+
+private:
+	static size_t roundUp(size_t capacity);
+
+private:
+	std::vector<T> slots;
+	const size_t mask;
+
+	// Next slot to write, owned by the producer
+	alignas(64) std::atomic<size_t> head{0};
+	size_t cachedTail{0};
+	// Next slot to read, owned by the consumer
+	alignas(64) std::atomic<size_t> tail{0};
+	size_t cachedHead{0};
+};
+
+template<class T>
+SPSCRing<T>::SPSCRing(size_t capacity) :
+	slots(roundUp(capacity)),
+	mask(slots.size() - 1)
+{ }
+
+template<class T>
+bool SPSCRing<T>::TryPush(T value) {
+	const size_t position = head.load(std::memory_order_relaxed);
+	if (position - cachedTail == slots.size()) {
+		cachedTail = tail.load(std::memory_order_acquire);
+		if (position - cachedTail == slots.size())
+			return false;
+	}
+	slots[position & mask] = std::move(value);
+	head.store(position + 1, std::memory_order_release);
+	return true;
+}
+
+template<class T>
+bool SPSCRing<T>::TryPop(T &value) {
+	const size_t position = tail.load(std::memory_order_relaxed);
+	if (position == cachedHead) {
+		cachedHead = head.load(std::memory_order_acquire);
+		if (position == cachedHead)
+			return false;
+	}
+	value = std::move(slots[position & mask]);
+	tail.store(position + 1, std::memory_order_release);
+	return true;
+}
+
+template<class T>
+template<class Func>
+size_t SPSCRing<T>::Drain(Func &&func) {
+	size_t position = tail.load(std::memory_order_relaxed);
+	const size_t end = head.load(std::memory_order_acquire);
+	cachedHead = end;
+	const size_t count = end - position;
+	for (; position != end; position++) {
+		func(std::move(slots[position & mask]));
+		// Slots are released one by one, so the producer can refill them during long drain
+		tail.store(position + 1, std::memory_order_release);
+	}
+	return count;
+}
+
+template<class T>
+bool SPSCRing<T>::Empty() const {
+	return tail.load(std::memory_order_relaxed) == head.load(std::memory_order_acquire);
+}
+
+template<class T>
+size_t SPSCRing<T>::roundUp(size_t capacity) {
+	size_t result = 1;
+	while (result < capacity)
+		result <<= 1;
+	return result;
+}
+
+} // namespace uf
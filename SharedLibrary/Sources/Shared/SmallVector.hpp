@@ -0,0 +1,119 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+
+namespace uf {
+
+// Vector which keeps up to N elements inline and goes to the heap only when it grows beyond.
+// Only for trivially copyable types, so elements are moved with memmove.
+// Interface follows std::vector to be used with range-for and standard algorithms.
+template<class T, size_t N>
+class SmallVector {
+	static_assert(std::is_trivially_copyable<T>::value, "SmallVector elements must be trivially copyable");
+
+public:
+	using value_type = T;
+	using iterator = T *;
+	using const_iterator = const T *;
+
+	SmallVector() = default;
+	SmallVector(const SmallVector &other) { *this = other; }
+	SmallVector(SmallVector &&other) noexcept { *this = std::move(other); }
+
+	SmallVector &operator=(const SmallVector &other) {
+		if (this != &other) {
+			count = 0;
+			reserve(other.count);
+			std::memcpy(data(), other.data(), other.count * sizeof(T));
+			count = other.count;
+		}
+		return *this;
+	}
+
+	SmallVector &operator=(SmallVector &&other) noexcept {
+		if (this != &other) {
+			if (other.heap) {
+				heap = std::move(other.heap);
+				heapCapacity = other.heapCapacity;
+			} else {
+				heap.reset();
+				heapCapacity = 0;
+				std::memcpy(inlineData(), other.inlineData(), other.count * sizeof(T));
+			}
+			count = other.count;
+			other.heapCapacity = 0;
+			other.count = 0;
+		}
+		return *this;
+	}
+
+	iterator begin() { return data(); }
+	iterator end() { return data() + count; }
+	const_iterator begin() const { return data(); }
+	const_iterator end() const { return data() + count; }
+
+	T *data() { return heap ? heap.get() : inlineData(); }
+	const T *data() const { return heap ? heap.get() : inlineData(); }
+
+	size_t size() const { return count; }
+	bool empty() const { return !count; }
+	size_t capacity() const { return heap ? heapCapacity : N; }
+
+	T &operator[](size_t index) { return data()[index]; }
+	const T &operator[](size_t index) const { return data()[index]; }
+	T &front() { return data()[0]; }
+	T &back() { return data()[count - 1]; }
+	const T &front() const { return data()[0]; }
+	const T &back() const { return data()[count - 1]; }
+
+	void push_back(const T &value) { insert(end(), value); }
+	void pop_back() { count--; }
+
+	iterator insert(const_iterator position, const T &value) {
+		const size_t index = position - data();
+		// Value can refer to an element, it's copied before elements are moved
+		const T copy = value;
+		reserve(count + 1);
+		T *elements = data();
+		std::memmove(elements + index + 1, elements + index, (count - index) * sizeof(T));
+		elements[index] = copy;
+		count++;
+		return elements + index;
+	}
+
+	iterator erase(const_iterator position) {
+		const size_t index = position - data();
+		T *elements = data();
+		std::memmove(elements + index, elements + index + 1, (count - index - 1) * sizeof(T));
+		count--;
+		return elements + index;
+	}
+
+	void clear() { count = 0; }
+
+	void reserve(size_t newCapacity) {
+		if (newCapacity <= capacity())
+			return;
+		newCapacity = std::max(newCapacity, capacity() * 2);
+		auto newHeap = std::make_unique<T[]>(newCapacity);
+		std::memcpy(newHeap.get(), data(), count * sizeof(T));
+		heap = std::move(newHeap);
+		heapCapacity = newCapacity;
+	}
+
+private:
+	T *inlineData() { return reinterpret_cast<T *>(&storage); }
+	const T *inlineData() const { return reinterpret_cast<const T *>(&storage); }
+
+private:
+	std::aligned_storage_t<sizeof(T) * N, alignof(T)> storage;
+	std::unique_ptr<T[]> heap;
+	size_t heapCapacity{0};
+	size_t count{0};
+};
+
+} // namespace uf
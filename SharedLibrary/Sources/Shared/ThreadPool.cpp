@@ -0,0 +1,120 @@
+#include "ThreadPool.h"
+
+#include <algorithm>
+
+#include <Shared/Profiling/Tracer.h>
+
+namespace uf {
+
+ThreadPool::ThreadPool(uint threadsCount) {
+	for (uint i = 0; i <= threadsCount; i++)
+		queues.push_back(std::make_unique<Queue>());
+	for (uint i = 0; i < threadsCount; i++)
+		threads.emplace_back(&ThreadPool::working, this, i);
+}
+
+ThreadPool::~ThreadPool() {
+	{
+		std::unique_lock<std::mutex> lock(sleepMutex);
+		stopping = true;
+	}
+	wakeup.notify_all();
+	for (auto &thread : threads)
+		thread.join();
+}
+
+void ThreadPool::ParallelFor(size_t count, const std::function<void(size_t)> &func) {
+	if (threads.empty() || count == 1) {
+		for (size_t i = 0; i < count; i++)
+			func(i);
+		return;
+	}
+	if (!count)
+		return;
+
+	Job job;
+	job.func = &func;
+	job.remaining = count;
+
+	// Every queue gets a contiguous range: the owner goes from its end, thieves take from its beginning
+	const size_t perQueue = (count + queues.size() - 1) / queues.size();
+	for (size_t queue = 0; queue < queues.size(); queue++) {
+		std::unique_lock<std::mutex> lock(queues[queue]->mutex);
+		for (size_t i = queue * perQueue; i < std::min(count, (queue + 1) * perQueue); i++)
+			queues[queue]->tasks.push_back({ &job, i });
+	}
+	{
+		std::unique_lock<std::mutex> lock(sleepMutex);
+		queued += count;
+	}
+	wakeup.notify_all();
+
+	const size_t callerQueue = queues.size() - 1;
+	Task task;
+	while (job.remaining.load(std::memory_order_acquire)) {
+		if (pop(callerQueue, task) || steal(callerQueue, task))
+			run(task);
+		else
+			std::this_thread::yield();
+	}
+
+	if (job.error)
+		std::rethrow_exception(job.error);
+}
+
+bool ThreadPool::pop(size_t queue, Task &task) {
+	auto &own = *queues[queue];
+	std::unique_lock<std::mutex> lock(own.mutex);
+	if (own.tasks.empty())
+		return false;
+	task = own.tasks.back();
+	own.tasks.pop_back();
+	queued--;
+	return true;
+}
+
+bool ThreadPool::steal(size_t thief, Task &task) {
+	for (size_t i = 1; i < queues.size(); i++) {
+		auto &victim = *queues[(thief + i) % queues.size()];
+		std::unique_lock<std::mutex> lock(victim.mutex);
+		if (victim.tasks.empty())
+			continue;
+		task = victim.tasks.front();
+		victim.tasks.pop_front();
+		queued--;
+		return true;
+	}
+	return false;
+}
+
+void ThreadPool::run(const Task &task) {
+	Job &job = *task.job;
+	try {
+		(*job.func)(task.index);
+	} catch (...) {
+		std::unique_lock<std::mutex> lock(job.errorMutex);
+		if (!job.error)
+			job.error = std::current_exception();
+	}
+	// The job lives on the caller stack until remaining is zero, so it's the last access
+	job.remaining.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+void ThreadPool::working(size_t index) {
+	Tracer::Get().SetThreadName("pool");
+
+	Task task;
+	while (true) {
+		if (pop(index, task) || steal(index, task)) {
+			run(task);
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(sleepMutex);
+		wakeup.wait(lock, [this] { return stopping || queued.load() > 0; });
+		if (stopping)
+			return;
+	}
+}
+
+} // namespace uf
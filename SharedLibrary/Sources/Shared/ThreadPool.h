@@ -0,0 +1,68 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <Shared/Types.hpp>
+
+namespace uf {
+
+// Work-stealing pool for data parallel loops.
+// Every thread has its own queue: the owner takes tasks from the back, idle threads steal from the front.
+// Caller of ParallelFor works too, so the pool without threads runs everything serially.
+class ThreadPool {
+public:
+	explicit ThreadPool(uint threads);
+	~ThreadPool();
+
+	ThreadPool(const ThreadPool &) = delete;
+	ThreadPool &operator=(const ThreadPool &) = delete;
+
+	// Calls func(i) for every i in [0, count) and waits for all of them.
+	// The first exception thrown by func is rethrown after all calls are finished.
+	// Should be called by one thread at a time.
+	void ParallelFor(size_t count, const std::function<void(size_t)> &func);
+
+	uint GetThreadsCount() const { return uint(threads.size()); }
+
+private:
+	struct Job {
+		const std::function<void(size_t)> *func;
+		std::atomic<size_t> remaining{0};
+		std::mutex errorMutex;
+		std::exception_ptr error;
+	};
+
+	struct Task {
+		Job *job;
+		size_t index;
+	};
+
+	struct Queue {
+		std::mutex mutex;
+		std::deque<Task> tasks;
+	};
+
+	bool pop(size_t queue, Task &task);
+	bool steal(size_t thief, Task &task);
+	void run(const Task &task);
+	void working(size_t index);
+
+private:
+	// Queue of every thread, the last one is the caller's
+	std::vector<uptr<Queue>> queues;
+	std::vector<std::thread> threads;
+
+	std::atomic<size_t> queued{0};
+	std::mutex sleepMutex;
+	std::condition_variable wakeup;
+	bool stopping{false};
+};
+
+} // namespace uf
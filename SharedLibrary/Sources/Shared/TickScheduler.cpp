@@ -0,0 +1,80 @@
+#include "TickScheduler.h"
+
+#include <algorithm>
+#include <thread>
+
+#include <Shared/ErrorHandling.h>
+
+namespace uf {
+
+TickSchedulerStats TickSchedulerStats::operator-(const TickSchedulerStats &other) const {
+	TickSchedulerStats result;
+	result.elapsed = elapsed - other.elapsed;
+	result.ticks = ticks - other.ticks;
+	result.lateTicks = lateTicks - other.lateTicks;
+	result.droppedTicks = droppedTicks - other.droppedTicks;
+	result.jitter = jitter - other.jitter;
+	return result;
+}
+
+double TickSchedulerStats::TickRate() const {
+	const double seconds = std::chrono::duration<double>(elapsed).count();
+	return seconds > 0 ? double(ticks) / seconds : 0;
+}
+
+TickScheduler::TickScheduler(uint ticksPerSecond, TickWaitMode mode, uint maxCatchUp) :
+	ticksPerSecond(ticksPerSecond),
+	period(std::chrono::microseconds(std::chrono::seconds(1)) / std::max(ticksPerSecond, 1u)),
+	mode(mode),
+	maxCatchUp(std::max(maxCatchUp, 1u))
+{
+	EXPECT(ticksPerSecond);
+}
+
+void TickScheduler::WaitForNextTick() {
+	auto now = Clock::now();
+	if (!started) {
+		started = true;
+		start = deadline = now;
+	}
+
+	if (now < deadline) {
+		wait(deadline);
+		jitter.Record(Clock::now() - deadline);
+	} else if (ticks) {
+		lateTicks++;
+		// Too far behind, catching up would run a burst of ticks
+		const auto behind = uint64_t((now - deadline) / period);
+		if (behind >= maxCatchUp) {
+			droppedTicks += behind;
+			deadline += behind * period;
+		}
+	}
+
+	ticks++;
+	deadline += period;
+}
+
+TickSchedulerStats TickScheduler::GetStats() const {
+	TickSchedulerStats stats;
+	stats.elapsed = started ? Clock::now() - start : Clock::duration::zero();
+	stats.ticks = ticks;
+	stats.lateTicks = lateTicks;
+	stats.droppedTicks = droppedTicks;
+	stats.jitter = jitter.Snapshot();
+	return stats;
+}
+
+void TickScheduler::wait(Clock::time_point deadline) const {
+	if (mode == TickWaitMode::HYBRID) {
+		const auto sleepDeadline = deadline - SPIN_WINDOW;
+		if (Clock::now() < sleepDeadline)
+			std::this_thread::sleep_until(sleepDeadline);
+		while (Clock::now() < deadline)
+			std::this_thread::yield();
+	} else {
+		std::this_thread::sleep_until(deadline);
+	}
+}
+
+} // namespace uf
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+#include <Shared/Types.hpp>
+#include <Shared/Profiling/Histogram.h>
+
+namespace uf {
+
+enum class TickWaitMode {
+	// Sleeps till the deadline, the lowest CPU usage
+	SLEEP,
+	// Sleeps till the deadline is close, then spins. Low jitter for the cost of a bit of CPU.
+	HYBRID
+};
+
+struct TickSchedulerStats {
+	std::chrono::steady_clock::duration elapsed{0};
+	uint64_t ticks{0};
+	// Started after their deadline to catch up with the schedule
+	uint64_t lateTicks{0};
+	// Skipped when catch-up is too long
+	uint64_t droppedTicks{0};
+	// How late on time ticks start after their deadline
+	HistogramSnapshot jitter;
+
+	// Stats between other and this
+	TickSchedulerStats operator-(const TickSchedulerStats &other) const;
+
+	double TickRate() const;
+};
+
+// Fixed timestep scheduler. Tick deadlines are start + n * period, so sleep errors don't accumulate.
+// If ticks overrun, the next ones run without waiting until the schedule is caught up.
+// If the game is behind by more than maxCatchUp ticks, the missed ticks are dropped.
+class TickScheduler {
+public:
+	using Clock = std::chrono::steady_clock;
+
+	explicit TickScheduler(uint ticksPerSecond, TickWaitMode mode = TickWaitMode::HYBRID, uint maxCatchUp = 5);
+
+	// Blocks until the next tick should start
+	void WaitForNextTick();
+
+	// Game time of every tick
+	std::chrono::microseconds GetPeriod() const { return period; }
+	uint GetTickRate() const { return ticksPerSecond; }
+
+	TickSchedulerStats GetStats() const;
+
+private:
+	void wait(Clock::time_point deadline) const;
+
+private:
+	// Spinning part of hybrid wait, covers sleep overshoot of most OS schedulers
+	const std::chrono::microseconds SPIN_WINDOW{2000};
+
+	const uint ticksPerSecond;
+	const std::chrono::microseconds period;
+	const TickWaitMode mode;
+	const uint maxCatchUp;
+
+	bool started{false};
+	Clock::time_point start;
+	Clock::time_point deadline;
+
+	uint64_t ticks{0};
+	uint64_t lateTicks{0};
+	uint64_t droppedTicks{0};
+	Histogram jitter;
+};
+
+} // namespace uf
@@ -0,0 +1,146 @@
+#include "TimerWheel.h"
+
+#include <algorithm>
+
+namespace uf {
+
+TimerWheel::TimerWheel(std::chrono::microseconds resolution) :
+	resolution(resolution)
+{
+	heads.fill(NIL);
+}
+
+TimerWheel::Handle TimerWheel::Add(std::chrono::microseconds delay, Callback callback) {
+	uint32_t index;
+	if (freeNodes.empty()) {
+		index = uint32_t(nodes.size());
+		nodes.emplace_back();
+	} else {
+		index = freeNodes.back();
+		freeNodes.pop_back();
+	}
+
+	// Part of the current step is passed already
+	const int64_t steps = (std::max(delay, delay.zero()) + accumulated + resolution - std::chrono::microseconds(1)) / resolution;
+
+	Node &node = nodes[index];
+	node.callback = std::move(callback);
+	node.expiry = now + uint64_t(std::max<int64_t>(steps, 1));
+	place(index);
+	pendingCount++;
+	return { index, node.generation };
+}
+
+bool TimerWheel::Cancel(Handle handle) {
+	if (!IsPending(handle))
+		return false;
+	unlink(handle.index);
+	release(handle.index);
+	return true;
+}
+
+bool TimerWheel::IsPending(Handle handle) const {
+	return handle.index < nodes.size() && nodes[handle.index].generation == handle.generation && nodes[handle.index].list != NIL;
+}
+
+void TimerWheel::Advance(std::chrono::microseconds elapsed) {
+	fireExpired();
+
+	accumulated += elapsed;
+	while (accumulated >= resolution) {
+		if (!pendingCount) {
+			// Nothing to cascade or fire, so steps can be skipped at once
+			now += uint64_t(accumulated / resolution);
+			accumulated %= resolution;
+			return;
+		}
+		accumulated -= resolution;
+		step();
+		fireExpired();
+	}
+}
+
+void TimerWheel::place(uint32_t index) {
+	const uint64_t expiry = nodes[index].expiry;
+	if (expiry <= now) {
+		link(index, EXPIRED_LIST);
+		return;
+	}
+
+	const uint64_t delta = expiry - now;
+	for (uint32_t level = 0; level < LEVELS; level++) {
+		if (delta < (uint64_t(1) << (SLOT_BITS * (level + 1)))) {
+			link(index, level * SLOTS + uint32_t((expiry >> (SLOT_BITS * level)) & (SLOTS - 1)));
+			return;
+		}
+	}
+	link(index, OVERFLOW_LIST);
+}
+
+void TimerWheel::link(uint32_t index, uint32_t list) {
+	Node &node = nodes[index];
+	node.list = list;
+	node.previous = NIL;
+	node.next = heads[list];
+	if (node.next != NIL)
+		nodes[node.next].previous = index;
+	heads[list] = index;
+}
+
+void TimerWheel::unlink(uint32_t index) {
+	Node &node = nodes[index];
+	if (node.previous != NIL)
+		nodes[node.previous].next = node.next;
+	else
+		heads[node.list] = node.next;
+	if (node.next != NIL)
+		nodes[node.next].previous = node.previous;
+	node.list = NIL;
+}
+
+void TimerWheel::release(uint32_t index) {
+	Node &node = nodes[index];
+	node.callback = nullptr;
+	// Old handles become invalid. Zero generation is reserved for empty handle.
+	if (!++node.generation)
+		node.generation = 1;
+	freeNodes.push_back(index);
+	pendingCount--;
+}
+
+void TimerWheel::cascade(uint32_t list) {
+	uint32_t index = heads[list];
+	heads[list] = NIL;
+	while (index != NIL) {
+		const uint32_t next = nodes[index].next;
+		place(index);
+		index = next;
+	}
+}
+
+void TimerWheel::step() {
+	now++;
+
+	// Higher levels first: their timers can move to slots of lower levels which are reached now
+	if (!(now & ((uint64_t(1) << (SLOT_BITS * LEVELS)) - 1)))
+		cascade(OVERFLOW_LIST);
+	for (uint32_t level = LEVELS - 1; level > 0; level--) {
+		if (!(now & ((uint64_t(1) << (SLOT_BITS * level)) - 1)))
+			cascade(level * SLOTS + uint32_t((now >> (SLOT_BITS * level)) & (SLOTS - 1)));
+	}
+	// Timers of the current level 0 slot are expired, they go to the expired list
+	cascade(uint32_t(now & (SLOTS - 1)));
+}
+
+void TimerWheel::fireExpired() {
+	while (heads[EXPIRED_LIST] != NIL) {
+		const uint32_t index = heads[EXPIRED_LIST];
+		Callback callback = std::move(nodes[index].callback);
+		unlink(index);
+		release(index);
+		if (callback)
+			callback();
+	}
+}
+
+} // namespace uf
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace uf {
+
+// Hierarchical timing wheel: O(1) Add and Cancel, expired timers are fired slot by slot.
+// Time is counted in steps of resolution. Level 0 has a slot for each of the next 64 steps,
+// every next level covers 64 slots of the previous one. Timers of a higher level slot are moved down
+// when time reaches it, so every timer is moved at most LEVELS times.
+// Not thread-safe.
+class TimerWheel {
+public:
+	using Callback = std::function<void()>;
+
+	// Identifies the timer. It's safe to use after the timer is fired or cancelled.
+	struct Handle {
+		uint32_t index{0};
+		uint32_t generation{0};
+
+		explicit operator bool() const { return generation != 0; }
+	};
+
+	explicit TimerWheel(std::chrono::microseconds resolution = std::chrono::milliseconds(1));
+
+	TimerWheel(const TimerWheel &) = delete;
+	TimerWheel &operator=(const TimerWheel &) = delete;
+
+	// Callback is called by Advance, not earlier than delay (rounded up to resolution) from now
+	Handle Add(std::chrono::microseconds delay, Callback callback);
+	// return false if the timer is fired or cancelled already
+	bool Cancel(Handle handle);
+	bool IsPending(Handle handle) const;
+
+	// Fires timers expired within elapsed time in expiry order.
+	// Timers added by callbacks with small delay are fired on the next Advance.
+	// If callback throws, the rest of expired timers are fired on the next Advance.
+	void Advance(std::chrono::microseconds elapsed);
+
+	size_t GetPendingCount() const { return pendingCount; }
+
+private:
+	static constexpr uint32_t SLOT_BITS = 6;
+	static constexpr uint32_t SLOTS = 1 << SLOT_BITS;
+	static constexpr uint32_t LEVELS = 4;
+	// Timers beyond the last level wait here until the last level wraps
+	static constexpr uint32_t OVERFLOW_LIST = SLOTS * LEVELS;
+	// Timers of the current step which aren't fired yet
+	static constexpr uint32_t EXPIRED_LIST = OVERFLOW_LIST + 1;
+	static constexpr uint32_t NIL = UINT32_MAX;
+
+	struct Node {
+		Callback callback;
+		uint64_t expiry;
+		uint32_t generation{1};
+		uint32_t list{NIL};
+		uint32_t previous{NIL};
+		uint32_t next{NIL};
+	};
+
+	void place(uint32_t index);
+	void link(uint32_t index, uint32_t list);
+	void unlink(uint32_t index);
+	void release(uint32_t index);
+	// Moves timers of the list to their places for the current time
+	void cascade(uint32_t list);
+	void step();
+	void fireExpired();
+
+private:
+	const std::chrono::microseconds resolution;
+	std::chrono::microseconds accumulated{0};
+	uint64_t now{0};
+
+	std::vector<Node> nodes;
+	std::vector<uint32_t> freeNodes;
+	std::array<uint32_t, EXPIRED_LIST + 1> heads;
+	size_t pendingCount{0};
+};
+
+} // namespace uf
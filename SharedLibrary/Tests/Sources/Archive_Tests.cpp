@@ -0,0 +1,84 @@
+#include <Shared/Network/Archive.h>
+#include <Shared/Network/Protocol/ServerToClient/Commands.h>
+
+#include <gtest/gtest.h>
+
+using namespace network::protocol;
+
+namespace {
+
+std::shared_ptr<AddDiff> createAddDiff() {
+	auto diff = std::make_shared<AddDiff>();
+	diff->objId = 42;
+	diff->objectInfo.id = 42;
+	diff->objectInfo.name = "Airlock";
+	diff->objectInfo.spriteIds = { 1, 2, 3 };
+	diff->objectInfo.layer = 40;
+	diff->objectInfo.direction = uf::Direction::SOUTH;
+	diff->objectInfo.moveSpeed = 0;
+	diff->objectInfo.speed = uf::vec2f(0);
+	diff->coords = uf::vec3i(1, 2, 3);
+	diff->layer = 40;
+	return diff;
+}
+
+std::vector<char> toBytes(const sf::Packet &packet) {
+	auto data = reinterpret_cast<const char *>(packet.getData());
+	return std::vector<char>(data, data + packet.getDataSize());
+}
+
+} // namespace
+
+TEST(Archive, SerializeCachedWritesSameBytesAsSerialize) {
+	auto diff = createAddDiff();
+
+	sf::Packet plain;
+	uf::InputArchive plainAr(plain);
+	diff->Serialize(plainAr);
+
+	sf::Packet cached;
+	uf::InputArchive cachedAr(cached);
+	diff->SerializeCached(cachedAr);
+	diff->SerializeCached(cachedAr);
+
+	auto plainBytes = toBytes(plain);
+	auto cachedBytes = toBytes(cached);
+	ASSERT_EQ(plainBytes.size() * 2, cachedBytes.size());
+	EXPECT_TRUE(std::equal(plainBytes.begin(), plainBytes.end(), cachedBytes.begin()));
+	EXPECT_TRUE(std::equal(plainBytes.begin(), plainBytes.end(), cachedBytes.begin() + plainBytes.size()));
+}
+
+TEST(Archive, GraphicsUpdateCommandWithCachedDiffsIsDecoded) {
+	auto addDiff = createAddDiff();
+	auto moveDiff = std::make_shared<MoveDiff>();
+	moveDiff->objId = 7;
+	moveDiff->direction = uf::Direction::NORTH;
+	moveDiff->speed = 2.5f;
+
+	server::GraphicsUpdateCommand command;
+	command.options = server::GraphicsUpdateCommand::Option::DIFFERENCES;
+	command.diffs = { addDiff, moveDiff };
+
+	sf::Packet packet;
+	uf::InputArchive input(packet);
+	input << command;
+
+	uf::OutputArchive output(packet);
+	auto unpacked = output.UnpackSerializable();
+	auto *decoded = dynamic_cast<server::GraphicsUpdateCommand *>(unpacked.get());
+	ASSERT_TRUE(decoded);
+	ASSERT_EQ(decoded->diffs.size(), 2u);
+
+	auto *decodedAdd = dynamic_cast<AddDiff *>(decoded->diffs[0].get());
+	ASSERT_TRUE(decodedAdd);
+	EXPECT_EQ(decodedAdd->objId, 42u);
+	EXPECT_EQ(decodedAdd->objectInfo.name, "Airlock");
+	EXPECT_EQ(decodedAdd->objectInfo.spriteIds, std::vector<uint32_t>({ 1, 2, 3 }));
+	EXPECT_TRUE(decodedAdd->coords == uf::vec3i(1, 2, 3));
+
+	auto *decodedMove = dynamic_cast<MoveDiff *>(decoded->diffs[1].get());
+	ASSERT_TRUE(decodedMove);
+	EXPECT_EQ(decodedMove->objId, 7u);
+	EXPECT_EQ(decodedMove->direction, uf::Direction::NORTH);
+	EXPECT_FLOAT_EQ(decodedMove->speed, 2.5f);
+}
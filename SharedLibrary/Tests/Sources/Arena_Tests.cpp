@@ -0,0 +1,58 @@
+#include <Shared/Arena.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace {
+
+struct Tracked {
+	Tracked(std::vector<int> &destroyed, int id) : destroyed(destroyed), id(id) { }
+	~Tracked() { destroyed.push_back(id); }
+
+	std::vector<int> &destroyed;
+	int id;
+};
+
+} // namespace
+
+TEST(Arena, ResetDestroysInReverseOrder) {
+	std::vector<int> destroyed;
+	uf::Arena arena(128);
+	for (int i = 0; i < 100; i++)
+		EXPECT_EQ(arena.Create<Tracked>(destroyed, i)->id, i);
+	EXPECT_EQ(arena.GetObjectsCount(), 100u);
+
+	arena.Reset();
+	ASSERT_EQ(destroyed.size(), 100u);
+	for (int i = 0; i < 100; i++)
+		EXPECT_EQ(destroyed[i], 99 - i);
+	EXPECT_EQ(arena.GetObjectsCount(), 0u);
+	EXPECT_EQ(arena.GetBytesUsed(), 0u);
+}
+
+TEST(Arena, ReusesBlocksAfterReset) {
+	uf::Arena arena(1024);
+	for (int tick = 0; tick < 10; tick++) {
+		for (int i = 0; i < 1000; i++) {
+			auto *text = arena.Create<std::string>(100, 'a');
+			EXPECT_EQ(text->size(), 100u);
+			auto *value = arena.Create<double>(i);
+			EXPECT_EQ(reinterpret_cast<uintptr_t>(value) % alignof(double), 0u);
+		}
+		arena.Reset();
+	}
+	const size_t blocks = arena.GetBlocksCount();
+	for (int i = 0; i < 1000; i++) {
+		arena.Create<std::string>(100, 'a');
+		arena.Create<double>(i);
+	}
+	EXPECT_EQ(arena.GetBlocksCount(), blocks);
+
+	// Oversized object gets its own block
+	auto *big = static_cast<char *>(arena.Allocate(4096, 64));
+	EXPECT_EQ(reinterpret_cast<uintptr_t>(big) % 64, 0u);
+	big[4095] = 1;
+}
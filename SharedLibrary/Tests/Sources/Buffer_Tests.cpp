@@ -0,0 +1,120 @@
+#include <Shared/Network/Archive.h>
+#include <Shared/Network/Buffer.h>
+#include <Shared/Network/Protocol/ServerToClient/Commands.h>
+
+#include <cstring>
+#include <memory_resource>
+
+#include <gtest/gtest.h>
+
+using namespace network::protocol;
+
+namespace {
+
+server::GraphicsUpdateCommand createCommand() {
+	auto moveDiff = std::make_shared<MoveDiff>();
+	moveDiff->objId = 7;
+	moveDiff->direction = uf::Direction::NORTH;
+	moveDiff->speed = 2.5f;
+
+	TileInfo tileInfo;
+	tileInfo.coords = uf::vec3i(1, 2, 3);
+	tileInfo.sprite = 5;
+
+	server::GraphicsUpdateCommand command;
+	command.options = server::GraphicsUpdateCommand::Option::TILES_SHIFT | server::GraphicsUpdateCommand::Option::DIFFERENCES;
+	command.firstTile = uf::vec3i(-1, 0, 1);
+	command.tilesInfo = { tileInfo };
+	command.diffs = { moveDiff };
+	return command;
+}
+
+} // namespace
+
+TEST(Buffer, WritesSameBytesAsPacket) {
+	sf::Packet packet;
+	packet << true << sf::Int8(-3) << sf::Uint16(0xABCD) << sf::Int32(-123456) << sf::Uint64(0x0102030405060708ull)
+	       << 1.5f << 2.25 << std::string("text");
+
+	uf::Buffer buffer;
+	buffer << true << sf::Int8(-3) << sf::Uint16(0xABCD) << sf::Int32(-123456) << sf::Uint64(0x0102030405060708ull)
+	       << 1.5f << 2.25 << std::string("text");
+
+	ASSERT_EQ(packet.getDataSize(), buffer.GetSize());
+	EXPECT_EQ(0, std::memcmp(packet.getData(), buffer.GetData(), buffer.GetSize()));
+}
+
+TEST(Buffer, ReadsWrittenValues) {
+	uf::Buffer buffer;
+	buffer << sf::Int16(-2) << sf::Uint32(42) << std::string("airlock") << 0.5f;
+
+	sf::Int16 i16; sf::Uint32 u32; std::string str; float f;
+	buffer >> i16 >> u32 >> str >> f;
+
+	EXPECT_TRUE(buffer);
+	EXPECT_TRUE(buffer.EndOfBuffer());
+	EXPECT_EQ(i16, -2);
+	EXPECT_EQ(u32, 42u);
+	EXPECT_EQ(str, "airlock");
+	EXPECT_FLOAT_EQ(f, 0.5f);
+
+	sf::Int32 excess;
+	buffer >> excess;
+	EXPECT_FALSE(buffer);
+}
+
+TEST(Buffer, FrameHasPacketSizePrefix) {
+	uf::Buffer buffer;
+	buffer.BeginFrame();
+	buffer << sf::Int32(1) << sf::Int32(2);
+	buffer.EndFrame();
+
+	ASSERT_EQ(buffer.GetSize(), 12u);
+	sf::Uint32 size;
+	buffer >> size;
+	EXPECT_EQ(size, 8u);
+}
+
+TEST(Buffer, PoolReusesBuffers) {
+	uf::BufferPool pool;
+	const uf::Buffer *first;
+	{
+		auto buffer = pool.Acquire();
+		*buffer << sf::Int32(1);
+		first = buffer.get();
+	}
+	auto buffer = pool.Acquire();
+	EXPECT_EQ(buffer.get(), first);
+	EXPECT_EQ(buffer->GetSize(), 0u);
+}
+
+TEST(Buffer, ArchiveDecodesBufferIntoArena) {
+	auto command = createCommand();
+
+	uf::Buffer buffer;
+	uf::InputArchive input(buffer);
+	input << command;
+
+	sf::Packet packet;
+	uf::InputArchive packetInput(packet);
+	packetInput << command;
+	ASSERT_EQ(packet.getDataSize(), buffer.GetSize());
+	EXPECT_EQ(0, std::memcmp(packet.getData(), buffer.GetData(), buffer.GetSize()));
+
+	std::pmr::unsynchronized_pool_resource arena;
+	uf::Buffer view(buffer.GetData(), buffer.GetSize());
+	uf::OutputArchive output(view);
+	output.SetMemoryResource(&arena);
+
+	server::GraphicsUpdateCommand decoded;
+	output >> decoded;
+
+	EXPECT_TRUE(decoded.firstTile == uf::vec3i(-1, 0, 1));
+	ASSERT_EQ(decoded.tilesInfo.size(), 1u);
+	EXPECT_EQ(decoded.tilesInfo[0].sprite, 5u);
+	ASSERT_EQ(decoded.diffs.size(), 1u);
+	auto *decodedMove = dynamic_cast<MoveDiff *>(decoded.diffs[0].get());
+	ASSERT_TRUE(decodedMove);
+	EXPECT_EQ(decodedMove->objId, 7u);
+	EXPECT_FLOAT_EQ(decodedMove->speed, 2.5f);
+}
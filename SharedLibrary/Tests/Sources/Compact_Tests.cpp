@@ -0,0 +1,133 @@
+#include <Shared/Network/Archive.h>
+#include <Shared/Network/Buffer.h>
+#include <Shared/Network/Compact.h>
+#include <Shared/Network/NameTable.h>
+#include <Shared/Network/Protocol/ServerToClient/Commands.h>
+
+#include <limits>
+
+#include <gtest/gtest.h>
+
+using namespace network::protocol;
+
+namespace {
+
+ObjectInfo createObjectInfo(uint32_t id, const std::string &name) {
+	ObjectInfo info;
+	info.id = id;
+	info.name = name;
+	info.spriteIds = { 300, 2 };
+	info.layer = 40;
+	info.direction = uf::Direction::SOUTH;
+	info.opacity.SetFractions({});
+	info.moveSpeed = 0;
+	info.speed = uf::vec2f(0);
+	return info;
+}
+
+server::GraphicsUpdateCommand createCommand() {
+	server::GraphicsUpdateCommand command;
+	command.options = server::GraphicsUpdateCommand::Option::TILES_SHIFT | server::GraphicsUpdateCommand::Option::DIFFERENCES;
+	command.firstTile = uf::vec3i(100, 200, 1);
+	for (int x = 0; x < 4; x++) {
+		TileInfo tileInfo;
+		tileInfo.coords = command.firstTile + uf::vec3i(x, 1, 0);
+		tileInfo.sprite = 5;
+		tileInfo.content = { createObjectInfo(x, "Airlock"), createObjectInfo(x + 10, "Wall") };
+		command.tilesInfo.push_back(std::move(tileInfo));
+	}
+
+	auto addDiff = std::make_shared<AddDiff>();
+	addDiff->objId = 42;
+	addDiff->objectInfo = createObjectInfo(42, "Engineer");
+	addDiff->objectInfo.moveSpeed = 4;
+	addDiff->coords = uf::vec3i(101, 202, 1);
+	addDiff->layer = 75;
+	command.diffs = { addDiff };
+	return command;
+}
+
+} // namespace
+
+TEST(Compact, VarintsAreShort) {
+	uf::NameTable names;
+	uf::Buffer buffer;
+	uf::InputArchive input(buffer);
+	input.SetCompact(&names);
+
+	uint32_t small = 5, medium = 300;
+	int negative = -1, min = std::numeric_limits<int>::min();
+	uf::SerializeVarint(input, small);
+	uf::SerializeVarint(input, medium);
+	uf::SerializeVarint(input, negative);
+	uf::SerializeVarint(input, min);
+	EXPECT_EQ(buffer.GetSize(), 1u + 2u + 1u + 5u);
+
+	uf::OutputArchive output(buffer);
+	output.SetCompact(&names);
+	uint32_t decodedSmall, decodedMedium;
+	int decodedNegative, decodedMin;
+	uf::SerializeVarint(output, decodedSmall);
+	uf::SerializeVarint(output, decodedMedium);
+	uf::SerializeVarint(output, decodedNegative);
+	uf::SerializeVarint(output, decodedMin);
+	EXPECT_EQ(decodedSmall, small);
+	EXPECT_EQ(decodedMedium, medium);
+	EXPECT_EQ(decodedNegative, negative);
+	EXPECT_EQ(decodedMin, min);
+}
+
+TEST(Compact, GraphicsUpdateCommandIsDecoded) {
+	auto command = createCommand();
+
+	uf::NameTable serverNames;
+	uf::Buffer buffer;
+	uf::InputArchive input(buffer);
+	input.SetCompact(&serverNames);
+	input << command;
+
+	// Client gets names before the command
+	uf::NameTable clientNames;
+	for (auto &name : serverNames.GetNames(0))
+		clientNames.Add(name);
+	EXPECT_EQ(clientNames.Size(), 3u);
+
+	uf::OutputArchive output(buffer);
+	output.SetCompact(&clientNames);
+	auto unpacked = output.UnpackSerializable();
+	auto *decoded = dynamic_cast<server::GraphicsUpdateCommand *>(unpacked.get());
+	ASSERT_TRUE(decoded);
+	EXPECT_TRUE(buffer.EndOfBuffer());
+
+	EXPECT_TRUE(decoded->firstTile == command.firstTile);
+	ASSERT_EQ(decoded->tilesInfo.size(), 4u);
+	EXPECT_TRUE(decoded->tilesInfo[3].coords == uf::vec3i(103, 201, 1));
+	ASSERT_EQ(decoded->tilesInfo[3].content.size(), 2u);
+	EXPECT_EQ(decoded->tilesInfo[3].content[1].name, "Wall");
+	EXPECT_EQ(decoded->tilesInfo[3].content[1].spriteIds, std::vector<uint32_t>({ 300, 2 }));
+	EXPECT_EQ(decoded->tilesInfo[3].content[1].moveSpeed, 0);
+
+	ASSERT_EQ(decoded->diffs.size(), 1u);
+	auto *addDiff = dynamic_cast<AddDiff *>(decoded->diffs[0].get());
+	ASSERT_TRUE(addDiff);
+	EXPECT_EQ(addDiff->objectInfo.name, "Engineer");
+	EXPECT_FLOAT_EQ(addDiff->objectInfo.moveSpeed, 4);
+	EXPECT_TRUE(addDiff->coords == uf::vec3i(101, 202, 1));
+	EXPECT_EQ(addDiff->layer, 75u);
+}
+
+TEST(Compact, CompactCommandIsSmaller) {
+	auto command = createCommand();
+
+	uf::Buffer plain;
+	uf::InputArchive plainAr(plain);
+	plainAr << command;
+
+	uf::NameTable names;
+	uf::Buffer compact;
+	uf::InputArchive compactAr(compact);
+	compactAr.SetCompact(&names);
+	compactAr << command;
+
+	EXPECT_LT(compact.GetSize() * 2, plain.GetSize());
+}
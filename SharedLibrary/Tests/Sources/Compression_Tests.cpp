@@ -0,0 +1,85 @@
+#include <Shared/Network/Compression.h>
+#include <Shared/ErrorHandling.h>
+
+#include <random>
+
+#include <gtest/gtest.h>
+
+namespace {
+
+std::vector<char> generateText(size_t size, unsigned seed) {
+	const std::string words[] = { "Airlock ", "Wall ", "Engineer ", "Table ", "\x01\x02\x03", "Floor " };
+	std::mt19937 random(seed);
+	std::vector<char> text;
+	while (text.size() < size) {
+		auto &word = words[random() % std::size(words)];
+		text.insert(text.end(), word.begin(), word.end());
+		// some noise, so not everything is matched
+		text.push_back(char(random()));
+	}
+	text.resize(size);
+	return text;
+}
+
+std::vector<char> roundTrip(uf::StreamCompressor &compressor, uf::StreamDecompressor &decompressor, const std::vector<char> &data, size_t *compressedSize = nullptr) {
+	uf::Buffer compressed;
+	compressor.Compress(data.data(), data.size(), compressed);
+	if (compressedSize)
+		*compressedSize = compressed.GetSize();
+
+	uf::Buffer decompressed;
+	decompressor.Decompress(compressed.GetData(), compressed.GetSize(), decompressed);
+	return std::vector<char>(decompressed.GetData(), decompressed.GetData() + decompressed.GetSize());
+}
+
+} // namespace
+
+TEST(Compression, PacketsAreRestored) {
+	auto dictionary = generateText(1000, 1);
+	uf::StreamCompressor compressor(dictionary, 64);
+	uf::StreamDecompressor decompressor(dictionary);
+
+	// Small ones are raw, big ones are compressed, stream is longer than window
+	for (unsigned i = 0; i < 300; i++) {
+		auto packet = generateText(i % 3 ? 10 + i : 2000 + i * 7, i + 2);
+		EXPECT_EQ(roundTrip(compressor, decompressor, packet), packet);
+	}
+	EXPECT_LT(compressor.GetCompressedBytes(), compressor.GetRawBytes());
+}
+
+TEST(Compression, RepeatedPacketIsShort) {
+	std::vector<char> dictionary;
+	uf::StreamCompressor compressor(dictionary, 16);
+	uf::StreamDecompressor decompressor(dictionary);
+
+	auto packet = generateText(5000, 7);
+	size_t first, second;
+	EXPECT_EQ(roundTrip(compressor, decompressor, packet, &first), packet);
+	EXPECT_EQ(roundTrip(compressor, decompressor, packet, &second), packet);
+	EXPECT_LT(second, 100u);
+	EXPECT_LT(second, first);
+}
+
+TEST(Compression, DictionaryIsUsed) {
+	auto packet = generateText(500, 3);
+	uf::StreamCompressor primed(packet, 16);
+	uf::StreamCompressor empty({}, 16);
+
+	uf::Buffer primedOut, emptyOut;
+	primed.Compress(packet.data(), packet.size(), primedOut);
+	empty.Compress(packet.data(), packet.size(), emptyOut);
+	EXPECT_LT(primedOut.GetSize() * 4, emptyOut.GetSize());
+}
+
+TEST(Compression, CorruptedPacketThrows) {
+	std::vector<char> dictionary;
+	uf::StreamCompressor compressor(dictionary, 16);
+	uf::StreamDecompressor decompressor(dictionary);
+
+	auto packet = generateText(1000, 5);
+	uf::Buffer compressed;
+	compressor.Compress(packet.data(), packet.size(), compressed);
+
+	uf::Buffer out;
+	EXPECT_THROW(decompressor.Decompress(compressed.GetData(), compressed.GetSize() / 2, out), ExpectationFailedException);
+}
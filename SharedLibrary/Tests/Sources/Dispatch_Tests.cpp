@@ -0,0 +1,68 @@
+#include <Shared/Network/Dispatch.h>
+#include <Shared/Network/Protocol/ServerToClient/Commands.h>
+
+#include <gtest/gtest.h>
+
+using namespace network::protocol;
+
+TEST(Dispatch, CallsHandlerOfExactType) {
+	MoveDiff moveDiff;
+	moveDiff.objId = 5;
+	Diff &diff = moveDiff;
+
+	uint32_t handledId = 0;
+	bool handled = uf::Dispatch<AddDiff, MoveDiff, RemoveDiff>(diff, uf::Overloaded{
+		[&](AddDiff &) { handledId = AddDiff::StaticId(); },
+		[&](MoveDiff &d) { handledId = MoveDiff::StaticId(); EXPECT_EQ(d.objId, 5u); },
+		[&](RemoveDiff &) { handledId = RemoveDiff::StaticId(); }
+	});
+
+	EXPECT_TRUE(handled);
+	EXPECT_EQ(handledId, MoveDiff::StaticId());
+}
+
+TEST(Dispatch, ReturnsFalseForUnlistedType) {
+	StunnedDiff stunnedDiff;
+	Diff &diff = stunnedDiff;
+
+	bool called = false;
+	bool handled = uf::Dispatch<AddDiff, MoveDiff>(diff, [&](auto &) { called = true; });
+
+	EXPECT_FALSE(handled);
+	EXPECT_FALSE(called);
+}
+
+TEST(Dispatch, DerivedTypeIsPassedToBaseOverload) {
+	RelocateAwayDiff relocateAwayDiff;
+	Diff &diff = relocateAwayDiff;
+
+	bool relocated = false;
+	bool handled = uf::Dispatch<RelocateDiff, RelocateAwayDiff>(diff, uf::Overloaded{
+		[&](RelocateDiff &) { relocated = true; }
+	});
+
+	EXPECT_TRUE(handled);
+	EXPECT_TRUE(relocated);
+}
+
+TEST(Dispatch, DispatchesAllServerCommands) {
+	using namespace server;
+
+	std::vector<std::unique_ptr<Command>> commands;
+	commands.push_back(std::make_unique<AuthorizationSuccessCommand>());
+	commands.push_back(std::make_unique<GraphicsUpdateCommand>());
+	commands.push_back(std::make_unique<OverlayResetCommand>());
+	commands.push_back(std::make_unique<AddChatMessageCommand>());
+
+	for (auto &command : commands) {
+		uint32_t handledId = 0;
+		bool handled = uf::Dispatch<
+			AuthorizationSuccessCommand, AuthorizationFailedCommand, RegistrationSuccessCommand, RegistrationFailedCommand,
+			GameJoinSuccessCommand, GameJoinErrorCommand, GraphicsUpdateCommand, ControlUIUpdateCommand,
+			OverlayUpdateCommand, OverlayResetCommand, OpenWindowCommand, UpdateWindowCommand, AddChatMessageCommand
+		>(*command, [&](auto &c) { handledId = std::remove_reference_t<decltype(c)>::StaticId(); });
+
+		EXPECT_TRUE(handled);
+		EXPECT_EQ(handledId, command->Id());
+	}
+}
@@ -0,0 +1,89 @@
+#include <Shared/MPSCQueue.hpp>
+#include <Shared/SPSCRing.hpp>
+
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+TEST(MPSCQueue, KeepsOrderOfEveryProducer) {
+	const int PRODUCERS = 4;
+	const int ITEMS = 10000;
+
+	uf::MPSCQueue<int> queue;
+	std::vector<std::thread> producers;
+	for (int producer = 0; producer < PRODUCERS; producer++)
+		producers.emplace_back([&queue, producer] {
+			for (int i = 0; i < ITEMS; i++)
+				queue.Push(producer * ITEMS + i);
+		});
+
+	std::vector<int> next(PRODUCERS, 0);
+	int received = 0;
+	while (received < PRODUCERS * ITEMS) {
+		if (!queue.Wait(std::chrono::milliseconds(100)))
+			continue;
+		received += int(queue.Drain([&](int value) {
+			int producer = value / ITEMS;
+			EXPECT_EQ(value % ITEMS, next[producer]);
+			next[producer]++;
+		}));
+	}
+	for (auto &producer : producers)
+		producer.join();
+
+	EXPECT_TRUE(queue.Empty());
+	int value;
+	EXPECT_FALSE(queue.TryPop(value));
+	for (int count : next)
+		EXPECT_EQ(count, ITEMS);
+}
+
+TEST(MPSCQueue, WaitTimeout) {
+	uf::MPSCQueue<int *> queue;
+	EXPECT_FALSE(queue.Wait(std::chrono::milliseconds(1)));
+	EXPECT_EQ(queue.Pop(), nullptr);
+
+	int value;
+	queue.Push(&value);
+	EXPECT_TRUE(queue.Wait(std::chrono::milliseconds(1)));
+	EXPECT_EQ(queue.Pop(), &value);
+}
+
+TEST(SPSCRing, FullAndWrapAround) {
+	uf::SPSCRing<int> ring(3);
+	EXPECT_EQ(ring.Capacity(), 4u);
+
+	int value;
+	for (int round = 0; round < 3; round++) {
+		for (int i = 0; i < 4; i++)
+			EXPECT_TRUE(ring.TryPush(round * 4 + i));
+		EXPECT_FALSE(ring.TryPush(-1));
+
+		EXPECT_TRUE(ring.TryPop(value));
+		EXPECT_EQ(value, round * 4);
+		int expected = round * 4 + 1;
+		EXPECT_EQ(ring.Drain([&](int v) { EXPECT_EQ(v, expected++); }), 3u);
+		EXPECT_TRUE(ring.Empty());
+		EXPECT_FALSE(ring.TryPop(value));
+	}
+}
+
+TEST(SPSCRing, ProducerAndConsumerThreads) {
+	const int ITEMS = 100000;
+
+	uf::SPSCRing<int> ring(64);
+	std::thread producer([&ring] {
+		for (int i = 0; i < ITEMS; i++)
+			while (!ring.TryPush(i))
+				std::this_thread::yield();
+	});
+
+	int expected = 0;
+	while (expected < ITEMS) {
+		if (!ring.Drain([&](int value) { EXPECT_EQ(value, expected++); }))
+			std::this_thread::yield();
+	}
+	producer.join();
+	EXPECT_TRUE(ring.Empty());
+}
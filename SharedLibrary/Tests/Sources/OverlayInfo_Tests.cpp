@@ -0,0 +1,87 @@
+#include <Shared/Network/Archive.h>
+#include <Shared/Network/Protocol/ServerToClient/Commands.h>
+
+#include <gtest/gtest.h>
+
+using namespace network::protocol;
+
+namespace {
+
+OverlayInfo createLayer(OverlayValueType type, sf::Uint8 precision, std::vector<std::string> channels) {
+	OverlayInfo layer;
+	layer.type = type;
+	layer.precision = precision;
+	layer.channels = std::move(channels);
+	return layer;
+}
+
+float roundTrip(const OverlayInfo &layer, float value) {
+	sf::Uint8 bytes[4] = {};
+	layer.Pack(value, bytes);
+	return layer.Unpack(bytes);
+}
+
+} // namespace
+
+TEST(OverlayInfo, UnsignedValuesAreRoundedAndClamped) {
+	auto layer = createLayer(OverlayValueType::UInt8, 0, { "Value" });
+	EXPECT_EQ(layer.GetValueSize(), 1u);
+	EXPECT_FLOAT_EQ(roundTrip(layer, 41.6f), 42.f);
+	EXPECT_FLOAT_EQ(roundTrip(layer, -5.f), 0.f);
+	EXPECT_FLOAT_EQ(roundTrip(layer, 300.f), 255.f);
+
+	layer.type = OverlayValueType::UInt32;
+	EXPECT_EQ(layer.GetValueSize(), 4u);
+	EXPECT_FLOAT_EQ(roundTrip(layer, 70000.f), 70000.f);
+}
+
+TEST(OverlayInfo, FloatValuesAreRoundedToPrecision) {
+	auto layer = createLayer(OverlayValueType::Float, 1, { "Pressure" });
+	EXPECT_FLOAT_EQ(roundTrip(layer, 101.34f), 101.3f);
+
+	sf::Uint8 first[4], second[4];
+	layer.Pack(101.31f, first);
+	layer.Pack(101.33f, second);
+	EXPECT_TRUE(std::equal(first, first + 4, second));
+}
+
+TEST(OverlayInfo, FormatSkipsZerosAndNamesSeveralChannels) {
+	auto single = createLayer(OverlayValueType::Float, 1, { "Pressure" });
+	float pressure = 101.3f;
+	EXPECT_EQ(single.Format(&pressure), "101.3");
+	float zero = 0;
+	EXPECT_EQ(single.Format(&zero), "");
+
+	auto gases = createLayer(OverlayValueType::Float, 1, { "O2", "N2", "CO2" });
+	float values[] = { 21.f, 0.f, 0.5f };
+	EXPECT_EQ(gases.Format(values), "O2 21.0\nCO2 0.5");
+}
+
+TEST(OverlayInfo, UpdateCommandIsDecoded) {
+	server::OverlayUpdateCommand command;
+	command.newLayer = true;
+	command.layer = createLayer(OverlayValueType::UInt16, 0, { "Locale" });
+	command.changedCells.resize(2);
+	command.SetChanged(3);
+	command.SetChanged(9);
+	command.values.resize(4);
+	command.layer.Pack(7, command.values.data());
+	command.layer.Pack(1000, command.values.data() + 2);
+
+	sf::Packet packet;
+	uf::InputArchive input(packet);
+	input << command;
+
+	uf::OutputArchive output(packet);
+	auto unpacked = output.UnpackSerializable();
+	auto *decoded = dynamic_cast<server::OverlayUpdateCommand *>(unpacked.get());
+	ASSERT_TRUE(decoded);
+	ASSERT_TRUE(decoded->newLayer);
+	EXPECT_TRUE(decoded->layer == command.layer);
+	for (size_t cell = 0; cell < 16; cell++)
+		EXPECT_EQ(decoded->IsChanged(cell), cell == 3 || cell == 9);
+	EXPECT_FALSE(decoded->IsChanged(100));
+	ASSERT_EQ(decoded->values.size(), 4u);
+	EXPECT_FLOAT_EQ(decoded->layer.Unpack(decoded->values.data()), 7.f);
+	EXPECT_FLOAT_EQ(decoded->layer.Unpack(decoded->values.data() + 2), 1000.f);
+}
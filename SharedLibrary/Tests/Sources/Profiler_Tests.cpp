@@ -0,0 +1,113 @@
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+#include <Shared/Profiling/Profiler.h>
+
+#include <gtest/gtest.h>
+
+using namespace std::chrono_literals;
+
+TEST(Histogram, BucketsContainTheirValues) {
+	for (uint64_t value : { 0ull, 1ull, 7ull, 8ull, 9ull, 100ull, 1000ull, 123456ull, 50000000ull }) {
+		auto index = uf::Histogram::BucketIndex(value);
+		EXPECT_LE(uf::Histogram::BucketLowerBound(index), value);
+		EXPECT_GT(uf::Histogram::BucketUpperBound(index), value);
+	}
+	EXPECT_EQ(uf::Histogram::BucketIndex(~0ull), uf::HISTOGRAM_BUCKETS - 1);
+}
+
+TEST(Histogram, Percentiles) {
+	uf::Histogram histogram;
+	for (int i = 1; i <= 100; i++)
+		histogram.Record(std::chrono::microseconds(i));
+
+	auto snapshot = histogram.Snapshot();
+	EXPECT_EQ(snapshot.count, 100u);
+	EXPECT_EQ(snapshot.Max(), 100us);
+	EXPECT_EQ(snapshot.Mean(), std::chrono::nanoseconds(50500));
+	// Buckets are at most 12.5% wide
+	EXPECT_NEAR(double(snapshot.Percentile(0.5).count()), 50000.0, 50000.0 * 0.0625);
+	EXPECT_NEAR(double(snapshot.Percentile(0.99).count()), 99000.0, 99000.0 * 0.0625);
+}
+
+TEST(Histogram, SnapshotDifference) {
+	uf::Histogram histogram;
+	histogram.Record(10ms);
+	auto first = histogram.Snapshot();
+	histogram.Record(1ms);
+	histogram.Record(2ms);
+	auto interval = histogram.Snapshot() - first;
+
+	EXPECT_EQ(interval.count, 2u);
+	EXPECT_EQ(interval.Sum(), 3ms);
+	// Maximum of the whole histogram is 10 ms, but the interval has only short records
+	EXPECT_LT(interval.Max(), 3ms);
+}
+
+TEST(Profiler, ScopedTimerRecordsSection) {
+	auto &section = uf::Profiler::Get().Section("test/scoped");
+	section.histogram.Reset();
+	{
+		PROFILE_SCOPE("test/scoped");
+	}
+	{
+		PROFILE_SCOPE("test/scoped");
+	}
+	EXPECT_EQ(section.histogram.Snapshot().count, 2u);
+
+	uf::Profiler::Get().SetEnabled(false);
+	{
+		PROFILE_SCOPE("test/scoped");
+	}
+	uf::Profiler::Get().SetEnabled(true);
+	EXPECT_EQ(section.histogram.Snapshot().count, 2u);
+
+	auto report = uf::Profiler::Report(uf::Profiler::Get().Snapshot());
+	EXPECT_NE(report.find("  scoped"), std::string::npos);
+}
+
+namespace {
+
+std::string readFile(const std::string &path) {
+	std::ifstream file(path);
+	std::stringstream content;
+	content << file.rdbuf();
+	return content.str();
+}
+
+} // namespace
+
+TEST(Tracer, WritesSpansOfEveryThread) {
+	const std::string path = "Tracer_Tests.json";
+	uf::Tracer::Get().Start();
+	{
+		PROFILE_SCOPE("test/traced");
+	}
+	std::thread([] {
+		uf::Tracer::Get().SetThreadName("test-thread");
+		PROFILE_SCOPE("test/traced-in-thread");
+	}).join();
+	ASSERT_TRUE(uf::Tracer::Get().Stop(path));
+
+	auto trace = readFile(path);
+	std::remove(path.c_str());
+	EXPECT_EQ(trace.find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["), 0u);
+	EXPECT_NE(trace.find("\"name\":\"test/traced\",\"ph\":\"X\""), std::string::npos);
+	EXPECT_NE(trace.find("\"name\":\"test/traced-in-thread\",\"ph\":\"X\""), std::string::npos);
+	EXPECT_NE(trace.find("\"args\":{\"name\":\"test-thread\"}"), std::string::npos);
+}
+
+TEST(Tracer, RecordsNothingWhenStopped) {
+	const std::string path = "Tracer_Tests.json";
+	{
+		PROFILE_SCOPE("test/not-traced");
+	}
+	uf::Tracer::Get().Start();
+	ASSERT_TRUE(uf::Tracer::Get().Stop(path));
+
+	auto trace = readFile(path);
+	std::remove(path.c_str());
+	EXPECT_EQ(trace.find("test/not-traced"), std::string::npos);
+}
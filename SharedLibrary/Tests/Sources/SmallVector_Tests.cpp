@@ -0,0 +1,60 @@
+#include <Shared/SmallVector.hpp>
+
+#include <algorithm>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace {
+
+template<class T, size_t N>
+std::vector<T> toStd(const uf::SmallVector<T, N> &vector) {
+	return std::vector<T>(vector.begin(), vector.end());
+}
+
+} // namespace
+
+TEST(SmallVector, InsertAndEraseLikeVector) {
+	uf::SmallVector<int, 4> small;
+	std::vector<int> expected;
+	// Sorted insertion goes beyond inline capacity and back
+	for (int value : { 5, 1, 3, 7, 2, 9, 0 }) {
+		small.insert(std::upper_bound(small.begin(), small.end(), value), value);
+		expected.insert(std::upper_bound(expected.begin(), expected.end(), value), value);
+	}
+	EXPECT_EQ(toStd(small), expected);
+	EXPECT_GE(small.capacity(), 7u);
+
+	small.erase(small.begin());
+	small.erase(std::find(small.begin(), small.end(), 5));
+	small.erase(small.end() - 1);
+	EXPECT_EQ(toStd(small), std::vector<int>({ 1, 2, 3, 7 }));
+
+	small.push_back(small.front());
+	EXPECT_EQ(small.back(), 1);
+	EXPECT_EQ(small.size(), 5u);
+}
+
+TEST(SmallVector, CopyAndMove) {
+	uf::SmallVector<int, 2> inlined;
+	inlined.push_back(1);
+	uf::SmallVector<int, 2> spilled;
+	for (int i = 0; i < 5; i++)
+		spilled.push_back(i);
+
+	auto inlinedCopy = inlined;
+	auto spilledCopy = spilled;
+	EXPECT_EQ(toStd(inlinedCopy), std::vector<int>({ 1 }));
+	EXPECT_EQ(toStd(spilledCopy), std::vector<int>({ 0, 1, 2, 3, 4 }));
+
+	auto movedSpilled = std::move(spilled);
+	EXPECT_EQ(toStd(movedSpilled), std::vector<int>({ 0, 1, 2, 3, 4 }));
+	EXPECT_TRUE(spilled.empty());
+
+	movedSpilled = std::move(inlined);
+	EXPECT_EQ(toStd(movedSpilled), std::vector<int>({ 1 }));
+	EXPECT_EQ(movedSpilled.capacity(), 2u);
+
+	spilledCopy = inlinedCopy;
+	EXPECT_EQ(toStd(spilledCopy), std::vector<int>({ 1 }));
+}
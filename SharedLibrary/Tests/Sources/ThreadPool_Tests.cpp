@@ -0,0 +1,65 @@
+#include <Shared/ThreadPool.h>
+#include <Shared/Network/Protocol/ServerToClient/Diff.h>
+
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+TEST(ThreadPool, CallsEveryIndexOnce) {
+	for (uint threads : { 0u, 1u, 4u }) {
+		uf::ThreadPool pool(threads);
+		EXPECT_EQ(pool.GetThreadsCount(), threads);
+		for (size_t count : { 0, 1, 7, 1000 }) {
+			std::vector<std::atomic<int>> calls(count);
+			pool.ParallelFor(count, [&](size_t i) { calls[i]++; });
+			for (auto &call : calls)
+				EXPECT_EQ(call.load(), 1);
+		}
+	}
+}
+
+TEST(ThreadPool, RethrowsException) {
+	uf::ThreadPool pool(3);
+	std::atomic<size_t> finished{0};
+	EXPECT_THROW(pool.ParallelFor(100, [&](size_t i) {
+		if (i == 42)
+			throw std::runtime_error("test");
+		finished++;
+	}), std::runtime_error);
+	// The other calls are not cancelled
+	EXPECT_EQ(finished.load(), 99u);
+
+	// Pool works after exception
+	std::atomic<size_t> calls{0};
+	pool.ParallelFor(10, [&](size_t) { calls++; });
+	EXPECT_EQ(calls.load(), 10u);
+}
+
+TEST(ThreadPool, DiffsCreatedInParallelHaveUniqueIds) {
+	using namespace network::protocol;
+	const size_t TASKS = 64;
+	const size_t DIFFS_PER_TASK = 1000;
+
+	uf::ThreadPool pool(4);
+	Diff::ResetDiffCounter();
+	// Camera views create diffs like this
+	std::vector<std::vector<uint32_t>> ids(TASKS);
+	pool.ParallelFor(TASKS, [&](size_t task) {
+		for (size_t i = 0; i < DIFFS_PER_TASK; i++) {
+			auto diff = std::make_shared<AddDiff>();
+			ids[task].push_back(diff->GetDiffId());
+		}
+	});
+
+	std::vector<uint32_t> all;
+	for (auto &taskIds : ids)
+		all.insert(all.end(), taskIds.begin(), taskIds.end());
+	std::sort(all.begin(), all.end());
+	EXPECT_EQ(std::adjacent_find(all.begin(), all.end()), all.end());
+	EXPECT_EQ(Diff::GetDiffCounter(), TASKS * DIFFS_PER_TASK);
+	EXPECT_EQ(all.front(), 1u);
+	EXPECT_EQ(all.back(), TASKS * DIFFS_PER_TASK);
+}
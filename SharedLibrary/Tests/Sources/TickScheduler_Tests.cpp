@@ -0,0 +1,62 @@
+#include <Shared/TickScheduler.h>
+
+#include <thread>
+
+#include <gtest/gtest.h>
+
+using namespace std::chrono_literals;
+
+TEST(TickScheduler, KeepsTickRate) {
+	uf::TickScheduler scheduler(200);
+	EXPECT_EQ(scheduler.GetPeriod(), 5ms);
+
+	const auto start = uf::TickScheduler::Clock::now();
+	for (int i = 0; i <= 40; i++) {
+		scheduler.WaitForNextTick();
+		// Work of the tick shouldn't shift the schedule
+		std::this_thread::sleep_for(1ms);
+	}
+	const auto elapsed = uf::TickScheduler::Clock::now() - start;
+
+	// 40 periods after the first tick, and the last tick work
+	EXPECT_GE(elapsed, 200ms);
+	EXPECT_LT(elapsed, 260ms);
+
+	auto stats = scheduler.GetStats();
+	EXPECT_EQ(stats.ticks, 41u);
+	EXPECT_EQ(stats.droppedTicks, 0u);
+	EXPECT_EQ(stats.jitter.count + stats.lateTicks, 40u);
+}
+
+TEST(TickScheduler, CatchesUpAfterOverrun) {
+	uf::TickScheduler scheduler(100, uf::TickWaitMode::SLEEP, 5);
+	scheduler.WaitForNextTick();
+	// Overrun by about 3 periods
+	std::this_thread::sleep_for(35ms);
+
+	const auto start = uf::TickScheduler::Clock::now();
+	for (int i = 0; i < 3; i++)
+		scheduler.WaitForNextTick();
+	// Late ticks don't wait
+	EXPECT_LT(uf::TickScheduler::Clock::now() - start, 5ms);
+
+	auto stats = scheduler.GetStats();
+	EXPECT_EQ(stats.lateTicks, 3u);
+	EXPECT_EQ(stats.droppedTicks, 0u);
+}
+
+TEST(TickScheduler, DropsTicksWhenTooFarBehind) {
+	uf::TickScheduler scheduler(100, uf::TickWaitMode::SLEEP, 5);
+	scheduler.WaitForNextTick();
+	std::this_thread::sleep_for(105ms);
+
+	scheduler.WaitForNextTick();
+	auto stats = scheduler.GetStats();
+	EXPECT_GE(stats.droppedTicks, 9u);
+
+	// Schedule is restarted, the next tick waits for its deadline
+	const auto start = uf::TickScheduler::Clock::now();
+	scheduler.WaitForNextTick();
+	EXPECT_EQ(scheduler.GetStats().lateTicks, 1u);
+	EXPECT_LE(uf::TickScheduler::Clock::now() - start, 11ms);
+}
@@ -0,0 +1,101 @@
+#include <Shared/TimerWheel.h>
+
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace std::chrono_literals;
+
+TEST(TimerWheel, FiresEveryTimerAtItsStep) {
+	uf::TimerWheel wheel(1ms);
+	std::mt19937 random(42);
+	// Delays over all levels, also the overflow list
+	std::uniform_int_distribution<int64_t> delayDistribution(0, (int64_t(1) << 24) + (int64_t(1) << 20));
+
+	const size_t TIMERS = 2000;
+	std::vector<int64_t> delays(TIMERS);
+	std::vector<int64_t> fired(TIMERS, -1);
+	int64_t time = 0;
+	for (size_t i = 0; i < TIMERS; i++) {
+		delays[i] = i < 100 ? int64_t(i) : delayDistribution(random);
+		wheel.Add(std::chrono::milliseconds(delays[i]), [&, i] { fired[i] = time; });
+	}
+	EXPECT_EQ(wheel.GetPendingCount(), TIMERS);
+
+	// Uneven steps of the game loop
+	while (wheel.GetPendingCount()) {
+		const int64_t elapsed = 1 + time % 97;
+		time += elapsed;
+		wheel.Advance(std::chrono::milliseconds(elapsed));
+	}
+
+	for (size_t i = 0; i < TIMERS; i++) {
+		const int64_t expected = std::max<int64_t>(delays[i], 1);
+		// Fired by the first Advance which reached its expiry
+		EXPECT_GE(fired[i], expected) << i;
+		EXPECT_LT(fired[i], expected + 97) << i;
+	}
+}
+
+TEST(TimerWheel, Cancel) {
+	uf::TimerWheel wheel(1ms);
+	int calls = 0;
+	auto first = wheel.Add(10ms, [&] { calls++; });
+	auto second = wheel.Add(5000ms, [&] { calls += 10; });
+	EXPECT_TRUE(wheel.IsPending(first));
+	EXPECT_FALSE(wheel.IsPending({}));
+
+	EXPECT_TRUE(wheel.Cancel(second));
+	EXPECT_FALSE(wheel.Cancel(second));
+	EXPECT_FALSE(wheel.IsPending(second));
+
+	wheel.Advance(10ms);
+	EXPECT_EQ(calls, 1);
+	EXPECT_FALSE(wheel.IsPending(first));
+	EXPECT_FALSE(wheel.Cancel(first));
+
+	// Node is reused, old handles don't refer to the new timer
+	auto third = wheel.Add(1ms, [&] { calls += 100; });
+	EXPECT_FALSE(wheel.Cancel(first));
+	EXPECT_TRUE(wheel.IsPending(third));
+
+	wheel.Advance(10s);
+	EXPECT_EQ(calls, 101);
+	EXPECT_EQ(wheel.GetPendingCount(), 0u);
+}
+
+TEST(TimerWheel, CallbacksChangeTimers) {
+	uf::TimerWheel wheel(1ms);
+	std::vector<int> order;
+	uf::TimerWheel::Handle cancelled;
+	wheel.Add(1ms, [&] {
+		order.push_back(1);
+		wheel.Cancel(cancelled);
+		// Repeating timer
+		wheel.Add(0ms, [&] { order.push_back(3); });
+	});
+	cancelled = wheel.Add(2ms, [&] { order.push_back(2); });
+
+	wheel.Advance(1ms);
+	EXPECT_EQ(order, std::vector<int>({ 1 }));
+	wheel.Advance(1ms);
+	EXPECT_EQ(order, std::vector<int>({ 1, 3 }));
+}
+
+TEST(TimerWheel, ExceptionDoesntLoseTimers) {
+	uf::TimerWheel wheel(1ms);
+	int calls = 0;
+	for (int i = 0; i < 3; i++)
+		wheel.Add(5ms, [&] {
+			calls++;
+			if (calls == 1)
+				throw std::runtime_error("test");
+		});
+
+	EXPECT_THROW(wheel.Advance(5ms), std::runtime_error);
+	EXPECT_EQ(calls, 1);
+	wheel.Advance(0ms);
+	EXPECT_EQ(calls, 3);
+}